@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "console.h"
+#include "instrumentacao.h"
+#include "memoria.h"
 
 // ===========================================
 // Estrutura que representa uma sala da mansão
@@ -11,6 +14,9 @@ typedef struct Sala {
     struct Sala *direita;       // Caminho à direita
 } Sala;
 
+// Conta de memória das salas (memoria.h; MEMORIA=1 mostra o uso no fim)
+MEM_CONTA(memSalas, "salas");
+
 // ===========================================
 // Função: criarSala()
 // Objetivo: cria dinamicamente uma nova sala
@@ -18,7 +24,7 @@ typedef struct Sala {
 // Retorno: ponteiro para a nova sala
 // ===========================================
 Sala* criarSala(const char *nome) {
-    Sala *novaSala = (Sala*) malloc(sizeof(Sala));
+    Sala *novaSala = (Sala*) memAlocar(&memSalas, sizeof(Sala));
     if (novaSala == NULL) {
         printf("Erro ao alocar memória para a sala.\n");
         exit(1);
@@ -37,10 +43,11 @@ Sala* criarSala(const char *nome) {
 // Parâmetros: ponteiro para a sala atual
 // ===========================================
 void explorarSalas(Sala *salaAtual) {
-    char escolha;
+    int escolha;
 
     if (salaAtual == NULL)
         return;
+    INSTR_CONTAR("salas.visitadas");
 
     printf("\nVocê está agora em: %s\n", salaAtual->nome);
 
@@ -51,15 +58,16 @@ void explorarSalas(Sala *salaAtual) {
     }
 
     while (1) {
-        printf("\nEscolha um caminho:\n");
+        consoleInterface("\nEscolha um caminho:\n");
         if (salaAtual->esquerda != NULL)
-            printf("  [e] Ir para a esquerda (%s)\n", salaAtual->esquerda->nome);
+            consoleInterface("  [e] Ir para a esquerda (%s)\n", salaAtual->esquerda->nome);
         if (salaAtual->direita != NULL)
-            printf("  [d] Ir para a direita (%s)\n", salaAtual->direita->nome);
-        printf("  [s] Sair da exploração\n");
+            consoleInterface("  [d] Ir para a direita (%s)\n", salaAtual->direita->nome);
+        consoleInterface("  [s] Sair da exploração\n");
 
-        printf("Sua escolha: ");
-        scanf(" %c", &escolha);
+        consoleInterface("Sua escolha: ");
+        escolha = consoleLerCaractere();
+        if (escolha < 0) escolha = 's'; // fim da entrada: encerra a exploração
 
         if (escolha == 'e' && salaAtual->esquerda != NULL) {
             explorarSalas(salaAtual->esquerda);
@@ -76,12 +84,27 @@ void explorarSalas(Sala *salaAtual) {
     }
 }
 
+// ===========================================
+// Função: liberarSalas()
+// Objetivo: libera toda a mansão a partir da
+// sala dada (filhos antes do pai)
+// ===========================================
+void liberarSalas(Sala *sala) {
+    if (sala == NULL)
+        return;
+    liberarSalas(sala->esquerda);
+    liberarSalas(sala->direita);
+    memLiberar(sala);
+}
+
 // ===========================================
 // Função: main()
 // Objetivo: cria o mapa da mansão (árvore binária),
 // inicia o jogo e chama a função de exploração.
 // ===========================================
 int main() {
+    consoleIniciar();
+
     // Criação automática do mapa da mansão
     Sala *hall = criarSala("Hall de Entrada");
     Sala *salaEstar = criarSala("Sala de Estar");
@@ -109,13 +132,7 @@ int main() {
     explorarSalas(hall);
 
     // Liberação de memória
-    free(hall);
-    free(salaEstar);
-    free(biblioteca);
-    free(cozinha);
-    free(jardim);
-    free(escritorio);
-    free(porao);
+    liberarSalas(hall);
 
     printf("\nExploração encerrada. Obrigado por jogar!\n");
     return 0;
@@ -0,0 +1,323 @@
+/*
+  colunasnotas.h - Notas em colunas (SoA) e núcleos vetoriais (SSE2 / AVX2)
+  -------------------------------------------------------------------------
+  Em vez de um vetor de structs {nome, idade, matricula, n1, n2}, as notas da
+  turma ficam em colunas contíguas de float (n1[], n2[], media[]). Os laços
+  sobre as notas leem só os bytes que usam e cabem em registradores vetoriais
+  (4 notas por instrução com SSE2, 8 com AVX2).
+
+  Núcleos (cada um em três versões: escalar, SSE2 e AVX2):
+  - media:     media[i] = (n1[i] + n2[i]) / 2; retorna a soma das médias
+  - ponderada: media[i] = (p1*n1[i] + p2*n2[i]) / (p1 + p2); retorna a soma
+  - contar:    quantas notas são >= limite (aprovados)
+  As somas são acumuladas em double (milhões de notas em float perderiam
+  precisão); a ordem da soma muda entre as versões, então elas podem
+  diferir no último dígito.
+
+  - A versão é escolhida uma vez, em tempo de execução, pelo processador
+    (__builtin_cpu_supports): o mesmo binário roda em máquinas sem AVX2.
+  - A versão escalar é compilada sem vetorização automática, para servir de
+    referência honesta no benchmark (e de reserva fora do x86).
+  - As colunas vêm de memoria.h (conta "notas (colunas)").
+
+  Uso:
+      ColunasNotas c;
+      cnInicializar(&c);
+      cnAdicionar(&c, 7.5f, 8.0f);
+      const NucleosNotas *k = cnNucleos();          // melhor versão disponível
+      double soma = k->media(c.n1, c.n2, c.media, c.tamanho);
+      size_t aprovados = k->contar(c.media, c.tamanho, 6.0f);
+      cnLiberar(&c);
+
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef COLUNASNOTAS_H
+#define COLUNASNOTAS_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+#include "memoria.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CN_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define CN_SEM_VETORIZAR __attribute__((optimize("no-tree-vectorize")))
+#else
+#define CN_SEM_VETORIZAR
+#endif
+
+#define CN_CAPACIDADE_INICIAL 1024
+
+typedef struct {
+    float *n1, *n2, *media;
+    size_t tamanho, capacidade;
+} ColunasNotas;
+
+typedef struct {
+    const char *nome;
+    double (*media)(const float *n1, const float *n2, float *saida, size_t n);
+    double (*ponderada)(const float *n1, const float *n2, float *saida, size_t n,
+                        float p1, float p2);
+    size_t (*contar)(const float *notas, size_t n, float limite);
+} NucleosNotas;
+
+MEM_CONTA(memColunasNotas, "notas (colunas)");
+
+/* ---------- Colunas ---------- */
+
+static inline void cnInicializar(ColunasNotas *c) {
+    memset(c, 0, sizeof(*c));
+}
+
+/* Garante espaço para 'capacidade' alunos. Retorna 0 se faltou memória (as
+   colunas continuam como estavam). */
+static inline int cnReservar(ColunasNotas *c, size_t capacidade) {
+    float *colunas[3];
+    if (capacidade <= c->capacidade) return 1;
+    colunas[0] = (float *) memRealocar(&memColunasNotas, c->n1, capacidade * sizeof(float));
+    if (colunas[0]) c->n1 = colunas[0];
+    colunas[1] = (float *) memRealocar(&memColunasNotas, c->n2, capacidade * sizeof(float));
+    if (colunas[1]) c->n2 = colunas[1];
+    colunas[2] = (float *) memRealocar(&memColunasNotas, c->media, capacidade * sizeof(float));
+    if (colunas[2]) c->media = colunas[2];
+    if (!colunas[0] || !colunas[1] || !colunas[2]) return 0;
+    c->capacidade = capacidade;
+    return 1;
+}
+
+static inline int cnAdicionar(ColunasNotas *c, float n1, float n2) {
+    if (c->tamanho == c->capacidade &&
+        !cnReservar(c, c->capacidade ? c->capacidade * 2 : CN_CAPACIDADE_INICIAL))
+        return 0;
+    c->n1[c->tamanho] = n1;
+    c->n2[c->tamanho] = n2;
+    c->media[c->tamanho] = 0.0f;
+    c->tamanho++;
+    return 1;
+}
+
+static inline void cnLiberar(ColunasNotas *c) {
+    memLiberar(c->n1);
+    memLiberar(c->n2);
+    memLiberar(c->media);
+    cnInicializar(c);
+}
+
+/* ---------- Versão escalar ---------- */
+
+CN_SEM_VETORIZAR
+static double cnMediaEscalar(const float *n1, const float *n2, float *saida, size_t n) {
+    double soma = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        saida[i] = (n1[i] + n2[i]) * 0.5f;
+        soma += saida[i];
+    }
+    return soma;
+}
+
+CN_SEM_VETORIZAR
+static double cnPonderadaEscalar(const float *n1, const float *n2, float *saida, size_t n,
+                                 float p1, float p2) {
+    float w1 = p1 / (p1 + p2), w2 = p2 / (p1 + p2);
+    double soma = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        saida[i] = w1 * n1[i] + w2 * n2[i];
+        soma += saida[i];
+    }
+    return soma;
+}
+
+CN_SEM_VETORIZAR
+static size_t cnContarEscalar(const float *notas, size_t n, float limite) {
+    size_t total = 0;
+    for (size_t i = 0; i < n; i++) total += notas[i] >= limite;
+    return total;
+}
+
+static const NucleosNotas cnNucleosEscalar = {
+    "escalar", cnMediaEscalar, cnPonderadaEscalar, cnContarEscalar
+};
+
+#ifdef CN_X86
+
+/* ---------- SSE2 (4 notas por instrução) ---------- */
+
+/* Soma os 4 floats de v em dois acumuladores double */
+__attribute__((target("sse2")))
+static inline void cnSomarSse(__m128d *a, __m128d *b, __m128 v) {
+    *a = _mm_add_pd(*a, _mm_cvtps_pd(v));
+    *b = _mm_add_pd(*b, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+}
+
+__attribute__((target("sse2")))
+static inline double cnTotalSse(__m128d a, __m128d b) {
+    double partes[2];
+    _mm_storeu_pd(partes, _mm_add_pd(a, b));
+    return partes[0] + partes[1];
+}
+
+__attribute__((target("sse2")))
+static double cnPonderadaSse(const float *n1, const float *n2, float *saida, size_t n,
+                             float p1, float p2) {
+    float w1 = p1 / (p1 + p2), w2 = p2 / (p1 + p2);
+    __m128 v1 = _mm_set1_ps(w1), v2 = _mm_set1_ps(w2);
+    __m128d a = _mm_setzero_pd(), b = _mm_setzero_pd();
+    size_t i = 0;
+    double soma;
+    for (; i + 4 <= n; i += 4) {
+        __m128 m = _mm_add_ps(_mm_mul_ps(v1, _mm_loadu_ps(n1 + i)),
+                              _mm_mul_ps(v2, _mm_loadu_ps(n2 + i)));
+        _mm_storeu_ps(saida + i, m);
+        cnSomarSse(&a, &b, m);
+    }
+    soma = cnTotalSse(a, b);
+    for (; i < n; i++) {
+        saida[i] = w1 * n1[i] + w2 * n2[i];
+        soma += saida[i];
+    }
+    return soma;
+}
+
+__attribute__((target("sse2")))
+static double cnMediaSse(const float *n1, const float *n2, float *saida, size_t n) {
+    __m128 metade = _mm_set1_ps(0.5f);
+    __m128d a = _mm_setzero_pd(), b = _mm_setzero_pd();
+    size_t i = 0;
+    double soma;
+    for (; i + 4 <= n; i += 4) {
+        __m128 m = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(n1 + i), _mm_loadu_ps(n2 + i)), metade);
+        _mm_storeu_ps(saida + i, m);
+        cnSomarSse(&a, &b, m);
+    }
+    soma = cnTotalSse(a, b);
+    for (; i < n; i++) {
+        saida[i] = (n1[i] + n2[i]) * 0.5f;
+        soma += saida[i];
+    }
+    return soma;
+}
+
+__attribute__((target("sse2,popcnt")))
+static size_t cnContarSse(const float *notas, size_t n, float limite) {
+    __m128 l = _mm_set1_ps(limite);
+    size_t total = 0, i = 0;
+    for (; i + 4 <= n; i += 4)
+        total += (size_t) __builtin_popcount(_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(notas + i), l)));
+    for (; i < n; i++) total += notas[i] >= limite;
+    return total;
+}
+
+static const NucleosNotas cnNucleosSse = {
+    "sse2", cnMediaSse, cnPonderadaSse, cnContarSse
+};
+
+/* ---------- AVX2 (8 notas por instrução) ---------- */
+
+__attribute__((target("avx2")))
+static inline void cnSomarAvx(__m256d *a, __m256d *b, __m256 v) {
+    *a = _mm256_add_pd(*a, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+    *b = _mm256_add_pd(*b, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+}
+
+__attribute__((target("avx2")))
+static inline double cnTotalAvx(__m256d a, __m256d b) {
+    double partes[4];
+    _mm256_storeu_pd(partes, _mm256_add_pd(a, b));
+    return (partes[0] + partes[1]) + (partes[2] + partes[3]);
+}
+
+__attribute__((target("avx2")))
+static double cnPonderadaAvx2(const float *n1, const float *n2, float *saida, size_t n,
+                              float p1, float p2) {
+    float w1 = p1 / (p1 + p2), w2 = p2 / (p1 + p2);
+    __m256 v1 = _mm256_set1_ps(w1), v2 = _mm256_set1_ps(w2);
+    __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+    size_t i = 0;
+    double soma;
+    for (; i + 8 <= n; i += 8) {
+        __m256 m = _mm256_add_ps(_mm256_mul_ps(v1, _mm256_loadu_ps(n1 + i)),
+                                 _mm256_mul_ps(v2, _mm256_loadu_ps(n2 + i)));
+        _mm256_storeu_ps(saida + i, m);
+        cnSomarAvx(&a, &b, m);
+    }
+    soma = cnTotalAvx(a, b);
+    for (; i < n; i++) {
+        saida[i] = w1 * n1[i] + w2 * n2[i];
+        soma += saida[i];
+    }
+    return soma;
+}
+
+__attribute__((target("avx2")))
+static double cnMediaAvx2(const float *n1, const float *n2, float *saida, size_t n) {
+    __m256 metade = _mm256_set1_ps(0.5f);
+    __m256d a = _mm256_setzero_pd(), b = _mm256_setzero_pd();
+    size_t i = 0;
+    double soma;
+    for (; i + 8 <= n; i += 8) {
+        __m256 m = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(n1 + i), _mm256_loadu_ps(n2 + i)),
+                                 metade);
+        _mm256_storeu_ps(saida + i, m);
+        cnSomarAvx(&a, &b, m);
+    }
+    soma = cnTotalAvx(a, b);
+    for (; i < n; i++) {
+        saida[i] = (n1[i] + n2[i]) * 0.5f;
+        soma += saida[i];
+    }
+    return soma;
+}
+
+__attribute__((target("avx2,popcnt")))
+static size_t cnContarAvx2(const float *notas, size_t n, float limite) {
+    __m256 l = _mm256_set1_ps(limite);
+    size_t total = 0, i = 0;
+    for (; i + 8 <= n; i += 8)
+        total += (size_t) __builtin_popcount(
+            _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(notas + i), l, _CMP_GE_OQ)));
+    for (; i < n; i++) total += notas[i] >= limite;
+    return total;
+}
+
+static const NucleosNotas cnNucleosAvx2 = {
+    "avx2", cnMediaAvx2, cnPonderadaAvx2, cnContarAvx2
+};
+
+#endif /* CN_X86 */
+
+/* ---------- Escolha da versão ---------- */
+
+/* Versões que este processador executa, da mais simples para a mais larga.
+   Retorna quantas foram escritas em 'versoes' (no máximo 3). */
+static inline int cnNucleosDisponiveis(const NucleosNotas *versoes[3]) {
+    int n = 0;
+    versoes[n++] = &cnNucleosEscalar;
+#ifdef CN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2") && __builtin_cpu_supports("popcnt"))
+        versoes[n++] = &cnNucleosSse;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        versoes[n++] = &cnNucleosAvx2;
+#endif
+    return n;
+}
+
+/* Melhor versão disponível (decidida na primeira chamada). Pode ser chamada
+   de várias threads: todas decidem a mesma versão, e o ponteiro é atômico. */
+static inline const NucleosNotas *cnNucleos(void) {
+    static _Atomic(const NucleosNotas *) escolhida;
+    const NucleosNotas *k = atomic_load_explicit(&escolhida, memory_order_acquire);
+    if (!k) {
+        const NucleosNotas *versoes[3];
+        k = versoes[cnNucleosDisponiveis(versoes) - 1];
+        atomic_store_explicit(&escolhida, k, memory_order_release);
+    }
+    return k;
+}
+
+#endif /* COLUNASNOTAS_H */
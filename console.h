@@ -0,0 +1,155 @@
+/*
+  console.h - Entrada e saída de console com buffer grande, sem scanf
+  -------------------------------------------------------------------
+  Os programas de menu fazem uma pergunta por linha. Em vez de scanf/getchar
+  com limparBuffer() a cada opção e de printf com flush a cada linha:
+
+  - Saída: stdout ganha um buffer de 64 KB (totalmente bufferizado, mesmo num
+    terminal). Ele só é esvaziado quando o programa vai esperar pela entrada,
+    ou seja, uma vez por pergunta ou quadro, e no fim do programa.
+  - Entrada: leitor de linhas próprio sobre read() com buffer de 64 KB. Cada
+    resposta é uma linha: consoleLerInteiro(), consoleLerCaractere() e
+    consoleLerLinha() consomem a linha inteira, então não sobra nada para
+    limpar. No fim da entrada elas retornam -1 (e o menu pode encerrar em vez
+    de repetir a última opção para sempre).
+  - Modo silencioso: se a entrada não é um terminal (sessão redirecionada de
+    um arquivo ou pipe), menus e perguntas escritos com consoleInterface() não
+    aparecem; só os resultados. A variável de ambiente CONSOLE_INTERATIVO=1
+    (ou 0) força um modo ou outro.
+
+  Uso:
+      consoleIniciar();
+      consoleInterface("1 - Jogar\n0 - Sair\nEscolha: ");
+      if (consoleLerInteiro(&opcao) < 0) opcao = 0;   // fim da entrada: sair
+      consoleLerLinha(nome, sizeof(nome));             // sem o '\n'
+
+  Não misture com scanf/fgets/getchar em stdin: o buffer de entrada é próprio.
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CONSOLE_BUFFER_SAIDA (1 << 16)
+#define CONSOLE_BUFFER_ENTRADA (1 << 16)
+
+typedef struct {
+    char saida[CONSOLE_BUFFER_SAIDA];
+    char entrada[CONSOLE_BUFFER_ENTRADA];
+    size_t inicio, fim;   /* bytes de 'entrada' ainda não consumidos */
+    int fimEntrada;
+    int interativo;       /* menus e perguntas aparecem */
+    int iniciado;
+} Console;
+
+static Console console;
+
+static inline void consoleIniciar(void) {
+    const char *forcar = getenv("CONSOLE_INTERATIVO");
+    if (console.iniciado) return;
+    console.iniciado = 1;
+    console.interativo = forcar && *forcar ? *forcar != '0' : isatty(STDIN_FILENO);
+    setvbuf(stdout, console.saida, _IOFBF, sizeof(console.saida));
+}
+
+static inline int consoleInterativo(void) { return console.interativo; }
+
+/* Texto de interface (menus, perguntas): só aparece no modo interativo */
+static inline void consoleInterface(const char *formato, ...) {
+    va_list args;
+    if (!console.interativo) return;
+    va_start(args, formato);
+    vprintf(formato, args);
+    va_end(args);
+}
+
+/* Recarrega o buffer de entrada; retorna 0 no fim da entrada */
+static inline int consoleEncher(void) {
+    ssize_t n;
+    if (console.fimEntrada) return 0;
+    fflush(stdout); /* vai esperar: mostra a pergunta e tudo que está pendente */
+    do {
+        n = read(STDIN_FILENO, console.entrada, sizeof(console.entrada));
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+        console.fimEntrada = 1;
+        return 0;
+    }
+    console.inicio = 0;
+    console.fim = (size_t)n;
+    return 1;
+}
+
+/* Lê a próxima linha sem o '\n' (e sem '\r'). Linhas maiores que o destino
+   são cortadas e o resto é descartado. Retorna o tamanho ou -1 no fim. */
+static inline int consoleLerLinha(char *destino, size_t tamanho) {
+    size_t copiado = 0;
+    int leuAlgo = 0;
+    for (;;) {
+        const char *p, *quebra;
+        size_t disponivel, n;
+        if (console.inicio == console.fim && !consoleEncher()) {
+            if (!leuAlgo) {
+                if (tamanho > 0) destino[0] = '\0';
+                return -1;
+            }
+            break; /* última linha sem '\n' */
+        }
+        leuAlgo = 1;
+        p = console.entrada + console.inicio;
+        disponivel = console.fim - console.inicio;
+        quebra = (const char *)memchr(p, '\n', disponivel);
+        n = quebra ? (size_t)(quebra - p) : disponivel;
+        if (copiado + 1 < tamanho) {
+            size_t cabe = tamanho - 1 - copiado;
+            if (n < cabe) cabe = n;
+            memcpy(destino + copiado, p, cabe);
+            copiado += cabe;
+        }
+        console.inicio += n + (quebra != NULL);
+        if (quebra) break;
+    }
+    if (copiado > 0 && destino[copiado - 1] == '\r') copiado--;
+    if (tamanho > 0) destino[copiado] = '\0';
+    return (int)copiado;
+}
+
+/* Lê uma linha e converte o inteiro no começo dela (brancos antes são
+   ignorados). Retorna 1 se leu um número, 0 se a linha não começa com um
+   número (*x fica como estava) e -1 no fim da entrada. */
+static inline int consoleLerInteiro(int *x) {
+    char linha[64];
+    const char *p = linha;
+    long valor = 0;
+    int negativo = 0;
+    if (consoleLerLinha(linha, sizeof(linha)) < 0) return -1;
+    while (*p == ' ' || *p == '\t') p++;
+    if (*p == '-' || *p == '+') negativo = *p++ == '-';
+    if (*p < '0' || *p > '9') return 0;
+    while (*p >= '0' && *p <= '9') {
+        valor = valor * 10 + (*p++ - '0');
+        if (valor > INT_MAX) valor = INT_MAX; /* satura em vez de estourar */
+    }
+    *x = (int)(negativo ? -valor : valor);
+    return 1;
+}
+
+/* Primeiro caractere não branco da próxima linha (0 se a linha está em
+   branco); -1 no fim da entrada */
+static inline int consoleLerCaractere(void) {
+    char linha[64];
+    const char *p = linha;
+    if (consoleLerLinha(linha, sizeof(linha)) < 0) return -1;
+    while (*p == ' ' || *p == '\t') p++;
+    return (unsigned char)*p;
+}
+
+#endif /* CONSOLE_H */
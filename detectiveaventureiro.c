@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "console.h"
+#include "instrumentacao.h"
+#include "memoria.h"
 
 // =======================================================
 // Estrutura da sala da mansão (nós da árvore binária)
@@ -21,6 +24,10 @@ typedef struct PistaNode {
     struct PistaNode *direita;   // Subárvore à direita
 } PistaNode;
 
+// Contas de memória (memoria.h; MEMORIA=1 mostra o uso no fim)
+MEM_CONTA(memSalas, "salas");
+MEM_CONTA(memPistas, "pistas (BST)");
+
 // =======================================================
 // Função: criarSala()
 // Objetivo: cria dinamicamente um cômodo da mansão,
@@ -29,7 +36,7 @@ typedef struct PistaNode {
 // Retorno: ponteiro para a nova sala
 // =======================================================
 Sala* criarSala(const char *nome, const char *pista) {
-    Sala *novaSala = (Sala*) malloc(sizeof(Sala));
+    Sala *novaSala = (Sala*) memAlocar(&memSalas, sizeof(Sala));
     if (novaSala == NULL) {
         printf("Erro ao alocar memória para a sala.\n");
         exit(1);
@@ -49,7 +56,7 @@ Sala* criarSala(const char *nome, const char *pista) {
 // Objetivo: cria um novo nó da BST de pistas
 // =======================================================
 PistaNode* criarPistaNode(const char *conteudo) {
-    PistaNode *novo = (PistaNode*) malloc(sizeof(PistaNode));
+    PistaNode *novo = (PistaNode*) memAlocar(&memPistas, sizeof(PistaNode));
     if (novo == NULL) {
         printf("Erro ao alocar memória para pista.\n");
         exit(1);
@@ -66,6 +73,7 @@ PistaNode* criarPistaNode(const char *conteudo) {
 // ordem alfabética
 // =======================================================
 PistaNode* inserirPista(PistaNode *raiz, const char *conteudo) {
+    INSTR_CONTAR("bst.nosVisitados");
     if (raiz == NULL)
         return criarPistaNode(conteudo);
 
@@ -90,16 +98,42 @@ void exibirPistas(PistaNode *raiz) {
     exibirPistas(raiz->direita);
 }
 
+// =======================================================
+// Função: liberarPistas()
+// Objetivo: libera todos os nós da BST de pistas
+// (percurso pós-ordem: filhos antes do pai)
+// =======================================================
+void liberarPistas(PistaNode *raiz) {
+    if (raiz == NULL)
+        return;
+    liberarPistas(raiz->esquerda);
+    liberarPistas(raiz->direita);
+    memLiberar(raiz);
+}
+
+// =======================================================
+// Função: liberarSalas()
+// Objetivo: libera toda a mansão a partir da sala dada
+// =======================================================
+void liberarSalas(Sala *sala) {
+    if (sala == NULL)
+        return;
+    liberarSalas(sala->esquerda);
+    liberarSalas(sala->direita);
+    memLiberar(sala);
+}
+
 // =======================================================
 // Função: explorarSalasComPistas()
 // Objetivo: controla a exploração da mansão e a coleta
 // automática de pistas, armazenando-as na BST.
 // =======================================================
 void explorarSalasComPistas(Sala *salaAtual, PistaNode **raizPistas) {
-    char escolha;
+    int escolha;
 
     if (salaAtual == NULL)
         return;
+    INSTR_CONTAR("salas.visitadas");
 
     printf("\nVocê entrou em: %s\n", salaAtual->nome);
 
@@ -112,14 +146,15 @@ void explorarSalasComPistas(Sala *salaAtual, PistaNode **raizPistas) {
     }
 
     while (1) {
-        printf("\nEscolha seu próximo movimento:\n");
+        consoleInterface("\nEscolha seu próximo movimento:\n");
         if (salaAtual->esquerda != NULL)
-            printf("  [e] Ir para a esquerda (%s)\n", salaAtual->esquerda->nome);
+            consoleInterface("  [e] Ir para a esquerda (%s)\n", salaAtual->esquerda->nome);
         if (salaAtual->direita != NULL)
-            printf("  [d] Ir para a direita (%s)\n", salaAtual->direita->nome);
-        printf("  [s] Sair da exploração e exibir pistas\n");
-        printf("Sua escolha: ");
-        scanf(" %c", &escolha);
+            consoleInterface("  [d] Ir para a direita (%s)\n", salaAtual->direita->nome);
+        consoleInterface("  [s] Sair da exploração e exibir pistas\n");
+        consoleInterface("Sua escolha: ");
+        escolha = consoleLerCaractere();
+        if (escolha < 0) escolha = 's'; // fim da entrada: encerra a exploração
 
         if (escolha == 'e' && salaAtual->esquerda != NULL) {
             explorarSalasComPistas(salaAtual->esquerda, raizPistas);
@@ -142,6 +177,8 @@ void explorarSalasComPistas(Sala *salaAtual, PistaNode **raizPistas) {
 // exploração e exibe as pistas coletadas ao final.
 // =======================================================
 int main() {
+    consoleIniciar();
+
     // Criação do mapa (árvore binária da mansão)
     Sala *hall        = criarSala("Hall de Entrada", "Uma luva deixada no chão, tamanho médio.");
     Sala *salaEstar   = criarSala("Sala de Estar", "Um copo quebrado com resquícios de vinho.");
@@ -182,9 +219,9 @@ int main() {
 
     printf("\nObrigado por jogar Detective Quest!\n");
 
-    // Liberação de memória (simplificada)
-    free(hall); free(salaEstar); free(biblioteca);
-    free(cozinha); free(jardim); free(escritorio); free(porao);
+    // Liberação de memória: a mansão e a BST de pistas
+    liberarSalas(hall);
+    liberarPistas(raizPistas);
 
     return 0;
 }
\ No newline at end of file
@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include "console.h"
+#include "instrumentacao.h"
+#include "memoria.h"
 
 #define MAX_NOME 64
 #define MAX_PISTA 128
@@ -29,6 +32,11 @@ typedef struct HashEntry {
     struct HashEntry *proximo;
 } HashEntry;
 
+// Contas de memória (memoria.h; MEMORIA=1 mostra o uso no fim)
+MEM_CONTA(memSalas, "salas");
+MEM_CONTA(memPistas, "pistas (BST)");
+MEM_CONTA(memHash, "entradas da hash");
+
 // ----------------------------
 // Protótipos (principais funções)
 // ----------------------------
@@ -48,6 +56,9 @@ int existePistaBST(PistaNode *raiz, const char *conteudo);
 /* exibirPistas() – imprime a BST em ordem alfabética (in-order traversal). */
 void exibirPistasInOrder(PistaNode *raiz);
 
+/* liberarSalas() – libera a árvore de salas (filhos antes do pai). */
+void liberarSalas(Sala *sala);
+
 /* liberarPistasBST() – libera a memória da BST de pistas. */
 void liberarPistasBST(PistaNode *raiz);
 
@@ -73,7 +84,6 @@ void inicializarTabelaHash(HashEntry *tabela[]);
 unsigned long hash_djb2(const char *str);
 
 /* Funções utilitárias */
-static void trim_newline(char *s);
 static void trim_whitespace_inplace(char *s);
 static int str_case_equal(const char *a, const char *b);
 
@@ -81,7 +91,7 @@ static int str_case_equal(const char *a, const char *b);
 // Implementação
 // ----------------------------
 Sala* criarSala(const char *nome, const char *pista) {
-    Sala *s = (Sala*) malloc(sizeof(Sala));
+    Sala *s = (Sala*) memAlocar(&memSalas, sizeof(Sala));
     if (!s) {
         fprintf(stderr, "Erro de alocacao para Sala.\n");
         exit(EXIT_FAILURE);
@@ -99,7 +109,7 @@ Sala* criarSala(const char *nome, const char *pista) {
 PistaNode* inserirPistaBST(PistaNode *raiz, const char *conteudo) {
     if (!conteudo || conteudo[0] == '\0') return raiz;
     if (raiz == NULL) {
-        PistaNode *novo = (PistaNode*) malloc(sizeof(PistaNode));
+        PistaNode *novo = (PistaNode*) memAlocar(&memPistas, sizeof(PistaNode));
         if (!novo) { fprintf(stderr, "Erro de alocacao para PistaNode.\n"); exit(EXIT_FAILURE); }
         strncpy(novo->conteudo, conteudo, MAX_PISTA-1); novo->conteudo[MAX_PISTA-1] = '\0';
         novo->esquerda = novo->direita = NULL;
@@ -115,6 +125,7 @@ PistaNode* inserirPistaBST(PistaNode *raiz, const char *conteudo) {
 }
 
 PistaNode* inserirPista(PistaNode *raiz, const char *conteudo) {
+    INSTR_CRONOMETRAR("inserirPista");
     if (!existePistaBST(raiz, conteudo))
         return inserirPistaBST(raiz, conteudo);
     return raiz;
@@ -139,7 +150,14 @@ void liberarPistasBST(PistaNode *raiz) {
     if (!raiz) return;
     liberarPistasBST(raiz->esquerda);
     liberarPistasBST(raiz->direita);
-    free(raiz);
+    memLiberar(raiz);
+}
+
+void liberarSalas(Sala *sala) {
+    if (!sala) return;
+    liberarSalas(sala->esquerda);
+    liberarSalas(sala->direita);
+    memLiberar(sala);
 }
 
 unsigned long hash_djb2(const char *str) {
@@ -151,10 +169,12 @@ unsigned long hash_djb2(const char *str) {
 }
 
 void inserirNaHash(HashEntry *tabela[], const char *pista, const char *suspeito) {
+    INSTR_CRONOMETRAR("inserirNaHash");
     if (!pista || !suspeito) return;
     unsigned long h = hash_djb2(pista) % HASH_SIZE;
     HashEntry *cur = tabela[h];
     while (cur) {
+        INSTR_CONTAR("hash.comparacoes");
         if (strcmp(cur->pista, pista) == 0) {
             /* atualiza suspeito se já existe a pista */
             strncpy(cur->suspeito, suspeito, MAX_NOME-1);
@@ -163,19 +183,22 @@ void inserirNaHash(HashEntry *tabela[], const char *pista, const char *suspeito)
         }
         cur = cur->proximo;
     }
-    HashEntry *novo = (HashEntry*) malloc(sizeof(HashEntry));
+    HashEntry *novo = (HashEntry*) memAlocar(&memHash, sizeof(HashEntry));
     if (!novo) { fprintf(stderr, "Erro de alocacao para HashEntry.\n"); exit(EXIT_FAILURE); }
     strncpy(novo->pista, pista, MAX_PISTA-1); novo->pista[MAX_PISTA-1] = '\0';
     strncpy(novo->suspeito, suspeito, MAX_NOME-1); novo->suspeito[MAX_NOME-1] = '\0';
     novo->proximo = tabela[h];
     tabela[h] = novo;
+    INSTR_CONTAR("hash.entradas");
 }
 
 const char* encontrarSuspeito(HashEntry *tabela[], const char *pista) {
+    INSTR_CRONOMETRAR("encontrarSuspeito");
     if (!pista) return NULL;
     unsigned long h = hash_djb2(pista) % HASH_SIZE;
     HashEntry *cur = tabela[h];
     while (cur) {
+        INSTR_CONTAR("hash.comparacoes");
         if (strcmp(cur->pista, pista) == 0)
             return cur->suspeito;
         cur = cur->proximo;
@@ -188,7 +211,7 @@ void liberarTabelaHash(HashEntry *tabela[]) {
         HashEntry *cur = tabela[i];
         while (cur) {
             HashEntry *next = cur->proximo;
-            free(cur);
+            memLiberar(cur);
             cur = next;
         }
         tabela[i] = NULL;
@@ -203,8 +226,9 @@ void inicializarTabelaHash(HashEntry *tabela[]) {
    e insere na BST (sem duplicatas). */
 void explorarSalas(Sala *salaAtual, PistaNode **raizPistas, HashEntry *tabela[]) {
     if (!salaAtual) return;
+    INSTR_CONTAR("salas.visitadas");
 
-    char escolha = '\0';
+    int escolha;
     printf("\n--- Sala atual: %s ---\n", salaAtual->nome);
 
     if (salaAtual->pista[0] != '\0') {
@@ -222,17 +246,14 @@ void explorarSalas(Sala *salaAtual, PistaNode **raizPistas, HashEntry *tabela[])
     }
 
     while (1) {
-        printf("\nOpcoes:\n");
-        if (salaAtual->esquerda) printf("  [e] Ir para a esquerda -> %s\n", salaAtual->esquerda->nome);
-        if (salaAtual->direita)  printf("  [d] Ir para a direita -> %s\n", salaAtual->direita->nome);
-        printf("  [s] Sair da exploracao e ir ao julgamento\n");
-        printf("Sua escolha: ");
-
-        if (scanf(" %c", &escolha) != 1) {
-            int ch; while ((ch = getchar()) != '\n' && ch != EOF) {} /* limpar */
-            printf("Entrada invalida. Tente novamente.\n");
-            continue;
-        }
+        consoleInterface("\nOpcoes:\n");
+        if (salaAtual->esquerda) consoleInterface("  [e] Ir para a esquerda -> %s\n", salaAtual->esquerda->nome);
+        if (salaAtual->direita)  consoleInterface("  [d] Ir para a direita -> %s\n", salaAtual->direita->nome);
+        consoleInterface("  [s] Sair da exploracao e ir ao julgamento\n");
+        consoleInterface("Sua escolha: ");
+
+        escolha = consoleLerCaractere();
+        if (escolha < 0) escolha = 's'; /* fim da entrada: vai ao julgamento */
 
         if (escolha == 'e' && salaAtual->esquerda) {
             explorarSalas(salaAtual->esquerda, raizPistas, tabela);
@@ -242,8 +263,6 @@ void explorarSalas(Sala *salaAtual, PistaNode **raizPistas, HashEntry *tabela[])
             break;
         } else if (escolha == 's') {
             printf("Encerrando a exploracao e seguindo para o julgamento...\n");
-            /* consumir resto da linha, para garantir fgets posterior funcione */
-            int ch; while ((ch = getchar()) != '\n' && ch != EOF) {}
             break;
         } else {
             printf("Opcao invalida ou caminho inexistente. Tente novamente.\n");
@@ -281,14 +300,8 @@ void verificarSuspeitoFinal(PistaNode *raizPistas, HashEntry *tabela[]) {
         exibirPistasInOrder(raizPistas);
     }
 
-    printf("\nDigite o nome do suspeito que deseja acusar (ex: 'Sr. Almeida'): ");
-    /* limpar buffer antes de fgets (caso haja sobras) */
-    int ch;
-    while ((ch = getchar()) != '\n' && ch != EOF) {}
-    if (!fgets(acusado, sizeof(acusado), stdin)) {
-        acusado[0] = '\0';
-    }
-    trim_newline(acusado);
+    consoleInterface("\nDigite o nome do suspeito que deseja acusar (ex: 'Sr. Almeida'): ");
+    consoleLerLinha(acusado, sizeof(acusado)); /* no fim da entrada fica vazio */
     trim_whitespace_inplace(acusado);
 
     if (strlen(acusado) == 0) {
@@ -314,10 +327,6 @@ void verificarSuspeitoFinal(PistaNode *raizPistas, HashEntry *tabela[]) {
 /* ----------------------------
    Funcoes utilitarias
    ---------------------------- */
-static void trim_newline(char *s) {
-    size_t len = strlen(s);
-    if (len > 0 && s[len-1] == '\n') s[len-1] = '\0';
-}
 static void trim_whitespace_inplace(char *s) {
     /* remove espacos inicias e finais, in-place */
     char *start = s;
@@ -341,6 +350,8 @@ static int str_case_equal(const char *a, const char *b) {
 // main: monta mapa, inicializa hash, explora e julga
 // ----------------------------
 int main(void) {
+    consoleIniciar();
+
     /* Criacao do mapa (arvore binaria da mansao) */
     Sala *hall       = criarSala("Hall de Entrada", "Luva de couro deixada no chao");
     Sala *salaEstar  = criarSala("Sala de Estar", "Copo quebrado com residuos de vinho");
@@ -396,9 +407,8 @@ int main(void) {
     liberarPistasBST(raizPistas);
     liberarTabelaHash(tabela);
 
-    /* liberar salas (sao ponteiros alocados estaticamente aqui) */
-    free(hall); free(salaEstar); free(biblioteca); free(cozinha);
-    free(jardim); free(escritorio); free(varanda); free(porao);
+    /* liberar salas (toda a arvore a partir do hall) */
+    liberarSalas(hall);
 
     printf("\nInvestigacao finalizada. Obrigado por jogar!\n");
     return 0;
@@ -0,0 +1,207 @@
+/*
+  filaanel.h - Fila circular (anel) genérica com capacidade potência de 2
+  ----------------------------------------------------------------------
+  "Template" em macro: FILA_ANEL_DECLARAR gera o struct e as funções para
+  um tipo de elemento. Em relação à fila circular clássica (inicio, fim, qtd
+  e % TAMANHO a cada operação):
+
+  - A capacidade real é a menor potência de 2 >= capacidade pedida, então
+    o índice é (contador & máscara) em vez de um resto de divisão.
+  - cabeca e cauda só aumentam (uint32_t, com estouro natural); a quantidade
+    é cauda - cabeca, sem um campo qtd para manter em dia.
+  - Operações em lote (enfileirar/desenfileirar/espiar/trocar vários)
+    copiam no máximo dois trechos contíguos com memcpy (lotes pequenos,
+    elemento a elemento).
+
+  Uso:
+      FILA_ANEL_DECLARAR(Fila, Peca, TAMANHO_FILA, anel)
+      Fila f;
+      anelInicializar(&f);
+      anelEnfileirar(&f, &peca);            // 0 se a fila está cheia
+      anelDesenfileirar(&f, &peca);         // 0 se a fila está vazia
+      Peca *frente = anelEspiar(&f, 0);     // i-ésimo a partir da frente
+      anelEnfileirarLote(&f, pecas, n);     // quantos couberam
+      anelTrocarIntervalo(&f, 0, outro, k); // troca os k da frente com outro[0..k)
+
+  A capacidade é fixada em tempo de compilação: <prefixo>Capacidade(&f).
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef FILAANEL_H
+#define FILAANEL_H
+
+#include <stdint.h>
+#include <string.h>
+
+/* Menor potência de 2 >= n (até 2^32; expressão constante, serve para tamanho de vetor) */
+#define FA_OU1(x) ((x) | ((x) >> 1))
+#define FA_OU2(x) (FA_OU1(x) | (FA_OU1(x) >> 2))
+#define FA_OU4(x) (FA_OU2(x) | (FA_OU2(x) >> 4))
+#define FA_OU8(x) (FA_OU4(x) | (FA_OU4(x) >> 8))
+#define FA_OU16(x) (FA_OU8(x) | (FA_OU8(x) >> 16))
+#define FA_OU32(x) (FA_OU16(x) | (FA_OU16(x) >> 32))
+#define FA_POTENCIA2(n) (FA_OU32((uint64_t)(n) - 1) + 1)
+
+/* Até quantos elementos a cópia em lote é feita elemento a elemento */
+#define FA_LOTE_PEQUENO 8
+
+/* Troca o conteúdo de dois trechos de memória que não se sobrepõem. Blocos de
+   tamanho fixo (32 e 8 bytes) viram cargas e gravações em registradores, sem
+   chamar memcpy nem percorrer elemento por elemento. */
+static inline void faTrocarMemoria(void *a, void *b, size_t bytes) {
+    unsigned char *pa = (unsigned char *)a, *pb = (unsigned char *)b;
+    for (; bytes >= 32; bytes -= 32, pa += 32, pb += 32) {
+        unsigned char tmp[32];
+        memcpy(tmp, pa, 32);
+        memcpy(pa, pb, 32);
+        memcpy(pb, tmp, 32);
+    }
+    for (; bytes >= 8; bytes -= 8, pa += 8, pb += 8) {
+        uint64_t x, y;
+        memcpy(&x, pa, 8);
+        memcpy(&y, pb, 8);
+        memcpy(pa, &y, 8);
+        memcpy(pb, &x, 8);
+    }
+    for (; bytes > 0; bytes--, pa++, pb++) {
+        unsigned char t = *pa;
+        *pa = *pb;
+        *pb = t;
+    }
+}
+
+#define FILA_ANEL_DECLARAR(Nome, Tipo, CapacidadeMinima, prefixo)                         \
+    typedef struct {                                                                       \
+        Tipo itens[FA_POTENCIA2(CapacidadeMinima)];                                        \
+        uint32_t cabeca; /* total já retirado */                                           \
+        uint32_t cauda;  /* total já inserido */                                           \
+    } Nome;                                                                                \
+                                                                                           \
+    enum { prefixo##Mascara = FA_POTENCIA2(CapacidadeMinima) - 1 };                        \
+    _Static_assert((FA_POTENCIA2(CapacidadeMinima) & (FA_POTENCIA2(CapacidadeMinima) - 1)) == 0, \
+                   "capacidade da fila precisa ser potência de 2");                        \
+                                                                                           \
+    static inline void prefixo##Inicializar(Nome *f) { f->cabeca = f->cauda = 0; }         \
+    static inline uint32_t prefixo##Capacidade(const Nome *f) {                            \
+        (void)f;                                                                           \
+        return (uint32_t)prefixo##Mascara + 1;                                             \
+    }                                                                                      \
+    static inline uint32_t prefixo##Quantidade(const Nome *f) { return f->cauda - f->cabeca; } \
+    static inline int prefixo##Vazia(const Nome *f) { return f->cauda == f->cabeca; }      \
+    static inline int prefixo##Cheia(const Nome *f) {                                      \
+        return f->cauda - f->cabeca == (uint32_t)prefixo##Mascara + 1;                     \
+    }                                                                                      \
+                                                                                           \
+    static inline int prefixo##Enfileirar(Nome *f, const Tipo *x) {                        \
+        if (prefixo##Cheia(f)) return 0;                                                   \
+        f->itens[f->cauda++ & prefixo##Mascara] = *x;                                      \
+        return 1;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    static inline int prefixo##Desenfileirar(Nome *f, Tipo *x) {                           \
+        if (prefixo##Vazia(f)) return 0;                                                   \
+        *x = f->itens[f->cabeca++ & prefixo##Mascara];                                     \
+        return 1;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    /* Devolve x à frente da fila (desfaz um Desenfileirar). 0 se está cheia. */           \
+    static inline int prefixo##DevolverFrente(Nome *f, const Tipo *x) {                    \
+        if (prefixo##Cheia(f)) return 0;                                                   \
+        f->itens[--f->cabeca & prefixo##Mascara] = *x;                                     \
+        return 1;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    /* Descarta os n últimos inseridos (desfaz Enfileirar/EnfileirarLote) */               \
+    static inline void prefixo##DescartarFim(Nome *f, uint32_t n) {                        \
+        uint32_t qtd = prefixo##Quantidade(f);                                             \
+        f->cauda -= n < qtd ? n : qtd;                                                     \
+    }                                                                                      \
+                                                                                           \
+    /* i-ésimo elemento a partir da frente (NULL se não existe) */                         \
+    static inline Tipo *prefixo##Espiar(Nome *f, uint32_t i) {                             \
+        if (i >= prefixo##Quantidade(f)) return NULL;                                      \
+        return &f->itens[(f->cabeca + i) & prefixo##Mascara];                              \
+    }                                                                                      \
+                                                                                           \
+    /* Copia n elementos de/para o anel a partir do contador pos. Lotes pequenos      \
+       vão elemento a elemento (o laço com máscara é mais barato que chamar memcpy);   \
+       os grandes em no máximo dois trechos contíguos. */                               \
+    static inline void prefixo##CopiarDe(const Nome *f, uint32_t pos, Tipo *destino,       \
+                                         uint32_t n) {                                     \
+        if (n <= FA_LOTE_PEQUENO) {                                                        \
+            for (uint32_t i = 0; i < n; i++) destino[i] = f->itens[(pos + i) & prefixo##Mascara]; \
+            return;                                                                        \
+        }                                                                                  \
+        uint32_t ini = pos & prefixo##Mascara;                                             \
+        uint32_t ate = (uint32_t)prefixo##Mascara + 1 - ini;                               \
+        uint32_t k = n < ate ? n : ate;                                                    \
+        memcpy(destino, &f->itens[ini], k * sizeof(Tipo));                                 \
+        memcpy(destino + k, &f->itens[0], (n - k) * sizeof(Tipo));                         \
+    }                                                                                      \
+    static inline void prefixo##CopiarPara(Nome *f, uint32_t pos, const Tipo *origem,      \
+                                           uint32_t n) {                                   \
+        if (n <= FA_LOTE_PEQUENO) {                                                        \
+            for (uint32_t i = 0; i < n; i++) f->itens[(pos + i) & prefixo##Mascara] = origem[i]; \
+            return;                                                                        \
+        }                                                                                  \
+        uint32_t ini = pos & prefixo##Mascara;                                             \
+        uint32_t ate = (uint32_t)prefixo##Mascara + 1 - ini;                               \
+        uint32_t k = n < ate ? n : ate;                                                    \
+        memcpy(&f->itens[ini], origem, k * sizeof(Tipo));                                  \
+        memcpy(&f->itens[0], origem + k, (n - k) * sizeof(Tipo));                          \
+    }                                                                                      \
+                                                                                           \
+    /* Insere até n elementos; retorna quantos couberam */                                 \
+    static inline uint32_t prefixo##EnfileirarLote(Nome *f, const Tipo *origem, uint32_t n) { \
+        uint32_t livres = (uint32_t)prefixo##Mascara + 1 - prefixo##Quantidade(f);        \
+        if (n > livres) n = livres;                                                        \
+        prefixo##CopiarPara(f, f->cauda, origem, n);                                       \
+        f->cauda += n;                                                                     \
+        return n;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    /* Retira até n elementos da frente; retorna quantos foram retirados */                \
+    static inline uint32_t prefixo##DesenfileirarLote(Nome *f, Tipo *destino, uint32_t n) { \
+        uint32_t qtd = prefixo##Quantidade(f);                                             \
+        if (n > qtd) n = qtd;                                                              \
+        prefixo##CopiarDe(f, f->cabeca, destino, n);                                       \
+        f->cabeca += n;                                                                    \
+        return n;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    /* Copia n elementos a partir do i-ésimo sem retirá-los; retorna quantos */            \
+    static inline uint32_t prefixo##EspiarIntervalo(const Nome *f, uint32_t i, Tipo *destino, \
+                                                   uint32_t n) {                           \
+        uint32_t qtd = prefixo##Quantidade(f);                                             \
+        if (i >= qtd) return 0;                                                            \
+        if (n > qtd - i) n = qtd - i;                                                      \
+        prefixo##CopiarDe(f, f->cabeca + i, destino, n);                                   \
+        return n;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    /* Troca n elementos a partir do i-ésimo com outro[0..n) (mesma ordem), em no     \
+       máximo dois trechos contíguos do anel; retorna quantos foram trocados */         \
+    static inline uint32_t prefixo##TrocarIntervalo(Nome *f, uint32_t i, Tipo *outro,      \
+                                                    uint32_t n) {                          \
+        uint32_t qtd = prefixo##Quantidade(f);                                             \
+        if (i >= qtd) return 0;                                                            \
+        if (n > qtd - i) n = qtd - i;                                                      \
+        uint32_t pos = f->cabeca + i;                                                      \
+        if (n <= FA_LOTE_PEQUENO) {                                                        \
+            for (uint32_t j = 0; j < n; j++) {                                             \
+                Tipo *x = &f->itens[(pos + j) & prefixo##Mascara];                         \
+                Tipo tmp = *x;                                                             \
+                *x = outro[j];                                                             \
+                outro[j] = tmp;                                                            \
+            }                                                                              \
+            return n;                                                                      \
+        }                                                                                  \
+        uint32_t ini = pos & prefixo##Mascara;                                             \
+        uint32_t ate = (uint32_t)prefixo##Mascara + 1 - ini;                               \
+        uint32_t k = n < ate ? n : ate;                                                    \
+        faTrocarMemoria(&f->itens[ini], outro, k * sizeof(Tipo));                          \
+        faTrocarMemoria(&f->itens[0], outro + k, (n - k) * sizeof(Tipo));                  \
+        return n;                                                                          \
+    }
+
+#endif /* FILAANEL_H */
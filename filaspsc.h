@@ -0,0 +1,94 @@
+/*
+  filaspsc.h - Fila sem travas para um produtor e um consumidor (SPSC)
+  --------------------------------------------------------------------
+  Mesmo anel de filaanel.h (capacidade potência de 2, contadores que só
+  crescem), mas com uma thread produtora e uma consumidora:
+
+  - Só o produtor escreve 'cauda' e só o consumidor escreve 'cabeca'; cada
+    lado publica seu contador com release e lê o do outro com acquire, o que
+    garante que o elemento gravado no anel é visto antes do novo contador.
+  - Os dois contadores ficam em linhas de cache diferentes (64 bytes), para
+    que produtor e consumidor não disputem a mesma linha a cada operação.
+  - Cada lado guarda uma cópia do contador do outro e só relê o atômico
+    quando a cópia indica fila cheia (produtor) ou vazia (consumidor).
+
+  Uso:
+      FILA_SPSC_DECLARAR(FilaGerada, Peca, 1024, spsc)
+      FilaGerada *f = aligned_alloc(64, sizeof(FilaGerada));
+      spscInicializar(f);
+      // thread produtora:  while (!spscProduzir(f, &peca)) esperar...
+      // thread consumidora: if (spscConsumir(f, &peca)) ...
+
+  O struct exige alinhamento de 64 bytes (aligned_alloc ou variável estática).
+  Compilar com -pthread. Funções static inline: basta incluir o arquivo.
+*/
+
+#ifndef FILASPSC_H
+#define FILASPSC_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include "filaanel.h" /* FA_POTENCIA2 */
+
+#define FS_LINHA_CACHE 64
+
+/* Pausa curta dentro de laços de espera ativa */
+static inline void fsPausa(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+#define FILA_SPSC_DECLARAR(Nome, Tipo, CapacidadeMinima, prefixo)                          \
+    typedef struct {                                                                       \
+        _Alignas(FS_LINHA_CACHE) _Atomic uint32_t cauda; /* escrito só pelo produtor */    \
+        uint32_t cabecaVista;                            /* cópia do produtor */           \
+        _Alignas(FS_LINHA_CACHE) _Atomic uint32_t cabeca; /* escrito só pelo consumidor */ \
+        uint32_t caudaVista;                              /* cópia do consumidor */        \
+        _Alignas(FS_LINHA_CACHE) Tipo itens[FA_POTENCIA2(CapacidadeMinima)];               \
+    } Nome;                                                                                \
+                                                                                           \
+    enum { prefixo##Mascara = FA_POTENCIA2(CapacidadeMinima) - 1 };                        \
+    _Static_assert((FA_POTENCIA2(CapacidadeMinima) & (FA_POTENCIA2(CapacidadeMinima) - 1)) == 0, \
+                   "capacidade da fila precisa ser potência de 2");                        \
+                                                                                           \
+    static inline void prefixo##Inicializar(Nome *f) {                                     \
+        atomic_init(&f->cauda, 0);                                                         \
+        atomic_init(&f->cabeca, 0);                                                        \
+        f->cabecaVista = 0;                                                                \
+        f->caudaVista = 0;                                                                 \
+    }                                                                                      \
+                                                                                           \
+    /* Produtor: grava x no fim. Retorna 0 se a fila está cheia. */                       \
+    static inline int prefixo##Produzir(Nome *f, const Tipo *x) {                          \
+        uint32_t cauda = atomic_load_explicit(&f->cauda, memory_order_relaxed);            \
+        if (cauda - f->cabecaVista > (uint32_t)prefixo##Mascara) {                         \
+            f->cabecaVista = atomic_load_explicit(&f->cabeca, memory_order_acquire);       \
+            if (cauda - f->cabecaVista > (uint32_t)prefixo##Mascara) return 0;             \
+        }                                                                                  \
+        f->itens[cauda & prefixo##Mascara] = *x;                                           \
+        atomic_store_explicit(&f->cauda, cauda + 1, memory_order_release);                 \
+        return 1;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    /* Consumidor: retira da frente para *x. Retorna 0 se a fila está vazia. */           \
+    static inline int prefixo##Consumir(Nome *f, Tipo *x) {                                \
+        uint32_t cabeca = atomic_load_explicit(&f->cabeca, memory_order_relaxed);          \
+        if (cabeca == f->caudaVista) {                                                     \
+            f->caudaVista = atomic_load_explicit(&f->cauda, memory_order_acquire);         \
+            if (cabeca == f->caudaVista) return 0;                                         \
+        }                                                                                  \
+        *x = f->itens[cabeca & prefixo##Mascara];                                          \
+        atomic_store_explicit(&f->cabeca, cabeca + 1, memory_order_release);               \
+        return 1;                                                                          \
+    }                                                                                      \
+                                                                                           \
+    /* Quantidade no instante da leitura (aproximada se a outra thread está ativa) */     \
+    static inline uint32_t prefixo##Quantidade(Nome *f) {                                  \
+        uint32_t cabeca = atomic_load_explicit(&f->cabeca, memory_order_acquire);          \
+        return atomic_load_explicit(&f->cauda, memory_order_acquire) - cabeca;             \
+    }
+
+#endif /* FILASPSC_H */
@@ -0,0 +1,170 @@
+/*
+  indiceeytzinger.h - Índice de busca por nome em layout de Eytzinger
+  --------------------------------------------------------------------
+  Alternativa à busca binária clássica sobre o vetor de structs ordenado por nome.
+  A busca binária "de livro" toca uma linha de cache nova (um struct inteiro) a cada
+  sonda e depende de um desvio difícil de prever. Este índice:
+
+  - Guarda apenas um prefixo de 8 bytes de cada nome (big-endian em um uint64_t,
+    então a ordem numérica é a mesma do strcmp).
+  - Organiza os prefixos em ordem de Eytzinger (BFS da árvore binária implícita:
+    filhos de k em 2k e 2k+1), de modo que os próximos níveis da busca ficam nas
+    mesmas linhas de cache e podem ser buscados antecipadamente (prefetch).
+  - Faz a descida sem desvios dependentes de dados (k = 2k + (chave < x)).
+  - Só recorre ao strcmp completo quando o prefixo empata.
+
+  Bytes iniciais comuns a todos os nomes (ex.: "item0000...") são descartados antes
+  de extrair o prefixo, para que os 8 bytes guardados sejam os que distinguem os nomes.
+
+  O índice é montado a partir de qualquer vetor de structs já ordenado por nome:
+      ieConstruir(&idx, itens, total, sizeof(Item), offsetof(Item, nome));
+      long pos = ieBuscar(&idx, "bandagem", &comparacoes);  // posição no vetor ou -1
+  e precisa ser reconstruído sempre que o vetor mudar.
+*/
+
+#ifndef INDICEEYTZINGER_H
+#define INDICEEYTZINGER_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t *chaves;      /* prefixos em ordem de Eytzinger, posições 1..n */
+    uint32_t *posicoes;    /* posição no vetor ordenado de cada nó */
+    size_t n;
+    const char *base;      /* vetor de structs original (ordenado por nome) */
+    size_t passo;          /* sizeof do struct */
+    size_t deslocNome;     /* offsetof do campo nome */
+    size_t comum;          /* bytes iniciais compartilhados por todos os nomes */
+} IndiceEytzinger;
+
+static inline const char *ieNome(const IndiceEytzinger *ie, size_t i) {
+    return ie->base + i * ie->passo + ie->deslocNome;
+}
+
+/* Lê até 8 bytes de s (parando no '\0') como inteiro big-endian. */
+static inline uint64_t iePrefixo(const char *s) {
+    uint64_t p = 0;
+    int i;
+    for (i = 0; i < 8; i++) {
+        unsigned char c = (unsigned char)s[i];
+        p = (p << 8) | c;
+        if (c == '\0') {
+            p <<= 8 * (7 - i);
+            break;
+        }
+    }
+    return p;
+}
+
+static inline void ieInicializar(IndiceEytzinger *ie) {
+    memset(ie, 0, sizeof(*ie));
+}
+
+static inline void ieLiberar(IndiceEytzinger *ie) {
+    free(ie->chaves);
+    free(ie->posicoes);
+    ieInicializar(ie);
+}
+
+/* Monta o índice sobre base[0..n), que DEVE estar ordenado por nome.
+   Retorna 1 se ok, 0 se faltou memória. */
+static inline int ieConstruir(IndiceEytzinger *ie, const void *base, size_t n,
+                              size_t passo, size_t deslocNome) {
+    size_t i, k;
+
+    ieLiberar(ie);
+    ie->base = (const char *)base;
+    ie->n = n;
+    ie->passo = passo;
+    ie->deslocNome = deslocNome;
+    if (n == 0) return 1;
+    if (n >= UINT32_MAX) return 0;
+
+    /* chaves alinhadas em 64 bytes para o prefetch pegar blocos inteiros */
+    ie->chaves = (uint64_t *)aligned_alloc(64, ((n + 1) * sizeof(uint64_t) + 63) / 64 * 64);
+    ie->posicoes = (uint32_t *)malloc((n + 1) * sizeof(uint32_t));
+    if (ie->chaves == NULL || ie->posicoes == NULL) {
+        ieLiberar(ie);
+        return 0;
+    }
+
+    /* prefixo comum = maior prefixo comum entre o primeiro e o último nome */
+    {
+        const char *a = ieNome(ie, 0), *b = ieNome(ie, n - 1);
+        size_t c = 0;
+        while (a[c] != '\0' && a[c] == b[c]) c++;
+        ie->comum = c;
+    }
+
+    /* percurso em ordem simétrica da árvore implícita: o i-ésimo nó visitado
+       recebe o i-ésimo nome do vetor ordenado */
+    i = 0;
+    k = 1;
+    for (;;) {
+        while (k <= n) k = 2 * k;           /* desce tudo à esquerda */
+        k >>= __builtin_ctzll(~(unsigned long long)k) + 1; /* sobe até o próximo nó não visitado */
+        if (k == 0) break;
+        ie->chaves[k] = iePrefixo(ieNome(ie, i) + ie->comum);
+        ie->posicoes[k] = (uint32_t)i;
+        i++;
+        k = 2 * k + 1;                      /* segue para a subárvore direita */
+    }
+    ie->chaves[0] = 0;
+    ie->posicoes[0] = 0;
+    return 1;
+}
+
+/* Busca 'nome' no índice. Retorna a posição no vetor ordenado ou -1.
+   *comparacoes soma as comparações de prefixo e os strcmp de desempate. */
+static inline long ieBuscar(const IndiceEytzinger *ie, const char *nome, long *comparacoes) {
+    const uint64_t *chaves = ie->chaves;
+    size_t n = ie->n;
+    size_t k = 1;
+    uint64_t x;
+    long comps = 0;
+    size_t r;
+
+    if (n == 0) return -1;
+    /* consulta precisa começar pelo mesmo prefixo comum dos nomes indexados */
+    if (ie->comum > 0) {
+        comps++;
+        if (strncmp(nome, ieNome(ie, 0), ie->comum) != 0) {
+            *comparacoes += comps;
+            return -1;
+        }
+    }
+    x = iePrefixo(nome + ie->comum);
+
+    /* lower_bound sem desvios: 8 chaves por linha de cache, então k*8 está
+       3 níveis abaixo e é buscado antes de ser necessário */
+    while (k <= n) {
+        __builtin_prefetch(chaves + k * 8);
+        k = 2 * k + (chaves[k] < x);
+        comps++;
+    }
+    k >>= __builtin_ctzll(~(unsigned long long)k) + 1;
+    if (k == 0) {
+        *comparacoes += comps;
+        return -1;
+    }
+
+    /* nomes com o mesmo prefixo estão em sequência no vetor ordenado */
+    for (r = ie->posicoes[k]; r < n; r++) {
+        const char *candidato = ieNome(ie, r);
+        int cmp;
+        if (iePrefixo(candidato + ie->comum) != x) break;
+        comps++;
+        cmp = strcmp(candidato, nome);
+        if (cmp == 0) {
+            *comparacoes += comps;
+            return (long)r;
+        }
+        if (cmp > 0) break;
+    }
+    *comparacoes += comps;
+    return -1;
+}
+
+#endif /* INDICEEYTZINGER_H */
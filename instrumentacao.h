@@ -0,0 +1,303 @@
+/*
+  instrumentacao.h - Contadores, cronômetros e histogramas nos trechos quentes
+  ---------------------------------------------------------------------------
+  Medições que ficam no código e só existem quando o programa é compilado com
+  -DINSTRUMENTAR (make instrumentado). Sem a flag, as macros viram ((void)0):
+  nenhum custo, e os argumentos nem são avaliados.
+
+  - INSTR_CONTAR(nome) / INSTR_SOMAR(nome, n): contador com nome.
+  - INSTR_CRONOMETRAR(nome): mede, com CLOCK_MONOTONIC, do ponto onde aparece
+    até o fim do bloco (qualquer return incluso; usa cleanup do GCC/Clang).
+  - INSTR_VALOR(nome, v): distribuição de um valor (comparações, sondagens...).
+  - Tempos e valores vão para um histograma log2 (faixa k = [2^(k-1), 2^k)),
+    com contagem, total e máximo; no fim saem a média e os percentis.
+  - Cada thread escreve no seu próprio buffer, sem travas nem atômicos no
+    caminho quente. Os buffers de threads que terminaram são reaproveitados
+    pelas próximas (os totais só somam) e todos são juntados na saída.
+  - No fim do programa (atexit), um JSON com todos os pontos vai para stderr
+    ou para o arquivo da variável de ambiente INSTRUMENTACAO.
+  - Pontos com o mesmo nome, em lugares diferentes, somam no mesmo registro.
+
+  Uso:
+      void atacar(...) {
+          INSTR_CRONOMETRAR("atacar");       // no começo do bloco medido
+          ...
+          INSTR_VALOR("busca.comparacoes", comparacoes);
+          INSTR_CONTAR("territorio.conquistado");
+      }
+
+      make instrumentado
+      INSTRUMENTACAO=war.json build/instrumentado/warmestre --lote jogo.txt
+
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+#ifdef INSTRUMENTAR
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define INSTR_MAX_PONTOS 128
+#define INSTR_FAIXAS 48     /* faixa 47: 2^46 ns ou mais (cerca de 20 horas) */
+
+typedef enum { INSTR_CONTADOR, INSTR_TEMPO, INSTR_DISTRIBUICAO } InstrTipo;
+
+/* Um lugar do código que mede algo; 'id' é atribuído no primeiro uso */
+typedef struct {
+    const char *nome;
+    InstrTipo tipo;
+    int id;                 /* 0 = ainda não registrado; -1 = sem espaço */
+} InstrPonto;
+
+/* Buffer de uma thread: um registro por ponto */
+typedef struct InstrBuffer {
+    struct InstrBuffer *proximo;        /* todos os buffers já criados */
+    struct InstrBuffer *proximoLivre;   /* buffers de threads que terminaram */
+    uint64_t contagem[INSTR_MAX_PONTOS];
+    uint64_t total[INSTR_MAX_PONTOS];
+    uint64_t maximo[INSTR_MAX_PONTOS];
+    uint64_t faixas[INSTR_MAX_PONTOS][INSTR_FAIXAS];
+} InstrBuffer;
+
+typedef struct {
+    pthread_mutex_t trava;  /* só no registro de pontos e de threads */
+    pthread_key_t chave;    /* devolve o buffer quando a thread termina */
+    int iniciado;
+    int nPontos, nBuffers;
+    const char *nomes[INSTR_MAX_PONTOS];
+    InstrTipo tipos[INSTR_MAX_PONTOS];
+    InstrBuffer *buffers, *livres;
+} Instrumentacao;
+
+static Instrumentacao instrumentacao = { .trava = PTHREAD_MUTEX_INITIALIZER };
+static __thread InstrBuffer *instrBufferThread;
+
+static void instrDespejar(void);
+
+static inline void instrDevolverBuffer(void *b) {
+    pthread_mutex_lock(&instrumentacao.trava);
+    ((InstrBuffer *) b)->proximoLivre = instrumentacao.livres;
+    instrumentacao.livres = (InstrBuffer *) b;
+    pthread_mutex_unlock(&instrumentacao.trava);
+}
+
+/* Chamada com a trava */
+static inline void instrIniciar(void) {
+    if (instrumentacao.iniciado) return;
+    instrumentacao.iniciado = 1;
+    pthread_key_create(&instrumentacao.chave, instrDevolverBuffer);
+    atexit(instrDespejar);
+}
+
+/* Caminho lento do primeiro uso de um ponto: procura o nome ou cria o registro */
+static inline int instrRegistrar(InstrPonto *p) {
+    int i, id;
+    pthread_mutex_lock(&instrumentacao.trava);
+    instrIniciar();
+    id = p->id;
+    if (id == 0) {
+        for (i = 0; i < instrumentacao.nPontos; i++)
+            if (strcmp(instrumentacao.nomes[i], p->nome) == 0) break;
+        if (i == instrumentacao.nPontos && i < INSTR_MAX_PONTOS) {
+            instrumentacao.nomes[i] = p->nome;
+            instrumentacao.tipos[i] = p->tipo;
+            instrumentacao.nPontos++;
+        }
+        id = i < INSTR_MAX_PONTOS ? i + 1 : -1;
+        __atomic_store_n(&p->id, id, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_unlock(&instrumentacao.trava);
+    return id;
+}
+
+/* Caminho lento do primeiro uso numa thread: reaproveita ou cria um buffer */
+static inline InstrBuffer *instrNovoBuffer(void) {
+    InstrBuffer *b;
+    pthread_mutex_lock(&instrumentacao.trava);
+    instrIniciar();
+    b = instrumentacao.livres;
+    if (b) {
+        instrumentacao.livres = b->proximoLivre;
+    } else if ((b = (InstrBuffer *) calloc(1, sizeof(InstrBuffer))) != NULL) {
+        b->proximo = instrumentacao.buffers;
+        instrumentacao.buffers = b;
+        instrumentacao.nBuffers++;
+    }
+    if (b) pthread_setspecific(instrumentacao.chave, b);
+    pthread_mutex_unlock(&instrumentacao.trava);
+    instrBufferThread = b;
+    return b;
+}
+
+static inline int instrFaixa(uint64_t v) {
+    int k = v > 0 ? 64 - __builtin_clzll(v) : 0;
+    return k < INSTR_FAIXAS ? k : INSTR_FAIXAS - 1;
+}
+
+/* Registro do ponto no buffer desta thread (NULL se não há como medir) */
+static inline InstrBuffer *instrBuffer(InstrPonto *p, int *i) {
+    int id = __atomic_load_n(&p->id, __ATOMIC_ACQUIRE);
+    InstrBuffer *b = instrBufferThread;
+    if (id == 0) id = instrRegistrar(p);
+    if (id < 0) return NULL;
+    if (!b) b = instrNovoBuffer();
+    *i = id - 1;
+    return b;
+}
+
+static inline void instrSomar(InstrPonto *p, uint64_t n) {
+    int i;
+    InstrBuffer *b = instrBuffer(p, &i);
+    if (b) b->contagem[i] += n;
+}
+
+static inline void instrValor(InstrPonto *p, uint64_t v) {
+    int i;
+    InstrBuffer *b = instrBuffer(p, &i);
+    if (!b) return;
+    b->contagem[i]++;
+    b->total[i] += v;
+    if (v > b->maximo[i]) b->maximo[i] = v;
+    b->faixas[i][instrFaixa(v)]++;
+}
+
+typedef struct {
+    InstrPonto *ponto;
+    struct timespec inicio;
+} InstrCronometro;
+
+static inline InstrCronometro instrIniciarCronometro(InstrPonto *p) {
+    InstrCronometro c;
+    c.ponto = p;
+    clock_gettime(CLOCK_MONOTONIC, &c.inicio);
+    return c;
+}
+
+static inline void instrPararCronometro(InstrCronometro *c) {
+    struct timespec fim;
+    int64_t ns;
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    ns = (int64_t)(fim.tv_sec - c->inicio.tv_sec) * 1000000000 + (fim.tv_nsec - c->inicio.tv_nsec);
+    instrValor(c->ponto, ns > 0 ? (uint64_t) ns : 0);
+}
+
+/* Limite superior da faixa onde o percentil p cai (o máximo, na última) */
+static inline uint64_t instrPercentil(const uint64_t *faixas, uint64_t contagem, uint64_t maximo, double p) {
+    uint64_t alvo = (uint64_t)(p * contagem), acumulado = 0;
+    int k;
+    for (k = 0; k < INSTR_FAIXAS; k++) {
+        acumulado += faixas[k];
+        if (acumulado > alvo) {
+            uint64_t limite = k == 0 ? 0 : (uint64_t) 1 << k;
+            return limite < maximo ? limite : maximo;
+        }
+    }
+    return maximo;
+}
+
+static inline void instrEscreverTexto(FILE *saida, const char *s) {
+    fputc('"', saida);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') fputc('\\', saida);
+        if ((unsigned char) *s >= 0x20) fputc(*s, saida);
+    }
+    fputc('"', saida);
+}
+
+/* Junta os buffers de todas as threads e escreve o JSON */
+static void instrDespejar(void) {
+    static const char *tipos[] = { "contador", "tempo_ns", "distribuicao" };
+    static uint64_t faixas[INSTR_FAIXAS];
+    const char *caminho = getenv("INSTRUMENTACAO");
+    char linha[256] = "?";
+    const char *programa = linha;
+    FILE *saida = stderr, *cmdline;
+    int i, k, primeiro;
+
+    if (caminho && *caminho && !(saida = fopen(caminho, "w"))) {
+        perror(caminho);
+        return;
+    }
+    /* nome do programa: argv[0] sem o diretório */
+    if ((cmdline = fopen("/proc/self/cmdline", "r")) != NULL) {
+        size_t n = fread(linha, 1, sizeof(linha) - 1, cmdline);
+        linha[n] = '\0';
+        if (strrchr(linha, '/')) programa = strrchr(linha, '/') + 1;
+        fclose(cmdline);
+    }
+
+    pthread_mutex_lock(&instrumentacao.trava);
+    fprintf(saida, "{\n  \"programa\": ");
+    instrEscreverTexto(saida, programa);
+    fprintf(saida, ",\n  \"buffers\": %d,\n  \"pontos\": [", instrumentacao.nBuffers);
+    for (i = 0; i < instrumentacao.nPontos; i++) {
+        uint64_t contagem = 0, total = 0, maximo = 0;
+        const InstrBuffer *b;
+        memset(faixas, 0, sizeof(faixas));
+        for (b = instrumentacao.buffers; b; b = b->proximo) {
+            contagem += b->contagem[i];
+            total += b->total[i];
+            if (b->maximo[i] > maximo) maximo = b->maximo[i];
+            for (k = 0; k < INSTR_FAIXAS; k++) faixas[k] += b->faixas[i][k];
+        }
+        fprintf(saida, "%s\n    {\"nome\": ", i ? "," : "");
+        instrEscreverTexto(saida, instrumentacao.nomes[i]);
+        fprintf(saida, ", \"tipo\": \"%s\", \"contagem\": %llu", tipos[instrumentacao.tipos[i]],
+                (unsigned long long) contagem);
+        if (instrumentacao.tipos[i] == INSTR_CONTADOR) {
+            fprintf(saida, "}");
+            continue;
+        }
+        fprintf(saida, ", \"total\": %llu, \"media\": %.1f, \"max\": %llu",
+                (unsigned long long) total, contagem ? (double) total / contagem : 0.0,
+                (unsigned long long) maximo);
+        fprintf(saida, ", \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"p999\": %llu",
+                (unsigned long long) instrPercentil(faixas, contagem, maximo, 0.50),
+                (unsigned long long) instrPercentil(faixas, contagem, maximo, 0.90),
+                (unsigned long long) instrPercentil(faixas, contagem, maximo, 0.99),
+                (unsigned long long) instrPercentil(faixas, contagem, maximo, 0.999));
+        /* histograma: só as faixas ocupadas, como [limite superior, contagem] */
+        fprintf(saida, ",\n     \"faixas\": [");
+        for (k = 0, primeiro = 1; k < INSTR_FAIXAS; k++) {
+            if (faixas[k] == 0) continue;
+            fprintf(saida, "%s[%llu, %llu]", primeiro ? "" : ", ",
+                    (unsigned long long)(k == 0 ? 1 : (uint64_t) 1 << k), (unsigned long long) faixas[k]);
+            primeiro = 0;
+        }
+        fprintf(saida, "]}");
+    }
+    fprintf(saida, "\n  ]\n}\n");
+    pthread_mutex_unlock(&instrumentacao.trava);
+    if (saida != stderr) fclose(saida);
+}
+
+#define INSTR_JUNTAR_(a, b) a##b
+#define INSTR_JUNTAR(a, b) INSTR_JUNTAR_(a, b)
+#define INSTR_PONTO(nome, tipo) \
+    (__extension__({ static InstrPonto instrPonto_ = { nome, tipo, 0 }; &instrPonto_; }))
+
+#define INSTR_SOMAR(nome, n) instrSomar(INSTR_PONTO(nome, INSTR_CONTADOR), (uint64_t)(n))
+#define INSTR_CONTAR(nome) INSTR_SOMAR(nome, 1)
+#define INSTR_VALOR(nome, v) instrValor(INSTR_PONTO(nome, INSTR_DISTRIBUICAO), (uint64_t)(v))
+#define INSTR_CRONOMETRAR(nome) \
+    InstrCronometro INSTR_JUNTAR(instrCronometro_, __LINE__) \
+        __attribute__((cleanup(instrPararCronometro))) = \
+        instrIniciarCronometro(INSTR_PONTO(nome, INSTR_TEMPO))
+
+#else /* sem INSTRUMENTAR: nada é compilado */
+
+#define INSTR_SOMAR(nome, n) ((void) 0)
+#define INSTR_CONTAR(nome) ((void) 0)
+#define INSTR_VALOR(nome, v) ((void) 0)
+#define INSTR_CRONOMETRAR(nome) ((void) 0)
+
+#endif /* INSTRUMENTAR */
+
+#endif /* INSTRUMENTACAO_H */
@@ -0,0 +1,178 @@
+/*
+  lote.h - Modo lote: fluxo de comandos de um arquivo, saída legível por máquina
+  ------------------------------------------------------------------------------
+  Os programas de menu aceitam --lote arquivo (ou --lote - para a entrada
+  padrão) e executam os comandos sem perguntas, na velocidade das estruturas.
+  Serve para repetir cargas gravadas e testar os dados sem passar pelo menu.
+
+  Entrada (texto, um comando por linha):
+  - Campos separados por tabulação; se a linha não tem tabulação, por espaços
+    (nomes com espaço só no formato com tabulação).
+  - Linhas em branco e linhas que começam com '#' são ignoradas.
+  - O primeiro campo é o nome do comando; cada programa define os seus.
+
+  Saída (stdout, uma linha por resultado, campos separados por tabulação):
+      ok     <comando> [campos...]     comando executado
+      nao    <comando> [campos...]     executado, mas sem efeito (item não
+                                       encontrado, peça impossível...)
+      erro   <linha> <mensagem>        comando malformado (não executado)
+  Listagens imprimem linhas extras logo depois da linha "ok". No fim, um
+  resumo vai para stderr (comandos, erros, tempo) sem misturar com a saída.
+
+  - O arquivo inteiro é lido para a memória antes de começar, e stdout ganha
+    um buffer de 64 KB: nenhuma chamada de sistema por comando.
+
+  Uso:
+      Lote lote;
+      if (!loteAbrir(&lote, caminho)) return 1;
+      while (loteProximo(&lote)) {
+          if (loteComando(&lote, "buscar", 1)) { ... printf("ok\tbuscar\t...\n"); }
+          else loteErro(&lote, "comando desconhecido");
+      }
+      return loteFechar(&lote);
+
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LOTE_MAX_CAMPOS 8
+#define LOTE_BUFFER_SAIDA (1 << 16)
+
+typedef struct {
+    char *dados;            /* arquivo inteiro, terminado em '\0' */
+    char *cursor;           /* início da próxima linha */
+    const char *origem;
+    long numLinha;
+    char *campos[LOTE_MAX_CAMPOS];
+    int nCampos;
+    long comandos, erros;
+    struct timespec inicio;
+} Lote;
+
+static char loteSaida[LOTE_BUFFER_SAIDA];
+
+/* Lê o arquivo ("-" = entrada padrão). Retorna 0 (com mensagem) se falhar. */
+static inline int loteAbrir(Lote *l, const char *caminho) {
+    FILE *arq = strcmp(caminho, "-") == 0 ? stdin : fopen(caminho, "rb");
+    size_t tamanho = 0, capacidade = 1 << 16, n;
+    memset(l, 0, sizeof(*l));
+    l->origem = caminho;
+    if (!arq) {
+        fprintf(stderr, "Não foi possível abrir o lote %s: %s\n", caminho, strerror(errno));
+        return 0;
+    }
+    l->dados = (char *) malloc(capacidade);
+    while (l->dados) {
+        if (capacidade - tamanho < 2) {
+            char *maior = (char *) realloc(l->dados, capacidade * 2);
+            if (!maior) { free(l->dados); l->dados = NULL; break; }
+            l->dados = maior;
+            capacidade *= 2;
+        }
+        n = fread(l->dados + tamanho, 1, capacidade - tamanho - 1, arq);
+        if (n == 0) break;
+        tamanho += n;
+    }
+    if (arq != stdin) fclose(arq);
+    if (!l->dados) {
+        fprintf(stderr, "Memória insuficiente para o lote %s\n", caminho);
+        return 0;
+    }
+    l->dados[tamanho] = '\0';
+    l->cursor = l->dados;
+    setvbuf(stdout, loteSaida, _IOFBF, sizeof(loteSaida));
+    clock_gettime(CLOCK_MONOTONIC, &l->inicio);
+    return 1;
+}
+
+/* Avança para o próximo comando e separa os campos (no próprio buffer).
+   Retorna 0 no fim do arquivo. */
+static inline int loteProximo(Lote *l) {
+    while (*l->cursor) {
+        char *linha = l->cursor, *fim = strchr(linha, '\n'), *p;
+        char separador;
+        if (fim) {
+            *fim = '\0';
+            l->cursor = fim + 1;
+        } else {
+            l->cursor = linha + strlen(linha);
+            fim = l->cursor;
+        }
+        l->numLinha++;
+        if (fim > linha && fim[-1] == '\r') fim[-1] = '\0';
+        separador = strchr(linha, '\t') ? '\t' : ' ';
+        while (*linha == ' ' || *linha == '\t') linha++;
+        if (*linha == '\0' || *linha == '#') continue;
+
+        l->nCampos = 0;
+        for (p = linha; l->nCampos < LOTE_MAX_CAMPOS; ) {
+            if (separador == ' ') while (*p == ' ') p++;
+            if (*p == '\0') break;
+            l->campos[l->nCampos++] = p;
+            p = strchr(p, separador);
+            if (!p) break;
+            *p++ = '\0';
+        }
+        l->comandos++;
+        return 1;
+    }
+    return 0;
+}
+
+/* Campo i (0 = comando) ou "" se não existe */
+static inline const char *loteCampo(const Lote *l, int i) {
+    return i < l->nCampos ? l->campos[i] : "";
+}
+
+/* O comando atual é 'nome' e tem pelo menos 'argumentos' campos depois dele */
+static inline int loteComando(const Lote *l, const char *nome, int argumentos) {
+    return strcmp(l->campos[0], nome) == 0 && l->nCampos > argumentos;
+}
+
+/* Campo i como inteiro; 0 se não existe ou não é um número inteiro completo */
+static inline int loteInteiro(const Lote *l, int i, long *x) {
+    char *fim;
+    long valor;
+    if (i >= l->nCampos) return 0;
+    errno = 0;
+    valor = strtol(l->campos[i], &fim, 10);
+    if (fim == l->campos[i] || *fim != '\0' || errno == ERANGE) return 0;
+    *x = valor;
+    return 1;
+}
+
+/* Linha "erro" para um comando malformado */
+static inline void loteErro(Lote *l, const char *formato, ...) {
+    va_list args;
+    l->erros++;
+    printf("erro\t%ld\t", l->numLinha);
+    va_start(args, formato);
+    vprintf(formato, args);
+    va_end(args);
+    putchar('\n');
+}
+
+/* Resumo em stderr e liberação; retorna o código de saída (1 se houve erro) */
+static inline int loteFechar(Lote *l) {
+    struct timespec fim;
+    double seg;
+    fflush(stdout);
+    clock_gettime(CLOCK_MONOTONIC, &fim);
+    seg = (double)(fim.tv_sec - l->inicio.tv_sec) + (fim.tv_nsec - l->inicio.tv_nsec) / 1e9;
+    fprintf(stderr, "# lote %s: %ld comandos, %ld erros, %.3f s, %.0f comandos/s\n",
+            l->origem, l->comandos, l->erros, seg, seg > 0 ? l->comandos / seg : 0.0);
+    free(l->dados);
+    l->dados = l->cursor = NULL;
+    return l->erros > 0;
+}
+
+#endif /* LOTE_H */
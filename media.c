@@ -1,28 +1,731 @@
+#include <fcntl.h>
+#include <math.h>
+#include <pthread.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "colunasnotas.h"
+#include "console.h"
+#include "instrumentacao.h"
+#include "memoria.h"
+#include "randomizador.h"
 
-int main(){
+/*
+    Programa: Média de notas
+    Funcionalidades:
+    - Modo interativo: lê nome, idade, matrícula e duas notas de um aluno e
+      mostra a média
+    - Modo arquivo: ./media --csv turma.csv [--alunos] [--threads n] processa
+      um arquivo de matrículas inteiro (nome,idade,matricula,n1,n2 por linha)
+      em uma única passada e com memória constante:
+        * arquivo comum: mapeado na memória (mmap) e dividido em n trechos
+          cortados em fins de linha, um por thread (padrão: um por núcleo);
+          cada thread acumula os seus agregados e no fim eles são juntados
+          (médias e variâncias pela fórmula de Chan, histogramas somados);
+        * pipe (--csv -) ou --alunos: lê em blocos de 1 MB (as linhas
+          cortadas no fim do bloco passam para o próximo);
+        * as notas são convertidas à mão (sem strtod/scanf) e guardadas em
+          colunas (colunasnotas.h) de até 4096 alunos; a média de cada aluno
+          e a contagem de aprovados (média >= 6) de cada bloco saem dos
+          núcleos SSE2/AVX2, e só então entram nos agregados;
+        * média, variância (Welford), mínimo e máximo de n1, n2 e da média;
+        * percentis por um histograma das notas em passos de 0,01 (as notas
+          vão de 0 a 10), que ocupa 8 KB por campo seja qual for o arquivo;
+        * --alunos escreve a média de cada aluno (matricula, nome, media)
+    - Separador ',' ou ';' (detectado na primeira linha); com ';' as notas
+      podem usar vírgula decimal (7,5). Um cabeçalho na primeira linha é
+      ignorado. Linhas inválidas são contadas e as primeiras são relatadas.
+    - ./media --gerar n [semente] escreve um arquivo de teste com n alunos
+    - ./media --bench n gera n alunos num arquivo temporário e mede o modo arquivo
+    - ./media --bench-paralelo n [threads] mede a leitura paralela com 1, 2,
+      4... threads (ganho e eficiência em relação a 1 thread)
+    - ./media --bench-simd n [repeticoes] mede os núcleos de colunasnotas.h
+      (média, média ponderada e contagem de aprovados sobre n alunos em
+      colunas) nas versões escalar, SSE2 e AVX2, em GB/s
+*/
 
-char nome[50];
-int idade;
-int matricula;
-float n1;
-float n2, media;
+#define TAMANHO_BLOCO (1 << 20)   // leitura do arquivo em blocos de 1 MB
+#define MAX_LINHA 4096            // linha maior que isso é inválida
+#define NOTA_MAXIMA 10.0
+#define FAIXAS_NOTA 1001          // histograma: 0,00 .. 10,00 em passos de 0,01
+#define MAX_ERROS_RELATADOS 10
+#define BLOCO_NOTAS 4096          // alunos por bloco de colunas passado aos núcleos vetoriais
+#define NOTA_APROVACAO 6.0f
 
-printf("Qual o seu nome? \n");
-scanf("%s", &nome);
-printf("Qual a sua idade? \n");
-scanf("%d", &idade);
-printf("Qual a sua matricula? \n");
-scanf("%d", &matricula);
+MEM_CONTA(memLeitura, "leitura (buffer e trechos)");
 
-printf("Digite sua nota 1: \n");
-scanf("%f", &n1);
-printf("Digite sua nota 2: \n");
-scanf("%f", &n2);
+// Estatística de um campo (n1, n2 ou média) acumulada em uma passada
+typedef struct {
+    long n;
+    double media, m2;         // Welford: média e soma dos quadrados dos desvios
+    double minimo, maximo;
+    long faixas[FAIXAS_NOTA];
+} Estatistica;
 
-printf("Seu nome é: %c\n", nome);
-printf(" Sua idade é: %d\n", idade);
+typedef struct {
+    Estatistica n1, n2, media;
+    ColunasNotas bloco;       // notas lidas que ainda não entraram nas estatísticas
+    long aprovados;           // média >= NOTA_APROVACAO
+    long numLinhas;           // linhas do texto (inclui cabeçalho e linhas vazias)
+    long linhas, invalidas;   // linhas de dados e, delas, as inválidas
+    long long bytes;
+    char separador;           // 0 até a primeira linha ser vista
+    int porAluno;             // --alunos: uma linha de saída por aluno
+    int threads;
+    long errosLinha[MAX_ERROS_RELATADOS];   // primeiras linhas inválidas
+    const char *errosMotivo[MAX_ERROS_RELATADOS];
+} Processador;
 
+// ---------- Estatística ---------- //
 
-return 0;
+void inicializarEstatistica(Estatistica *e) {
+    memset(e, 0, sizeof(*e));
+    e->minimo = NOTA_MAXIMA;
+    e->maximo = 0.0;
+}
+
+// Welford: atualiza média e M2 sem somar quadrados grandes (estável numericamente)
+void acumular(Estatistica *e, double x) {
+    double delta = x - e->media;
+    e->n++;
+    e->media += delta / e->n;
+    e->m2 += delta * (x - e->media);
+    if (x < e->minimo) e->minimo = x;
+    if (x > e->maximo) e->maximo = x;
+    e->faixas[(int)(x * 100.0 + 0.5)]++;
+}
+
+// Junta a estatística de outra parte do arquivo (Chan et al.: média e M2 das
+// duas partes combinadas sem rever os valores; o histograma é somado)
+void combinarEstatistica(Estatistica *e, const Estatistica *parte) {
+    long n = e->n + parte->n;
+    double delta = parte->media - e->media;
+    if (parte->n == 0) return;
+    e->media += delta * parte->n / n;
+    e->m2 += parte->m2 + delta * delta * ((double) e->n * parte->n / n);
+    e->n = n;
+    if (parte->minimo < e->minimo) e->minimo = parte->minimo;
+    if (parte->maximo > e->maximo) e->maximo = parte->maximo;
+    for (int i = 0; i < FAIXAS_NOTA; i++) e->faixas[i] += parte->faixas[i];
+}
+
+double variancia(const Estatistica *e) {
+    return e->n > 1 ? e->m2 / (e->n - 1) : 0.0;
+}
+
+// Menor nota (em passos de 0,01) com pelo menos p dos valores abaixo ou iguais
+double percentil(const Estatistica *e, double p) {
+    long alvo = (long)(p * e->n), acumulado = 0;
+    if (alvo >= e->n) alvo = e->n - 1;
+    for (int i = 0; i < FAIXAS_NOTA; i++) {
+        acumulado += e->faixas[i];
+        if (acumulado > alvo) return i / 100.0 > e->maximo ? e->maximo : i / 100.0;
+    }
+    return e->maximo;
+}
+
+// ---------- Leitura do CSV ---------- //
+
+void inicializarProcessador(Processador *p, int porAluno) {
+    memset(p, 0, sizeof(*p));
+    inicializarEstatistica(&p->n1);
+    inicializarEstatistica(&p->n2);
+    inicializarEstatistica(&p->media);
+    p->porAluno = porAluno;
+    p->threads = 1;
+}
+
+// Reserva o bloco de colunas. Deve ser chamada pela thread principal: as contas
+// de memoria.h não são atômicas, então as threads da leitura paralela só usam
+// blocos já reservados (e nunca crescem). Sem memória, as notas vão direto
+// para as estatísticas.
+void reservarBloco(Processador *p) {
+    cnReservar(&p->bloco, BLOCO_NOTAS);
+}
+
+// Passa o bloco de notas pelos núcleos vetoriais (médias e aprovados) e soma as
+// três colunas nas estatísticas. Com 'liberar', devolve também as colunas.
+void descarregarBloco(Processador *p, int liberar) {
+    INSTR_CRONOMETRAR("descarregarBloco");
+    ColunasNotas *c = &p->bloco;
+    if (c->tamanho > 0) {
+        const NucleosNotas *k = cnNucleos();
+        k->media(c->n1, c->n2, c->media, c->tamanho);
+        p->aprovados += (long) k->contar(c->media, c->tamanho, NOTA_APROVACAO);
+        for (size_t i = 0; i < c->tamanho; i++) {
+            acumular(&p->n1, c->n1[i]);
+            acumular(&p->n2, c->n2[i]);
+            acumular(&p->media, c->media[i]);
+        }
+        c->tamanho = 0;
+    }
+    if (liberar) cnLiberar(c);
+}
+
+// Converte a nota em [ini, fim) sem strtod: dígitos, e opcionalmente '.' (ou
+// ',' quando o separador não é ',') seguido de mais dígitos; espaços nas
+// pontas são ignorados. Retorna 0 se não é um número entre 0 e 10.
+int converterNota(const char *ini, const char *fim, char separador, double *nota) {
+    INSTR_CRONOMETRAR("converterNota");
+    long inteiro = 0, fracao = 0, escala = 1;
+    int digitos = 0;
+
+    while (ini < fim && *ini == ' ') ini++;
+    while (fim > ini && (fim[-1] == ' ' || fim[-1] == '\r')) fim--;
+    for (; ini < fim && *ini >= '0' && *ini <= '9'; ini++, digitos++)
+        if (inteiro <= NOTA_MAXIMA) inteiro = inteiro * 10 + (*ini - '0');   // > 10 já é inválida
+    if (ini < fim && (*ini == '.' || (*ini == ',' && separador != ','))) {
+        for (ini++; ini < fim && *ini >= '0' && *ini <= '9'; ini++, digitos++) {
+            if (escala < 1000000000L) {   // casas além da 9a não mudam a nota em float
+                fracao = fracao * 10 + (*ini - '0');
+                escala *= 10;
+            }
+        }
+    }
+    if (ini != fim || digitos == 0) return 0;
+    *nota = inteiro + (double) fracao / escala;
+    return *nota <= NOTA_MAXIMA;
+}
+
+// Conta a linha atual (p->numLinhas) como inválida e guarda as primeiras para o relatório
+void registrarInvalida(Processador *p, const char *motivo) {
+    INSTR_CONTAR("csv.invalidas");
+    if (p->invalidas < MAX_ERROS_RELATADOS) {
+        p->errosLinha[p->invalidas] = p->numLinhas;
+        p->errosMotivo[p->invalidas] = motivo;
+    }
+    p->invalidas++;
+}
+
+void relatarInvalidas(const Processador *p) {
+    for (long i = 0; i < p->invalidas && i < MAX_ERROS_RELATADOS; i++)
+        fprintf(stderr, "linha %ld: %s\n", p->errosLinha[i], p->errosMotivo[i]);
+    if (p->invalidas > MAX_ERROS_RELATADOS)
+        fprintf(stderr, "(mais %ld linhas inválidas não mostradas)\n", p->invalidas - MAX_ERROS_RELATADOS);
+}
+
+// Separa os 5 campos da linha [linha, fim) (sem o '\n') e acumula as notas. A
+// linha não é alterada: pode estar num arquivo mapeado só para leitura.
+void processarLinha(Processador *p, const char *linha, const char *fim) {
+    const char *campos[5], *c = linha;
+    int n = 0;
+    double n1, n2, media;
+
+    if (fim > linha && fim[-1] == '\r') fim--;
+    if (p->separador == 0) {
+        const char *segundo;
+        p->separador = memchr(linha, ';', (size_t)(fim - linha)) ? ';' : ',';
+        // cabeçalho: a idade (segundo campo) não começa com dígito
+        segundo = (const char *) memchr(linha, p->separador, (size_t)(fim - linha));
+        if (segundo && (segundo + 1 == fim || segundo[1] < '0' || segundo[1] > '9')) return;
+    }
+    if (linha == fim) return;
+
+    p->linhas++;
+    campos[n++] = linha;
+    while (n < 5 && (c = (const char *) memchr(c, p->separador, (size_t)(fim - c))) != NULL)
+        campos[n++] = ++c;
+    if (n < 5) {
+        registrarInvalida(p, "esperados 5 campos: nome, idade, matricula, n1, n2");
+        return;
+    }
+    if (!converterNota(campos[3], campos[4] - 1, p->separador, &n1) ||
+        !converterNota(campos[4], fim, p->separador, &n2)) {
+        registrarInvalida(p, "nota fora de 0..10 ou não numérica");
+        return;
+    }
+
+    if (p->bloco.tamanho == p->bloco.capacidade) descarregarBloco(p, 0);
+    if (p->bloco.capacidade == 0 || !cnAdicionar(&p->bloco, (float) n1, (float) n2)) {
+        // sem memória para as colunas: acumula este aluno direto (média escalar)
+        float m = ((float) n1 + (float) n2) * 0.5f;
+        acumular(&p->n1, (float) n1);
+        acumular(&p->n2, (float) n2);
+        acumular(&p->media, m);
+        p->aprovados += m >= NOTA_APROVACAO;
+    }
+    if (p->porAluno) {
+        media = (n1 + n2) / 2.0;
+        printf("%.*s\t%.*s\t%.2f\n", (int)(campos[3] - 1 - campos[2]), campos[2],
+               (int)(campos[1] - 1 - campos[0]), campos[0], media);
+    }
+}
+
+// Processa as linhas completas de [inicio, fim) e, se 'ultimo', também a linha
+// final sem '\n'. Retorna onde parou (o começo da linha incompleta).
+const char *processarTrecho(Processador *p, const char *inicio, const char *fim, int ultimo) {
+    INSTR_CRONOMETRAR("processarTrecho");
+    const char *quebra;
+    while (inicio < fim) {
+        quebra = (const char *) memchr(inicio, '\n', (size_t)(fim - inicio));
+        if (quebra == NULL) {
+            if (!ultimo) break;
+            quebra = fim;
+        }
+        p->numLinhas++;
+        INSTR_CONTAR("csv.linhas");
+        if (quebra - inicio > MAX_LINHA) {
+            p->linhas++;
+            registrarInvalida(p, "linha longa demais");
+        } else {
+            processarLinha(p, inicio, quebra);
+        }
+        inicio = quebra < fim ? quebra + 1 : fim;
+    }
+    return inicio;
+}
+
+// Lê o arquivo em blocos; a linha incompleta no fim de um bloco é movida para o
+// início do buffer e completada pela leitura seguinte. Serve para qualquer
+// entrada (inclusive pipes) e para --alunos, que precisa da ordem do arquivo.
+// Retorna 0 se falhou.
+int processarArquivo(Processador *p, FILE *arq) {
+    char *buffer = (char *) memAlocar(&memLeitura, TAMANHO_BLOCO + MAX_LINHA);
+    size_t pendente = 0, lidos;
+    int descartando = 0;   // dentro de uma linha longa demais: pula até o '\n'
+
+    if (buffer == NULL) {
+        printf("Memória insuficiente.\n");
+        return 0;
+    }
+    reservarBloco(p);
+    do {
+        const char *inicio = buffer, *fim, *quebra;
+        lidos = fread(buffer + pendente, 1, TAMANHO_BLOCO, arq);
+        p->bytes += (long long) lidos;
+        fim = buffer + pendente + lidos;
+
+        if (descartando) {
+            quebra = (const char *) memchr(inicio, '\n', (size_t)(fim - inicio));
+            if (quebra == NULL) {
+                pendente = 0;
+                continue;
+            }
+            inicio = quebra + 1;
+            descartando = 0;
+        }
+        inicio = processarTrecho(p, inicio, fim, lidos == 0);
+        pendente = (size_t)(fim - inicio);
+        if (pendente > MAX_LINHA) {
+            p->numLinhas++;
+            p->linhas++;
+            registrarInvalida(p, "linha longa demais");
+            descartando = 1;
+            pendente = 0;
+        } else {
+            memmove(buffer, inicio, pendente);
+        }
+    } while (lidos > 0);
+
+    descarregarBloco(p, 1);
+    memLiberar(buffer);
+    if (ferror(arq)) {
+        printf("Erro de leitura.\n");
+        return 0;
+    }
+    return 1;
+}
+
+// ---------- Leitura paralela ---------- //
+
+typedef struct {
+    Processador p;
+    const char *inicio, *fim;
+} Trecho;
+
+void *processarTrechoThread(void *arg) {
+    Trecho *t = (Trecho *) arg;
+    processarTrecho(&t->p, t->inicio, t->fim, 1);
+    descarregarBloco(&t->p, 0);   // as colunas são devolvidas pela thread principal
+    return NULL;
+}
+
+// Junta o resultado de um trecho no total; as linhas inválidas do trecho são
+// renumeradas a partir das linhas dos trechos anteriores
+void combinarProcessador(Processador *total, const Processador *parte) {
+    for (long i = 0; i < parte->invalidas && i < MAX_ERROS_RELATADOS; i++) {
+        if (total->invalidas + i >= MAX_ERROS_RELATADOS) break;
+        total->errosLinha[total->invalidas + i] = total->numLinhas + parte->errosLinha[i];
+        total->errosMotivo[total->invalidas + i] = parte->errosMotivo[i];
+    }
+    combinarEstatistica(&total->n1, &parte->n1);
+    combinarEstatistica(&total->n2, &parte->n2);
+    combinarEstatistica(&total->media, &parte->media);
+    total->aprovados += parte->aprovados;
+    total->numLinhas += parte->numLinhas;
+    total->linhas += parte->linhas;
+    total->invalidas += parte->invalidas;
+}
+
+// Divide [dados, dados + tamanho) em 'threads' trechos cortados logo depois de
+// um '\n', processa cada um numa thread com um Processador próprio (nada é
+// compartilhado durante a leitura) e junta tudo em 'total' na ordem do arquivo.
+// Retorna 0 (com mensagem) se faltou memória.
+int processarParalelo(Processador *total, const char *dados, size_t tamanho, int threads) {
+    INSTR_CRONOMETRAR("processarParalelo");
+    Trecho *trechos = (Trecho *) memAlocar(&memLeitura, threads * sizeof(Trecho));
+    pthread_t *ids = (pthread_t *) memAlocar(&memLeitura, threads * sizeof(pthread_t));
+    const char *fim = dados + tamanho, *corte = dados, *quebra;
+    int criadas = 0;
+
+    if (trechos == NULL || ids == NULL) {
+        printf("Memória insuficiente.\n");
+        memLiberar(trechos);
+        memLiberar(ids);
+        return 0;
+    }
+    // as primeiras linhas (até a que define o separador e o cabeçalho) são lidas
+    // aqui; os trechos já começam sabendo o separador
+    inicializarProcessador(total, 0);
+    reservarBloco(total);
+    while (total->separador == 0 && corte < fim) {
+        quebra = (const char *) memchr(corte, '\n', (size_t)(fim - corte));
+        corte = processarTrecho(total, corte, quebra ? quebra + 1 : fim, 1);
+    }
+    descarregarBloco(total, 1);
+    for (int i = 0; i < threads; i++) {
+        const char *alvo = i == threads - 1 ? fim : dados + tamanho / threads * (i + 1);
+        inicializarProcessador(&trechos[i].p, 0);
+        reservarBloco(&trechos[i].p);
+        trechos[i].p.separador = total->separador;
+        trechos[i].inicio = corte;
+        if (alvo < corte) alvo = corte;   // o trecho anterior passou do alvo (linha longa)
+        quebra = alvo < fim ? (const char *) memchr(alvo, '\n', (size_t)(fim - alvo)) : NULL;
+        corte = quebra ? quebra + 1 : fim;
+        trechos[i].fim = corte;
+    }
+    // o trecho 0 fica com a thread principal
+    for (int i = 1; i < threads; i++, criadas++)
+        if (pthread_create(&ids[i], NULL, processarTrechoThread, &trechos[i]) != 0) break;
+    processarTrechoThread(&trechos[0]);
+    for (int i = criadas + 1; i < threads; i++)   // sem thread: faz aqui mesmo
+        processarTrechoThread(&trechos[i]);
+    for (int i = 1; i <= criadas; i++) pthread_join(ids[i], NULL);
+
+    for (int i = 0; i < threads; i++) {
+        combinarProcessador(total, &trechos[i].p);
+        cnLiberar(&trechos[i].p.bloco);
+    }
+    total->bytes = (long long) tamanho;
+    total->threads = threads;
+    memLiberar(trechos);
+    memLiberar(ids);
+    return 1;
+}
+
+// Mapeia o arquivo na memória (só leitura). Retorna NULL se não é um arquivo
+// comum ou se o mapeamento falhou (*tamanho = 0 num arquivo vazio).
+const char *mapearArquivo(int fd, size_t *tamanho) {
+    struct stat info;
+    void *mapa;
+    *tamanho = 0;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) return NULL;
+    mapa = mmap(NULL, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapa == MAP_FAILED) return NULL;
+    madvise(mapa, (size_t) info.st_size, MADV_SEQUENTIAL);
+    *tamanho = (size_t) info.st_size;
+    return (const char *) mapa;
+}
+
+int nucleosDisponiveis(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int) n : 1;
+}
+
+void relatarCampo(FILE *saida, const char *nome, const Estatistica *e) {
+    if (e->n == 0) return;
+    fprintf(saida, "%-6s %6.3f %7.3f %5.2f %5.2f %5.2f %5.2f %5.2f %5.2f %5.2f %5.2f\n", nome,
+            e->media, sqrt(variancia(e)), e->minimo, percentil(e, 0.10), percentil(e, 0.25),
+            percentil(e, 0.50), percentil(e, 0.75), percentil(e, 0.90), percentil(e, 0.99), e->maximo);
+}
+
+// Resumo do arquivo (com --alunos vai para stderr, sem se misturar com as médias)
+void relatarResumo(const Processador *p, double segundos) {
+    FILE *saida = p->porAluno ? stderr : stdout;
+    fflush(stdout);
+    fprintf(saida, "# %ld alunos, %ld linhas inválidas | %.1f MB em %.3f s, %d thread(s) "
+            "(%.1f MB/s, %.2f M linhas/s)\n",
+            p->media.n, p->invalidas, p->bytes / 1e6, segundos, p->threads,
+            segundos > 0 ? p->bytes / 1e6 / segundos : 0.0,
+            segundos > 0 ? p->linhas / 1e6 / segundos : 0.0);
+    fprintf(saida, "%-6s %6s %7s %5s %5s %5s %5s %5s %5s %5s %5s\n", "campo", "media", "desvio",
+            "min", "p10", "p25", "p50", "p75", "p90", "p99", "max");
+    relatarCampo(saida, "n1", &p->n1);
+    relatarCampo(saida, "n2", &p->n2);
+    relatarCampo(saida, "media", &p->media);
+    if (p->media.n > 0)
+        fprintf(saida, "aprovados (media >= %.1f): %ld (%.1f%%)\n", NOTA_APROVACAO, p->aprovados,
+                100.0 * p->aprovados / p->media.n);
+}
+
+double tempoMonotonico(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// Processa o arquivo ("-" = entrada padrão) e mostra o resumo. Um arquivo
+// comum é mapeado e lido por 'threads' threads; pipes e --alunos (que escreve
+// na ordem do arquivo) usam a leitura em blocos.
+int executarCsv(const char *caminho, int porAluno, int threads) {
+    static Processador p;   // 3 histogramas de 8 KB: fora da pilha
+    FILE *arq = strcmp(caminho, "-") == 0 ? stdin : fopen(caminho, "rb");
+    const char *mapa = NULL;
+    size_t tamanho = 0;
+    double inicio;
+    int ok;
+
+    if (arq == NULL) {
+        printf("Não foi possível abrir %s\n", caminho);
+        return 1;
+    }
+    inicializarProcessador(&p, porAluno);
+    if (porAluno) setvbuf(stdout, NULL, _IOFBF, 1 << 16);
+    else mapa = mapearArquivo(fileno(arq), &tamanho);
+
+    inicio = tempoMonotonico();
+    if (mapa) {
+        ok = processarParalelo(&p, mapa, tamanho, threads);
+        munmap((void *) mapa, tamanho);
+    } else {
+        ok = processarArquivo(&p, arq);
+    }
+    if (arq != stdin) fclose(arq);
+    relatarInvalidas(&p);
+    relatarResumo(&p, tempoMonotonico() - inicio);
+    return ok ? (p.invalidas > 0) : 1;
+}
+
+// ---------- Arquivo de teste ---------- //
+
+// n alunos com notas sorteadas (0,00 a 10,00) e cabeçalho
+int gerarAlunos(FILE *saida, long n, uint64_t semente) {
+    static Randomizador r;
+    randomizadorSemear(&r, semente);
+    fprintf(saida, "nome,idade,matricula,n1,n2\n");
+    for (long i = 0; i < n; i++) {
+        uint32_t n1 = rndLimitado(&r, 1001), n2 = rndLimitado(&r, 1001);
+        if (fprintf(saida, "Aluno %ld,%u,%ld,%u.%02u,%u.%02u\n", i + 1, 17 + rndLimitado(&r, 44),
+                    2024000000L + i, n1 / 100, n1 % 100, n2 / 100, n2 % 100) < 0)
+            return 0;
+    }
+    return fflush(saida) == 0;
+}
+
+// Gera n alunos num arquivo temporário e mede o processamento em uma passada
+int benchmarkCsv(long n) {
+    static Processador p;
+    FILE *arq = tmpfile();
+    double inicio, seg;
+
+    if (arq == NULL || !gerarAlunos(arq, n, 1)) {
+        printf("Não foi possível criar o arquivo temporário.\n");
+        return 1;
+    }
+    printf("=== Benchmark do modo arquivo: %ld alunos ===\n", n);
+    for (int passada = 1; passada <= 2; passada++) {   // a 1a aquece o cache de páginas
+        rewind(arq);
+        inicializarProcessador(&p, 0);
+        inicio = tempoMonotonico();
+        if (!processarArquivo(&p, arq)) return 1;
+        seg = tempoMonotonico() - inicio;
+        printf("passada %d: ", passada);
+        relatarResumo(&p, seg);
+    }
+    fclose(arq);
+    return 0;
+}
+
+// Mesmo arquivo lido com 1, 2, 4... até 'maxThreads' threads (melhor de 3
+// execuções cada), comparado com a leitura em blocos; confere se os agregados
+// juntados são os mesmos com qualquer número de threads
+int benchmarkParalelo(long n, int maxThreads) {
+    static Processador referencia, p;
+    FILE *arq = tmpfile();
+    const char *mapa = NULL;
+    size_t tamanho;
+    double inicio, seg, tempoUm = 0.0, tempoMaximo = 0.0;   // com 1 e com maxThreads threads
+    int divergencias = 0, falhou = 0;
+
+    if (arq == NULL || !gerarAlunos(arq, n, 1) || (mapa = mapearArquivo(fileno(arq), &tamanho)) == NULL) {
+        printf("Não foi possível criar o arquivo temporário.\n");
+        if (arq) fclose(arq);
+        return 1;
+    }
+    printf("=== Leitura paralela: %ld alunos, %.1f MB, %d núcleo(s) disponíveis ===\n",
+           n, tamanho / 1e6, nucleosDisponiveis());
+
+    rewind(arq);
+    inicializarProcessador(&p, 0);
+    inicio = tempoMonotonico();
+    falhou = !processarArquivo(&p, arq);
+    seg = tempoMonotonico() - inicio;
+    if (!falhou)
+        printf("%-22s %8.3f s %8.1f MB/s\n", "blocos (fread)", seg, seg > 0 ? tamanho / 1e6 / seg : 0.0);
+    else
+        printf("Falha na leitura em blocos.\n");
+
+    printf("%-7s %8s %10s %12s %7s %10s\n", "threads", "tempo", "MB/s", "M linhas/s", "ganho", "eficiencia");
+    for (int t = 1; !falhou && t <= maxThreads; t = t * 2 > maxThreads && t < maxThreads ? maxThreads : t * 2) {
+        double melhor = 0.0;
+        for (int rodada = 0; !falhou && rodada < 3; rodada++) {
+            inicio = tempoMonotonico();
+            falhou = !processarParalelo(&p, mapa, tamanho, t);
+            seg = tempoMonotonico() - inicio;
+            if (rodada == 0 || seg < melhor) melhor = seg;
+        }
+        if (falhou) break;
+        if (melhor <= 0.0) melhor = 1e-9;   // arquivo pequeno demais para o relógio
+        tempoMaximo = melhor;
+        if (t == 1) {
+            tempoUm = melhor;
+            referencia = p;
+        }
+        // contagens e histogramas são exatos; média e M2 só mudam pela ordem das somas
+        if (p.media.n != referencia.media.n || p.invalidas != referencia.invalidas ||
+            p.aprovados != referencia.aprovados ||
+            memcmp(p.media.faixas, referencia.media.faixas, sizeof(p.media.faixas)) != 0 ||
+            fabs(p.media.media - referencia.media.media) > 1e-9 ||
+            fabs(variancia(&p.media) - variancia(&referencia.media)) > 1e-9)
+            divergencias++, printf("!! agregados diferentes com %d threads\n", t);
+        printf("%-7d %6.3f s %10.1f %12.2f %6.2fx %9.0f%%\n", t, melhor, tamanho / 1e6 / melhor,
+               p.linhas / 1e6 / melhor, tempoUm / melhor, 100.0 * tempoUm / melhor / t);
+    }
+    if (!falhou) relatarResumo(&p, tempoMaximo);
+    munmap((void *) mapa, tamanho);
+    fclose(arq);
+    return falhou || divergencias > 0;
+}
+
+// ---------- Núcleos vetoriais ---------- //
+
+#define BENCH_SIMD_ELEMENTOS 200000000L   // alunos processados por medição (n * repetições)
+
+typedef enum { NUCLEO_MEDIA, NUCLEO_PONDERADA, NUCLEO_CONTAR } TipoNucleo;
+
+// Roda o núcleo 'repeticoes' vezes; devolve o resultado da última e o tempo em 'segundos'
+double medirNucleo(const NucleosNotas *k, TipoNucleo tipo, ColunasNotas *c, long repeticoes,
+                   double *segundos) {
+    double resultado = 0.0, inicio = tempoMonotonico();
+    for (long r = 0; r < repeticoes; r++) {
+        if (tipo == NUCLEO_MEDIA)
+            resultado = k->media(c->n1, c->n2, c->media, c->tamanho);
+        else if (tipo == NUCLEO_PONDERADA)
+            resultado = k->ponderada(c->n1, c->n2, c->media, c->tamanho, 2.0f, 3.0f);
+        else
+            resultado = (double) k->contar(c->media, c->tamanho, NOTA_APROVACAO);
+    }
+    *segundos = tempoMonotonico() - inicio;
+    return resultado;
+}
+
+// Compara as versões de cada núcleo com a escalar (tempo, GB/s e resultado)
+int benchmarkSimd(long n, long repeticoes) {
+    static const char *nomes[] = { "media", "ponderada", "aprovados" };
+    static const int bytesPorAluno[] = { 12, 12, 4 };   // lidos + escritos
+    const NucleosNotas *versoes[3];
+    int nVersoes = cnNucleosDisponiveis(versoes), divergencias = 0;
+    ColunasNotas c;
+    Randomizador r;
+
+    cnInicializar(&c);
+    if (!cnReservar(&c, (size_t) n)) {
+        printf("Memória insuficiente.\n");
+        return 1;
+    }
+    randomizadorSemear(&r, 1);
+    for (long i = 0; i < n; i++)
+        cnAdicionar(&c, rndLimitado(&r, 1001) / 100.0f, rndLimitado(&r, 1001) / 100.0f);
+    if (repeticoes <= 0) repeticoes = BENCH_SIMD_ELEMENTOS / n > 0 ? BENCH_SIMD_ELEMENTOS / n : 1;
+
+    printf("=== Núcleos sobre colunas: %ld alunos (%.1f MB por coluna), %ld repetições ===\n",
+           n, n * sizeof(float) / 1e6, repeticoes);
+    printf("versão escolhida em tempo de execução: %s\n", cnNucleos()->nome);
+    printf("%-10s %-8s %10s %8s %8s %16s\n", "nucleo", "versao", "ns/aluno", "GB/s", "ganho",
+           "resultado");
+    for (int tipo = NUCLEO_MEDIA; tipo <= NUCLEO_CONTAR; tipo++) {
+        double referencia = 0.0, tempoEscalar = 0.0;
+        if (tipo == NUCLEO_CONTAR)   // conta sobre as médias (recalculadas pela versão escalar)
+            cnNucleosEscalar.media(c.n1, c.n2, c.media, c.tamanho);
+        for (int v = 0; v < nVersoes; v++) {
+            double seg, resultado = medirNucleo(versoes[v], (TipoNucleo) tipo, &c, repeticoes, &seg);
+            double porAluno = seg / ((double) n * repeticoes);
+            int confere;
+            if (v == 0) {
+                referencia = resultado;
+                tempoEscalar = seg;
+            }
+            // a soma muda de ordem e o compilador pode usar FMA na escalar: cada
+            // média em float pode diferir no último bit, daí a tolerância relativa
+            confere = tipo == NUCLEO_CONTAR ? resultado == referencia
+                                            : fabs(resultado - referencia) <= 1e-6 * fabs(referencia);
+            divergencias += !confere;
+            printf("%-10s %-8s %10.3f %8.2f %7.2fx %16.2f%s\n", nomes[tipo], versoes[v]->nome,
+                   porAluno * 1e9, bytesPorAluno[tipo] / porAluno / 1e9,
+                   seg > 0 ? tempoEscalar / seg : 0.0, resultado, confere ? "" : "  DIFERENTE");
+        }
+    }
+    cnLiberar(&c);
+    return divergencias > 0;
+}
+
+// ---------- Modo interativo ---------- //
+
+int main(int argc, char *argv[]) {
+    char nome[50] = "";
+    int idade = 0, matricula = 0;
+    char nota[32];
+    double n1 = 0.0, n2 = 0.0, media;
+
+    if (argc > 2 && strcmp(argv[1], "--csv") == 0) {
+        int porAluno = 0, threads = nucleosDisponiveis();
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "--alunos") == 0) porAluno = 1;
+            else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+                threads = atoi(argv[++i]);
+        }
+        return executarCsv(argv[2], porAluno, threads);
+    }
+    if (argc > 2 && strcmp(argv[1], "--gerar") == 0)
+        return !gerarAlunos(stdout, atol(argv[2]), argc > 3 ? strtoull(argv[3], NULL, 10) : 1);
+    if (argc > 1 && strcmp(argv[1], "--bench-simd") == 0)
+        return benchmarkSimd(argc > 2 && atol(argv[2]) > 0 ? atol(argv[2]) : 4000000,
+                             argc > 3 ? atol(argv[3]) : 0);
+    if (argc > 1 && strcmp(argv[1], "--bench-paralelo") == 0) {
+        // padrão: todos os núcleos, e pelo menos 4 threads para ver o excesso de threads
+        int maxThreads = nucleosDisponiveis() < 4 ? 4 : nucleosDisponiveis();
+        if (argc > 3 && atoi(argv[3]) > 0) maxThreads = atoi(argv[3]);
+        return benchmarkParalelo(argc > 2 && atol(argv[2]) > 0 ? atol(argv[2]) : 2000000, maxThreads);
+    }
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+        return benchmarkCsv(argc > 2 && atol(argv[2]) > 0 ? atol(argv[2]) : 1000000);
+
+    consoleIniciar();
+
+    consoleInterface("Qual o seu nome? \n");
+    consoleLerLinha(nome, sizeof(nome));
+    consoleInterface("Qual a sua idade? \n");
+    consoleLerInteiro(&idade);
+    consoleInterface("Qual a sua matricula? \n");
+    consoleLerInteiro(&matricula);
+
+    // nota inválida (fora de 0..10 ou não numérica) conta como zero
+    consoleInterface("Digite sua nota 1: \n");
+    consoleLerLinha(nota, sizeof(nota));
+    if (!converterNota(nota, nota + strlen(nota), ';', &n1)) n1 = 0.0;
+    consoleInterface("Digite sua nota 2: \n");
+    consoleLerLinha(nota, sizeof(nota));
+    if (!converterNota(nota, nota + strlen(nota), ';', &n2)) n2 = 0.0;
+
+    media = (n1 + n2) / 2.0;
+    printf("Seu nome é: %s\n", nome);
+    printf(" Sua idade é: %d\n", idade);
+    printf(" Sua matricula é: %d\n", matricula);
+    printf(" Sua média é: %.2f\n", media);
+
+    return 0;
 }
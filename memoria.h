@@ -0,0 +1,179 @@
+/*
+  memoria.h - Contabilidade de memória por subsistema (vivos, pico, alocações)
+  ---------------------------------------------------------------------------
+  malloc/calloc/realloc/free com uma "conta" por subsistema (territórios,
+  missões, nós de lista, nós da BST, entradas de hash...). Cada conta guarda:
+
+  - bytes e blocos vivos agora, e o pico de bytes vivos;
+  - quantas alocações e liberações houve e o total de bytes já pedido;
+  - o mesmo, somado, na conta "total" do programa.
+
+  Cada bloco leva um cabeçalho de 16 bytes com a conta e o tamanho, então
+  memLiberar() não precisa saber de onde o bloco veio. Blocos de memAlocar()
+  só podem ser liberados com memLiberar() (e nunca com free()).
+
+  - Relatório no fim do programa (atexit) se a variável de ambiente MEMORIA
+    estiver definida: MEMORIA=1 escreve em stderr, outro valor é o arquivo.
+    Contas com blocos vivos no fim aparecem marcadas como vazamento.
+  - memRelatorio(arquivo) pode ser chamada a qualquer momento (sessões longas).
+  - Os contadores não são atômicos: cada conta deve ser usada por uma thread de
+    cada vez (nos programas, todas as alocações contadas são da thread principal).
+
+  Uso:
+      MEM_CONTA(memTerritorios, "territorios");        // no escopo do arquivo
+      Territorio *mapa = memZerada(&memTerritorios, qtd, sizeof(Territorio));
+      ...
+      memLiberar(mapa);
+
+      MEMORIA=1 ./warmestre --lote jogo.txt
+
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef MEMORIA_H
+#define MEMORIA_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct MemConta {
+    const char *nome;
+    size_t bytesVivos, bytesPico, bytesTotal;
+    long blocosVivos, alocacoes, liberacoes, falhas;
+    struct MemConta *proxima;   /* lista das contas já usadas (para o relatório) */
+    int registrada;
+} MemConta;
+
+/* Cabeçalho antes de cada bloco; 16 bytes mantêm o alinhamento do malloc */
+typedef struct {
+    MemConta *conta;
+    size_t bytes;
+} MemCabecalho;
+
+_Static_assert(sizeof(MemCabecalho) % _Alignof(max_align_t) == 0,
+               "o cabeçalho precisa manter o alinhamento do malloc");
+
+#define MEM_CONTA(var, nomeConta) static MemConta var = { .nome = nomeConta }
+
+static MemConta memTotal = { .nome = "total" };
+static MemConta *memContas;
+
+static void memRelatorioFinal(void);
+
+static inline void memRegistrar(MemConta *c) {
+    MemConta **fim = &memContas;
+    if (c->registrada) return;
+    c->registrada = 1;
+    if (!memContas) atexit(memRelatorioFinal);
+    while (*fim) fim = &(*fim)->proxima;  /* ordem do primeiro uso */
+    *fim = c;
+}
+
+static inline void memSomar(MemConta *c, size_t bytes) {
+    c->bytesVivos += bytes;
+    c->bytesTotal += bytes;
+    c->blocosVivos++;
+    c->alocacoes++;
+    if (c->bytesVivos > c->bytesPico) c->bytesPico = c->bytesVivos;
+}
+
+static inline void memSubtrair(MemConta *c, size_t bytes) {
+    c->bytesVivos -= bytes;
+    c->blocosVivos--;
+    c->liberacoes++;
+}
+
+/* Grava o cabeçalho de um bloco recém-obtido e soma nas contas */
+static inline void *memEntregar(MemConta *c, MemCabecalho *cab, size_t bytes) {
+    if (cab == NULL) {
+        c->falhas++;
+        return NULL;
+    }
+    cab->conta = c;
+    cab->bytes = bytes;
+    memSomar(c, bytes);
+    memSomar(&memTotal, bytes);
+    return cab + 1;
+}
+
+static inline void *memAlocar(MemConta *c, size_t bytes) {
+    memRegistrar(c);
+    if (bytes > (size_t)-1 - sizeof(MemCabecalho)) return memEntregar(c, NULL, 0);
+    return memEntregar(c, (MemCabecalho *) malloc(sizeof(MemCabecalho) + bytes), bytes);
+}
+
+/* Como calloc: n elementos de 'tamanho' bytes, zerados (páginas novas do
+   sistema continuam sem ser tocadas) */
+static inline void *memZerada(MemConta *c, size_t n, size_t tamanho) {
+    memRegistrar(c);
+    if (tamanho && n > ((size_t)-1 - sizeof(MemCabecalho)) / tamanho) return memEntregar(c, NULL, 0);
+    return memEntregar(c, (MemCabecalho *) calloc(1, sizeof(MemCabecalho) + n * tamanho), n * tamanho);
+}
+
+static inline void memLiberar(void *p) {
+    MemCabecalho *cab;
+    if (!p) return;
+    cab = (MemCabecalho *) p - 1;
+    memSubtrair(cab->conta, cab->bytes);
+    memSubtrair(&memTotal, cab->bytes);
+    free(cab);
+}
+
+/* Como realloc (p == NULL aloca). Se falhar, retorna NULL e o bloco antigo
+   continua válido. Conta como uma liberação e uma alocação. */
+static inline void *memRealocar(MemConta *c, void *p, size_t bytes) {
+    MemCabecalho *cab, *novo;
+    if (!p) return memAlocar(c, bytes);
+    cab = (MemCabecalho *) p - 1;
+    if (bytes > (size_t)-1 - sizeof(MemCabecalho) ||
+        (novo = (MemCabecalho *) realloc(cab, sizeof(MemCabecalho) + bytes)) == NULL) {
+        c->falhas++;
+        return NULL;
+    }
+    memSubtrair(novo->conta, novo->bytes);
+    memSubtrair(&memTotal, novo->bytes);
+    novo->conta = c;
+    novo->bytes = bytes;
+    memSomar(c, bytes);
+    memSomar(&memTotal, bytes);
+    return novo + 1;
+}
+
+static inline void memLinhaRelatorio(FILE *saida, const MemConta *c) {
+    fprintf(saida, "%-26s %11ld %11ld %9ld %13zu %13zu %15zu%s\n", c->nome, c->alocacoes,
+            c->liberacoes, c->blocosVivos, c->bytesVivos, c->bytesPico, c->bytesTotal,
+            c->falhas ? "  (falhas de alocação)" : "");
+}
+
+/* Tabela com todas as contas usadas até agora e o total */
+static inline void memRelatorio(FILE *saida) {
+    const MemConta *c;
+    fprintf(saida, "# memoria: %-15s %11s %11s %9s %13s %13s %15s\n", "conta", "alocacoes",
+            "liberacoes", "vivos", "bytes vivos", "pico (bytes)", "total (bytes)");
+    for (c = memContas; c; c = c->proxima) memLinhaRelatorio(saida, c);
+    memLinhaRelatorio(saida, &memTotal);
+    for (c = memContas; c; c = c->proxima)
+        if (c->blocosVivos > 0)
+            fprintf(saida, "# vazamento? %s: %ld bloco(s), %zu bytes ainda vivos\n",
+                    c->nome, c->blocosVivos, c->bytesVivos);
+}
+
+static void memRelatorioFinal(void) {
+    const char *destino = getenv("MEMORIA");
+    FILE *saida;
+    if (!destino || !*destino) return;
+    if (strcmp(destino, "1") == 0) {
+        memRelatorio(stderr);
+        return;
+    }
+    if ((saida = fopen(destino, "w")) == NULL) {
+        perror(destino);
+        return;
+    }
+    memRelatorio(saida);
+    fclose(saida);
+}
+
+#endif /* MEMORIA_H */
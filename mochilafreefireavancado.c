@@ -3,29 +3,52 @@
   ----------------------------------------------------------------------------
   - Linguagem: C (ANSI/C89 compatível com clock() para medir tempo)
   - Funcionalidade:
-      * Cadastro de até 20 componentes (nome, tipo, prioridade)
-      * Três algoritmos de ordenação:
+      * Cadastro ilimitado de componentes (nome, tipo, prioridade) em vetor dinâmico
+      * Quatro algoritmos de ordenação:
           - Bubble Sort por nome (string)
           - Insertion Sort por tipo (string)
           - Selection Sort por prioridade (int)
+          - Merge Sort paralelo por nome (pthreads, com corte para Insertion Sort)
       * Busca sequencial por nome
       * Busca binária otimizada por nome (aplicável somente após ordenação por nome)
+      * Índice de Eytzinger por nome (prefixos de 8 bytes, busca sem desvios + prefetch)
       * Contagem de comparações e medição de tempo (clock)
       * Menu interativo e feedback numérico (comparações e tempo)
   - Observações:
-      * Use fgets() para entrada de strings; removemos '\n' de forma segura
+      * Entrada e menus pelo console.h: uma resposta por linha, sem scanf/fgets
       * Cada algoritmo tem sua função separada e produz comparações/tempo
+      * Modo benchmark: ./mochilafreefireavancado --bench-ordenacao [n] [--threads t]
+        gera n componentes aleatórios e mede o Merge Sort paralelo com 1, 2, 4 e 8 threads
+      * Modo benchmark: ./mochilafreefireavancado --bench-busca [nMax]
+        compara busca binária e índice de Eytzinger de 1K até nMax componentes
+        (padrão 10M; 100M precisa de uns 12 GB de memória; no máximo 1G)
+      * Modo lote: ./mochilafreefireavancado --lote arquivo executa os comandos
+        do arquivo sem menu, com saída separada por tabulação (ver lote.h)
+      * MEMORIA=1 mostra no fim o uso de memória por conta (ver memoria.h)
 */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+
+#include "vetordinamico.h"
+#include "indiceeytzinger.h"
+#include "console.h"
+#include "lote.h"
+#include "instrumentacao.h"
+#include "memoria.h"
 
-#define MAX_COMPONENTES 20
 #define TAM_NOME 30
 #define TAM_TIPO 20
 
+#define MAX_THREADS 64
+#define CORTE_INSERCAO 32          /* abaixo disso o Merge Sort usa Insertion Sort */
+#define CORTE_PARALELO 4096        /* abaixo disso não compensa criar uma thread */
+#define MAX_N_BUSCA 1000000000L    /* maior nMax de --bench-busca (os índices são int) */
+
 typedef struct {
     char nome[TAM_NOME];
     char tipo[TAM_TIPO];
@@ -41,6 +64,15 @@ void mostrarComponentes(Componente arr[], int n);
 void bubbleSortNome(Componente arr[], int n, long *comparacoes, double *tempoSegundos);
 void insertionSortTipo(Componente arr[], int n, long *comparacoes, double *tempoSegundos);
 void selectionSortPrioridade(Componente arr[], int n, long *comparacoes, double *tempoSegundos);
+void mergeSortParaleloNome(Componente arr[], int n, int numThreads, long *comparacoes, double *tempoSegundos);
+void insertionSortNome(Componente arr[], int n, long *comparacoes);
+
+/* Benchmarks */
+int benchmarkOrdenacao(int n, int maxThreads);
+int benchmarkBusca(long nMax);
+
+/* Modo lote (comandos de um arquivo) */
+int executarLote(const char *caminho, int numThreads);
 
 /* Buscas */
 int buscaSequencialPorNome(Componente arr[], int n, const char *nome, long *comparacoes);
@@ -48,43 +80,85 @@ int buscaBinariaPorNome(Componente arr[], int n, const char *nome, long *compara
 
 /* Utilitários */
 void trocarComponente(Componente *a, Componente *b);
-void limparBufferStdin();
-void removerQuebraLinha(char *s);
+double tempoMonotonico(void);
 
 /* ---------- Implementação ---------- */
 
-int main(void) {
-    Componente componentes[MAX_COMPONENTES];
-    int total = 0;
+int main(int argc, char *argv[]) {
+    VetorDinamico vetor; // componentes cadastrados (cresce conforme necessário)
+    Componente *componentes;
+    int total;
     int opcao;
     int sortedByName = 0; // flag: 1 se atualmente ordenado por nome
+    int indiceValido = 0; // flag: 1 se o índice de Eytzinger reflete o vetor atual
+    IndiceEytzinger indice;
+    int numThreads = 1;   // threads usadas pelo Merge Sort paralelo
+    int modoBench = 0;
+    int nBench = 1000000;
+    long nBusca = 10000000;
+    const char *lote = NULL;
+    int i;
+
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            numThreads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bench-ordenacao") == 0) {
+            modoBench = 1;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--bench-busca") == 0) {
+            modoBench = 2;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBusca = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            lote = argv[++i];
+        }
+    }
+    if (numThreads < 1) numThreads = 1;
+    if (numThreads > MAX_THREADS) numThreads = MAX_THREADS;
+
+    if (modoBench == 1) {
+        return benchmarkOrdenacao(nBench, numThreads > 1 ? numThreads : 8);
+    } else if (modoBench == 2) {
+        return benchmarkBusca(nBusca);
+    }
+    if (lote) return executarLote(lote, numThreads);
 
+    consoleIniciar();
+    vdInicializar(&vetor, sizeof(Componente));
+    ieInicializar(&indice);
     printf("=== Módulo Avançado: Montagem da Torre de Resgate ===\n");
 
     do {
-        printf("\nMenu Principal:\n");
-        printf("1 - Cadastrar componente (até %d)\n", MAX_COMPONENTES);
-        printf("2 - Listar componentes\n");
-        printf("3 - Ordenar (escolher algoritmo)\n");
-        printf("4 - Buscar componente (sequencial por nome)\n");
-        printf("5 - Buscar componente (binária por nome) [requer ordenacao por nome]\n");
-        printf("0 - Sair\n");
-        printf("Escolha uma opcao: ");
-        if (scanf("%d", &opcao) != 1) {
-            limparBufferStdin();
+        componentes = VD_DADOS(&vetor, Componente);
+        total = (int) vetor.tamanho;
+
+        consoleInterface("\nMenu Principal:\n");
+        consoleInterface("1 - Cadastrar componente\n");
+        consoleInterface("2 - Listar componentes\n");
+        consoleInterface("3 - Ordenar (escolher algoritmo)\n");
+        consoleInterface("4 - Buscar componente (sequencial por nome)\n");
+        consoleInterface("5 - Buscar componente (binária por nome) [requer ordenacao por nome]\n");
+        consoleInterface("6 - Configurar threads do Merge Sort paralelo (atual: %d)\n", numThreads);
+        consoleInterface("7 - Buscar componente (indice Eytzinger por nome) [requer ordenacao por nome]\n");
+        consoleInterface("0 - Sair\n");
+        consoleInterface("Escolha uma opcao: ");
+        opcao = -1;
+        int lido = consoleLerInteiro(&opcao);
+        if (lido < 0) {
+            opcao = 0; // fim da entrada: sai
+        } else if (lido == 0) {
             printf("Entrada invalida. Digite um numero.\n");
             continue;
         }
-        limparBufferStdin();
 
         if (opcao == 1) {
-            if (total >= MAX_COMPONENTES) {
-                printf("Limite de componentes atingido (%d).\n", MAX_COMPONENTES);
+            Componente novo;
+            consoleInterface("\nCadastrando componente #%d\n", total + 1);
+            lerComponente(&novo);
+            if (vdAdicionar(&vetor, &novo) == NULL) {
+                printf("Memoria insuficiente para cadastrar o componente.\n");
             } else {
-                printf("\nCadastrando componente #%d\n", total + 1);
-                lerComponente(&componentes[total]);
-                total++;
                 sortedByName = 0; // alteração na coleção torna inválida qualquer ordenacao prévia
+                indiceValido = 0;
                 printf("Componente cadastrado com sucesso.\n");
             }
         } else if (opcao == 2) {
@@ -96,22 +170,23 @@ int main(void) {
             }
 
             int choiceSort;
-            printf("\nEscolha o algoritmo de ordenacao:\n");
-            printf("1 - Bubble Sort (por NOME)\n");
-            printf("2 - Insertion Sort (por TIPO)\n");
-            printf("3 - Selection Sort (por PRIORIDADE)\n");
-            printf("0 - Voltar\n");
-            printf("Opcao: ");
-            if (scanf("%d", &choiceSort) != 1) {
-                limparBufferStdin();
+            consoleInterface("\nEscolha o algoritmo de ordenacao:\n");
+            consoleInterface("1 - Bubble Sort (por NOME)\n");
+            consoleInterface("2 - Insertion Sort (por TIPO)\n");
+            consoleInterface("3 - Selection Sort (por PRIORIDADE)\n");
+            consoleInterface("4 - Merge Sort paralelo (por NOME, %d thread(s))\n", numThreads);
+            consoleInterface("0 - Voltar\n");
+            consoleInterface("Opcao: ");
+            if (consoleLerInteiro(&choiceSort) != 1) {
                 printf("Entrada invalida.\n");
                 continue;
             }
-            limparBufferStdin();
 
             long comparacoes = 0;
             double tempo = 0.0;
 
+            if (choiceSort >= 1 && choiceSort <= 4) indiceValido = 0; // vetor foi reordenado
+
             if (choiceSort == 1) {
                 bubbleSortNome(componentes, total, &comparacoes, &tempo);
                 printf("\n[RESULTADO] Bubble Sort (por nome) concluido.\n");
@@ -130,6 +205,12 @@ int main(void) {
                 printf("Comparacoes: %ld | Tempo: %.6f segundos\n", comparacoes, tempo);
                 mostrarComponentes(componentes, total);
                 sortedByName = 0;
+            } else if (choiceSort == 4) {
+                mergeSortParaleloNome(componentes, total, numThreads, &comparacoes, &tempo);
+                printf("\n[RESULTADO] Merge Sort paralelo (por nome, %d thread(s)) concluido.\n", numThreads);
+                printf("Comparacoes: %ld | Tempo: %.6f segundos\n", comparacoes, tempo);
+                mostrarComponentes(componentes, total);
+                sortedByName = 1;
             } else if (choiceSort == 0) {
                 /* voltar */
             } else {
@@ -143,12 +224,11 @@ int main(void) {
             }
             char nomeBusca[TAM_NOME];
             long comps = 0;
-            printf("Digite o nome do componente para busca sequencial: ");
-            if (fgets(nomeBusca, sizeof(nomeBusca), stdin) == NULL) {
+            consoleInterface("Digite o nome do componente para busca sequencial: ");
+            if (consoleLerLinha(nomeBusca, sizeof(nomeBusca)) < 0) {
                 printf("Erro na leitura.\n");
                 continue;
             }
-            removerQuebraLinha(nomeBusca);
             int idx = buscaSequencialPorNome(componentes, total, nomeBusca, &comps);
             if (idx != -1) {
                 printf("\nComponente encontrado na posicao %d:\n", idx);
@@ -170,12 +250,11 @@ int main(void) {
             }
             char nomeBusca[TAM_NOME];
             long comps = 0;
-            printf("Digite o nome do componente para busca BINARIA: ");
-            if (fgets(nomeBusca, sizeof(nomeBusca), stdin) == NULL) {
+            consoleInterface("Digite o nome do componente para busca BINARIA: ");
+            if (consoleLerLinha(nomeBusca, sizeof(nomeBusca)) < 0) {
                 printf("Erro na leitura.\n");
                 continue;
             }
-            removerQuebraLinha(nomeBusca);
             int idx = buscaBinariaPorNome(componentes, total, nomeBusca, &comps);
             if (idx != -1) {
                 printf("\nComponente encontrado na posicao %d (posicao no vetor ordenado):\n", idx);
@@ -185,6 +264,53 @@ int main(void) {
             }
             printf("Comparacoes realizadas (binaria): %ld\n", comps);
 
+        } else if (opcao == 6) {
+            int t;
+            consoleInterface("Numero de threads (1 a %d): ", MAX_THREADS);
+            if (consoleLerInteiro(&t) != 1) {
+                printf("Entrada invalida.\n");
+                continue;
+            }
+            if (t < 1 || t > MAX_THREADS) {
+                printf("Valor fora do intervalo.\n");
+            } else {
+                numThreads = t;
+                printf("Merge Sort paralelo usara %d thread(s).\n", numThreads);
+            }
+
+        } else if (opcao == 7) {
+            if (total == 0) {
+                printf("Nenhum componente cadastrado.\n");
+                continue;
+            }
+            if (!sortedByName) {
+                printf("O indice de Eytzinger e montado a partir do vetor ordenado por NOME.\n");
+                printf("Ordene por NOME (Bubble Sort ou Merge Sort) antes de usar esta busca.\n");
+                continue;
+            }
+            if (!indiceValido) {
+                if (!ieConstruir(&indice, componentes, (size_t)total, sizeof(Componente), offsetof(Componente, nome))) {
+                    printf("Memoria insuficiente para montar o indice.\n");
+                    continue;
+                }
+                indiceValido = 1;
+            }
+            char nomeBusca[TAM_NOME];
+            long comps = 0;
+            consoleInterface("Digite o nome do componente para busca no indice: ");
+            if (consoleLerLinha(nomeBusca, sizeof(nomeBusca)) < 0) {
+                printf("Erro na leitura.\n");
+                continue;
+            }
+            long idx = ieBuscar(&indice, nomeBusca, &comps);
+            if (idx != -1) {
+                printf("\nComponente encontrado na posicao %ld (posicao no vetor ordenado):\n", idx);
+                printf("  Nome: %s\n  Tipo: %s\n  Prioridade: %d\n", componentes[idx].nome, componentes[idx].tipo, componentes[idx].prioridade);
+            } else {
+                printf("\nComponente NAO encontrado.\n");
+            }
+            printf("Comparacoes realizadas (indice): %ld\n", comps);
+
         } else if (opcao == 0) {
             printf("Saindo...\n");
         } else {
@@ -193,6 +319,8 @@ int main(void) {
 
     } while (opcao != 0);
 
+    ieLiberar(&indice);
+    vdLiberar(&vetor);
     return 0;
 }
 
@@ -200,29 +328,21 @@ int main(void) {
 
 /* Ler um Componente do teclado com validação da prioridade */
 void lerComponente(Componente *c) {
-    char buffer[64];
-    printf("Nome (ate %d chars): ", TAM_NOME - 1);
-    if (fgets(c->nome, sizeof(c->nome), stdin) == NULL) {
-        c->nome[0] = '\0';
-    } else {
-        removerQuebraLinha(c->nome);
-    }
+    consoleInterface("Nome (ate %d chars): ", TAM_NOME - 1);
+    consoleLerLinha(c->nome, sizeof(c->nome));
 
-    printf("Tipo (ate %d chars) [ex: controle, suporte, propulsao]: ", TAM_TIPO - 1);
-    if (fgets(c->tipo, sizeof(c->tipo), stdin) == NULL) {
-        c->tipo[0] = '\0';
-    } else {
-        removerQuebraLinha(c->tipo);
-    }
+    consoleInterface("Tipo (ate %d chars) [ex: controle, suporte, propulsao]: ", TAM_TIPO - 1);
+    consoleLerLinha(c->tipo, sizeof(c->tipo));
 
     for (;;) {
-        int pri;
-        printf("Prioridade (1 a 10): ");
-        if (fgets(buffer, sizeof(buffer), stdin) == NULL) {
-            printf("Entrada invalida. Tente novamente.\n");
-            continue;
+        int pri, lido;
+        consoleInterface("Prioridade (1 a 10): ");
+        lido = consoleLerInteiro(&pri);
+        if (lido < 0) {
+            c->prioridade = 1; // fim da entrada: não há como perguntar de novo
+            break;
         }
-        if (sscanf(buffer, "%d", &pri) != 1) {
+        if (lido == 0) {
             printf("Formato invalido. Digite um numero inteiro.\n");
             continue;
         }
@@ -329,6 +449,346 @@ void selectionSortPrioridade(Componente arr[], int n, long *comparacoes, double
     *tempoSegundos = ((double)(fim - inicio)) / CLOCKS_PER_SEC;
 }
 
+/* ---------- Merge Sort paralelo por nome ---------- */
+
+MEM_CONTA(memOrdenacao, "ordenacao (temporarios)");
+
+/* Insertion Sort por nome: usado como caso base do Merge Sort (trechos pequenos).
+   Soma as comparações em *comparacoes (não zera o contador).
+*/
+void insertionSortNome(Componente arr[], int n, long *comparacoes) {
+    int i, j;
+    long comps = 0;
+    for (i = 1; i < n; ++i) {
+        Componente chave = arr[i];
+        j = i - 1;
+        while (j >= 0) {
+            comps++;
+            if (strcmp(arr[j].nome, chave.nome) > 0) {
+                arr[j+1] = arr[j];
+                j--;
+            } else {
+                break;
+            }
+        }
+        arr[j+1] = chave;
+    }
+    *comparacoes += comps;
+}
+
+/* Tarefa de ordenação/mescla executada por uma thread.
+   Cada tarefa tem seu próprio contador de comparações; o pai soma após o join,
+   de forma que as threads nunca disputam o mesmo contador.
+*/
+typedef struct {
+    Componente *a, *b;       /* ordenar: buffer principal e auxiliar */
+    int n;
+    int destino;             /* 0: resultado em a, 1: resultado em b */
+    const Componente *x, *y; /* mesclar: duas sequências ordenadas */
+    int nx, ny;
+    Componente *saida;
+    int threads;             /* orçamento de threads desta tarefa */
+    long comparacoes;
+} TarefaOrdenacao;
+
+static void ordenarTarefa(TarefaOrdenacao *t);
+static void mesclarTarefa(TarefaOrdenacao *t);
+
+static void *executarOrdenacao(void *arg) {
+    ordenarTarefa((TarefaOrdenacao *) arg);
+    return NULL;
+}
+
+static void *executarMescla(void *arg) {
+    mesclarTarefa((TarefaOrdenacao *) arg);
+    return NULL;
+}
+
+/* Executa 'esq' em uma nova thread e 'dir' na thread atual.
+   Se a criação da thread falhar, executa as duas em sequência.
+*/
+static void executarEmParalelo(void *(*func)(void *), TarefaOrdenacao *esq, TarefaOrdenacao *dir) {
+    pthread_t th;
+    if (pthread_create(&th, NULL, func, esq) == 0) {
+        func(dir);
+        pthread_join(th, NULL);
+    } else {
+        func(esq);
+        func(dir);
+    }
+}
+
+/* Primeira posição de v[0..n) cujo nome é >= chave (inclusivo=0) ou > chave (inclusivo=1). */
+static int posicaoPorNome(const Componente v[], int n, const char *chave, int inclusivo, long *comps) {
+    int ini = 0, fim = n;
+    while (ini < fim) {
+        int meio = ini + (fim - ini) / 2;
+        int cmp = strcmp(v[meio].nome, chave);
+        (*comps)++;
+        if (cmp < 0 || (inclusivo && cmp == 0)) ini = meio + 1;
+        else fim = meio;
+    }
+    return ini;
+}
+
+/* Mescla estável x e y em saida. Com orçamento de threads, divide o problema pelo
+   elemento do meio da maior sequência (busca binária na outra) e mescla as duas
+   metades em paralelo.
+*/
+static void mesclarTarefa(TarefaOrdenacao *t) {
+    long comps = 0;
+
+    if (t->threads > 1 && t->nx + t->ny >= CORTE_PARALELO) {
+        TarefaOrdenacao esq = *t, dir = *t;
+        int mx, my;
+        if (t->nx >= t->ny) {
+            mx = t->nx / 2;
+            my = posicaoPorNome(t->y, t->ny, t->x[mx].nome, 0, &comps);
+        } else {
+            my = t->ny / 2;
+            mx = posicaoPorNome(t->x, t->nx, t->y[my].nome, 1, &comps);
+        }
+        esq.nx = mx; esq.ny = my;
+        esq.threads = t->threads / 2;
+        esq.comparacoes = 0;
+        dir.x = t->x + mx; dir.nx = t->nx - mx;
+        dir.y = t->y + my; dir.ny = t->ny - my;
+        dir.saida = t->saida + mx + my;
+        dir.threads = t->threads - esq.threads;
+        dir.comparacoes = 0;
+        executarEmParalelo(executarMescla, &esq, &dir);
+        t->comparacoes += comps + esq.comparacoes + dir.comparacoes;
+        return;
+    }
+
+    {
+        int i = 0, j = 0, k = 0;
+        while (i < t->nx && j < t->ny) {
+            comps++;
+            if (strcmp(t->y[j].nome, t->x[i].nome) < 0) t->saida[k++] = t->y[j++];
+            else t->saida[k++] = t->x[i++];
+        }
+        if (i < t->nx) memcpy(t->saida + k, t->x + i, (size_t)(t->nx - i) * sizeof(Componente));
+        if (j < t->ny) memcpy(t->saida + k, t->y + j, (size_t)(t->ny - j) * sizeof(Componente));
+    }
+    t->comparacoes += comps;
+}
+
+/* Ordena a[0..n) deixando o resultado em a (destino 0) ou em b (destino 1).
+   As metades são ordenadas para o buffer oposto e mescladas no destino,
+   alternando os buffers a cada nível para evitar cópias de volta.
+*/
+static void ordenarTarefa(TarefaOrdenacao *t) {
+    INSTR_CONTAR("mergeSort.tarefas");
+    if (t->n <= CORTE_INSERCAO) {
+        insertionSortNome(t->a, t->n, &t->comparacoes);
+        if (t->destino) memcpy(t->b, t->a, (size_t)t->n * sizeof(Componente));
+        return;
+    }
+
+    int meio = t->n / 2;
+    TarefaOrdenacao esq = *t, dir = *t;
+    esq.n = meio;
+    esq.destino = !t->destino;
+    esq.comparacoes = 0;
+    dir.a = t->a + meio;
+    dir.b = t->b + meio;
+    dir.n = t->n - meio;
+    dir.destino = !t->destino;
+    dir.comparacoes = 0;
+
+    if (t->threads > 1 && t->n >= CORTE_PARALELO) {
+        esq.threads = t->threads / 2;
+        dir.threads = t->threads - esq.threads;
+        executarEmParalelo(executarOrdenacao, &esq, &dir);
+    } else {
+        esq.threads = dir.threads = 1;
+        ordenarTarefa(&esq);
+        ordenarTarefa(&dir);
+    }
+
+    TarefaOrdenacao mescla = *t;
+    const Componente *origem = t->destino ? t->a : t->b;
+    mescla.x = origem;
+    mescla.nx = meio;
+    mescla.y = origem + meio;
+    mescla.ny = t->n - meio;
+    mescla.saida = t->destino ? t->b : t->a;
+    mescla.comparacoes = 0;
+    mesclarTarefa(&mescla);
+
+    t->comparacoes += esq.comparacoes + dir.comparacoes + mescla.comparacoes;
+}
+
+/* Merge Sort paralelo por nome (estável).
+   Divide o vetor recursivamente entre até numThreads threads; trechos com até
+   CORTE_INSERCAO elementos são ordenados com Insertion Sort. O tempo é medido
+   com relógio monotônico (clock() somaria o tempo de CPU de todas as threads).
+*/
+void mergeSortParaleloNome(Componente arr[], int n, int numThreads, long *comparacoes, double *tempoSegundos) {
+    INSTR_CRONOMETRAR("mergeSortParaleloNome");
+    *comparacoes = 0;
+    *tempoSegundos = 0.0;
+    if (n < 2) return;
+
+    Componente *aux = (Componente *) memAlocar(&memOrdenacao, (size_t)n * sizeof(Componente));
+    if (aux == NULL) {
+        printf("Erro de alocacao no Merge Sort; usando Insertion Sort.\n");
+        double ini = tempoMonotonico();
+        insertionSortNome(arr, n, comparacoes);
+        *tempoSegundos = tempoMonotonico() - ini;
+        return;
+    }
+
+    TarefaOrdenacao raiz;
+    memset(&raiz, 0, sizeof(raiz));
+    raiz.a = arr;
+    raiz.b = aux;
+    raiz.n = n;
+    raiz.destino = 0;
+    raiz.threads = numThreads < 1 ? 1 : numThreads;
+
+    double inicio = tempoMonotonico();
+    ordenarTarefa(&raiz);
+    *tempoSegundos = tempoMonotonico() - inicio;
+    *comparacoes = raiz.comparacoes;
+
+    memLiberar(aux);
+}
+
+/* Preenche arr[0..n) com componentes de nomes aleatórios (12 letras minúsculas). */
+static void gerarComponentesAleatorios(Componente arr[], int n) {
+    static const char *tipos[] = {"controle", "suporte", "propulsao"};
+    int i, k;
+    for (i = 0; i < n; ++i) {
+        for (k = 0; k < 12; ++k) arr[i].nome[k] = (char)('a' + rand() % 26);
+        arr[i].nome[12] = '\0';
+        strcpy(arr[i].tipo, tipos[rand() % 3]);
+        arr[i].prioridade = 1 + rand() % 10;
+    }
+}
+
+/* Gera n componentes aleatórios e mede o Merge Sort paralelo com 1, 2, 4, 8...
+   threads (até maxThreads), sempre sobre a mesma entrada.
+*/
+int benchmarkOrdenacao(int n, int maxThreads) {
+    Componente *original, *trabalho;
+    double tempoBase = 0.0;
+    int i, t;
+
+    if (n < 1) n = 1;
+    original = (Componente *) malloc((size_t)n * sizeof(Componente));
+    trabalho = (Componente *) malloc((size_t)n * sizeof(Componente));
+    if (original == NULL || trabalho == NULL) {
+        printf("Erro de alocacao para %d componentes.\n", n);
+        free(original);
+        free(trabalho);
+        return 1;
+    }
+
+    srand(12345);
+    gerarComponentesAleatorios(original, n);
+
+    printf("=== Benchmark: Merge Sort paralelo por nome (%d componentes) ===\n", n);
+    printf("%8s | %12s | %8s | %14s\n", "threads", "tempo (s)", "speedup", "comparacoes");
+
+    for (t = 1; t <= maxThreads; t *= 2) {
+        long comps;
+        double tempo;
+        int ok = 1;
+
+        memcpy(trabalho, original, (size_t)n * sizeof(Componente));
+        mergeSortParaleloNome(trabalho, n, t, &comps, &tempo);
+        for (i = 1; i < n; ++i) {
+            if (strcmp(trabalho[i-1].nome, trabalho[i].nome) > 0) { ok = 0; break; }
+        }
+        if (t == 1) tempoBase = tempo;
+        printf("%8d | %12.6f | %7.2fx | %14ld%s\n", t, tempo,
+               tempo > 0.0 ? tempoBase / tempo : 0.0, comps, ok ? "" : "  [ERRO: fora de ordem]");
+    }
+
+    free(original);
+    free(trabalho);
+    return 0;
+}
+
+/* Compara busca binária e índice de Eytzinger para n = 1K, 10K, ... até nMax.
+   Cada tamanho faz o mesmo conjunto de consultas (nomes existentes sorteados)
+   nas duas estruturas e mostra comparações médias e ns por consulta.
+*/
+int benchmarkBusca(long nMax) {
+    const int consultas = 1000000;
+    char (*chaves)[TAM_NOME];
+    long n;
+
+    if (nMax < 1000) nMax = 1000;
+    if (nMax > MAX_N_BUSCA) nMax = MAX_N_BUSCA;
+
+    chaves = malloc((size_t)consultas * sizeof(*chaves));
+    if (chaves == NULL) {
+        printf("Erro de alocacao.\n");
+        return 1;
+    }
+
+    printf("=== Benchmark: busca por nome (%d consultas por tamanho) ===\n", consultas);
+    printf("%11s | %10s %9s | %10s %9s | %7s\n",
+           "n", "binaria ns", "comps", "eytz. ns", "comps", "ganho");
+
+    srand(4242);
+    for (n = 1000; n <= nMax; n *= 10) {
+        Componente *arr = (Componente *) malloc((size_t)n * sizeof(Componente));
+        IndiceEytzinger idx;
+        long comps, totalBin = 0, totalEytz = 0, achados = 0;
+        double t0, tBin, tEytz;
+        int q;
+
+        if (arr == NULL) {
+            printf("%11ld | memoria insuficiente\n", n);
+            break;
+        }
+        gerarComponentesAleatorios(arr, (int)n);
+        mergeSortParaleloNome(arr, (int)n, 1, &comps, &t0);
+
+        ieInicializar(&idx);
+        if (!ieConstruir(&idx, arr, (size_t)n, sizeof(Componente), offsetof(Componente, nome))) {
+            printf("%11ld | memoria insuficiente para o indice\n", n);
+            free(arr);
+            break;
+        }
+
+        for (q = 0; q < consultas; ++q) {
+            int alvo = (int)(((unsigned long)rand() * (RAND_MAX + 1UL) + (unsigned long)rand()) % (unsigned long)n);
+            memcpy(chaves[q], arr[alvo].nome, TAM_NOME);
+        }
+
+        t0 = tempoMonotonico();
+        for (q = 0; q < consultas; ++q) {
+            achados += buscaBinariaPorNome(arr, (int)n, chaves[q], &comps) >= 0;
+            totalBin += comps;
+        }
+        tBin = tempoMonotonico() - t0;
+
+        t0 = tempoMonotonico();
+        for (q = 0; q < consultas; ++q) {
+            achados += ieBuscar(&idx, chaves[q], &totalEytz) >= 0;
+        }
+        tEytz = tempoMonotonico() - t0;
+
+        printf("%11ld | %10.1f %9.2f | %10.1f %9.2f | %6.2fx%s\n", n,
+               tBin * 1e9 / consultas, (double)totalBin / consultas,
+               tEytz * 1e9 / consultas, (double)totalEytz / consultas,
+               tEytz > 0.0 ? tBin / tEytz : 0.0,
+               achados == 2L * consultas ? "" : "  [ERRO: consulta nao encontrada]");
+
+        ieLiberar(&idx);
+        free(arr);
+        if (n > nMax / 10) break;
+    }
+
+    free(chaves);
+    return 0;
+}
+
 /* ---------- Buscas ---------- */
 
 /* Busca sequencial por nome.
@@ -336,6 +796,7 @@ void selectionSortPrioridade(Componente arr[], int n, long *comparacoes, double
    Retorna índice se encontrado, ou -1 se não encontrado.
 */
 int buscaSequencialPorNome(Componente arr[], int n, const char *nome, long *comparacoes) {
+    INSTR_CRONOMETRAR("buscaSequencialPorNome");
     int i;
     *comparacoes = 0;
     for (i = 0; i < n; ++i) {
@@ -350,6 +811,7 @@ int buscaSequencialPorNome(Componente arr[], int n, const char *nome, long *comp
    Retorna índice se encontrado, ou -1.
 */
 int buscaBinariaPorNome(Componente arr[], int n, const char *nome, long *comparacoes) {
+    INSTR_CRONOMETRAR("buscaBinariaPorNome");
     int inicio = 0;
     int fim = n - 1;
     *comparacoes = 0;
@@ -364,6 +826,114 @@ int buscaBinariaPorNome(Componente arr[], int n, const char *nome, long *compara
     return -1;
 }
 
+/* ---------- Modo lote ---------- */
+/*
+   ./mochilafreefireavancado --lote arquivo [--threads t] (ou - para a entrada
+   padrão). Mesmas regras do menu; saída no formato de lote.h:
+       cadastrar <nome> <tipo> <prioridade 1..10>  -> ok cadastrar <total>
+       ordenar bubble|insertion|selection|merge    -> ok ordenar <algoritmo> <comparacoes> <segundos>
+       buscar <nome>           (sequencial)        -> ok buscar <posicao> <nome> <tipo> <prioridade> <comparacoes>
+       buscar-binaria <nome>   (requer ordem por nome)  | nao buscar <nome> <comparacoes>
+       buscar-indice <nome>    (requer ordem por nome)
+       threads <t>                                 -> ok threads <t>
+       listar                                      -> ok listar <n>, depois "item <i> <nome> <tipo> <prioridade>"
+   Busca ordenada sem ordenação por nome é recusada com "nao <comando> <nome> fora-de-ordem".
+*/
+static void relatarBuscaLote(const char *comando, const char *nome, const Componente *arr, long idx, long comps) {
+    if (idx != -1)
+        printf("ok\t%s\t%ld\t%s\t%s\t%d\t%ld\n", comando, idx, arr[idx].nome, arr[idx].tipo, arr[idx].prioridade, comps);
+    else
+        printf("nao\t%s\t%s\t%ld\n", comando, nome, comps);
+}
+
+int executarLote(const char *caminho, int numThreads) {
+    static const char *ALGORITMOS[] = {"bubble", "insertion", "selection", "merge"};
+    VetorDinamico vetor;
+    IndiceEytzinger indice;
+    int sortedByName = 0, indiceValido = 0;
+    Lote lote;
+
+    if (!loteAbrir(&lote, caminho)) return 1;
+    vdInicializar(&vetor, sizeof(Componente));
+    ieInicializar(&indice);
+
+    while (loteProximo(&lote)) {
+        Componente *componentes = VD_DADOS(&vetor, Componente);
+        int total = (int) vetor.tamanho;
+        const char *comando = loteCampo(&lote, 0), *nome = loteCampo(&lote, 1);
+        long valor, comps = 0;
+
+        if (loteComando(&lote, "cadastrar", 3)) {
+            Componente novo;
+            if (!loteInteiro(&lote, 3, &valor) || valor < 1 || valor > 10) {
+                loteErro(&lote, "prioridade fora de 1..10: %s", loteCampo(&lote, 3));
+                continue;
+            }
+            snprintf(novo.nome, sizeof(novo.nome), "%s", nome);
+            snprintf(novo.tipo, sizeof(novo.tipo), "%s", loteCampo(&lote, 2));
+            novo.prioridade = (int) valor;
+            if (vdAdicionar(&vetor, &novo) == NULL) {
+                loteErro(&lote, "memoria insuficiente");
+                break;
+            }
+            sortedByName = 0;
+            indiceValido = 0;
+            printf("ok\tcadastrar\t%zu\n", vetor.tamanho);
+        } else if (loteComando(&lote, "ordenar", 1)) {
+            double tempo = 0.0;
+            int a;
+            for (a = 0; a < 4; a++)
+                if (strcmp(nome, ALGORITMOS[a]) == 0) break;
+            if (a == 4) {
+                loteErro(&lote, "algoritmo desconhecido: %s", nome);
+                continue;
+            }
+            if (a == 0) bubbleSortNome(componentes, total, &comps, &tempo);
+            else if (a == 1) insertionSortTipo(componentes, total, &comps, &tempo);
+            else if (a == 2) selectionSortPrioridade(componentes, total, &comps, &tempo);
+            else mergeSortParaleloNome(componentes, total, numThreads, &comps, &tempo);
+            sortedByName = a == 0 || a == 3;
+            indiceValido = 0;
+            printf("ok\tordenar\t%s\t%ld\t%.6f\n", ALGORITMOS[a], comps, tempo);
+        } else if (loteComando(&lote, "buscar", 1)) {
+            long idx = buscaSequencialPorNome(componentes, total, nome, &comps);
+            relatarBuscaLote(comando, nome, componentes, idx, comps);
+        } else if ((loteComando(&lote, "buscar-binaria", 1) || loteComando(&lote, "buscar-indice", 1)) && !sortedByName) {
+            printf("nao\t%s\t%s\tfora-de-ordem\n", comando, nome);
+        } else if (loteComando(&lote, "buscar-binaria", 1)) {
+            long idx = buscaBinariaPorNome(componentes, total, nome, &comps);
+            relatarBuscaLote(comando, nome, componentes, idx, comps);
+        } else if (loteComando(&lote, "buscar-indice", 1)) {
+            if (!indiceValido) {
+                if (!ieConstruir(&indice, componentes, (size_t)total, sizeof(Componente), offsetof(Componente, nome))) {
+                    loteErro(&lote, "memoria insuficiente para o indice");
+                    break;
+                }
+                indiceValido = 1;
+            }
+            long idx = ieBuscar(&indice, nome, &comps);
+            relatarBuscaLote(comando, nome, componentes, idx, comps);
+        } else if (loteComando(&lote, "threads", 1)) {
+            if (!loteInteiro(&lote, 1, &valor) || valor < 1 || valor > MAX_THREADS) {
+                loteErro(&lote, "threads fora de 1..%d: %s", MAX_THREADS, nome);
+                continue;
+            }
+            numThreads = (int) valor;
+            printf("ok\tthreads\t%d\n", numThreads);
+        } else if (loteComando(&lote, "listar", 0)) {
+            printf("ok\tlistar\t%d\n", total);
+            for (int i = 0; i < total; i++)
+                printf("item\t%d\t%s\t%s\t%d\n", i, componentes[i].nome, componentes[i].tipo, componentes[i].prioridade);
+        } else {
+            loteErro(&lote, "comando desconhecido ou incompleto: %s", comando);
+        }
+    }
+
+    ieLiberar(&indice);
+    vdLiberar(&vetor);
+    return loteFechar(&lote);
+}
+
 /* ---------- Utilitários ---------- */
 
 void trocarComponente(Componente *a, Componente *b) {
@@ -372,17 +942,9 @@ void trocarComponente(Componente *a, Componente *b) {
     *b = tmp;
 }
 
-/* Limpa o buffer stdin até '\n' ou EOF */
-void limparBufferStdin() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF) { /* esvazia */ }
+/* Tempo de relógio monotônico em segundos (válido com várias threads) */
+double tempoMonotonico(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
 }
-
-/* Remove a quebra de linha final de uma string obtida via fgets */
-void removerQuebraLinha(char *s) {
-    size_t len;
-    if (s == NULL) return;
-    len = strlen(s);
-    if (len == 0) return;
-    if (s[len - 1] == '\n') s[len - 1] = '\0';
-}
\ No newline at end of file
@@ -1,9 +1,16 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include <time.h>
 
-#define MAX_ITENS 10
+#include "vetordinamico.h"
+#include "indiceeytzinger.h"
+#include "console.h"
+#include "lote.h"
+#include "instrumentacao.h"
+#include "memoria.h"
 
 // ===============================
 // ESTRUTURAS DE DADOS
@@ -17,100 +24,292 @@ typedef struct {
 
 typedef struct No {
     Item dados;
+    struct No *anterior;  // permite remover o nó em O(1) a partir do índice
     struct No *proximo;
 } No;
 
+// Índice hash nome -> posição (vetor) ou nó (lista).
+// Endereçamento aberto com sondagem linear e capacidade potência de 2.
+// A chave (nome) não é copiada: fica só no armazenamento dos itens.
+typedef struct {
+    uint32_t hash;   // 0 = posição livre
+    size_t valor;    // posição no vetor ou endereço do nó
+} EntradaHash;
+
+typedef struct {
+    EntradaHash *entradas;
+    size_t capacidade;
+    size_t ocupadas;
+} IndiceHash;
+
+// Devolve o nome do item referenciado por 'valor'
+typedef const char *(*NomeDoValor)(const void *contexto, size_t valor);
+
+// Enquanto o vetor tiver até este número de itens, a inserção mantém a ordem
+// por nome (busca binária + deslocamento). Acima disso deslocar a cada inserção
+// custaria O(n) por item; o item vai para o final e a ordenação adaptativa
+// junta a cauda desordenada ao resto quando uma busca ordenada for pedida.
+#define LIMITE_INSERCAO_ORDENADA 4096
+
+typedef struct {
+    VetorDinamico itens;
+    IndiceHash indice;
+    int ordenado;   // 1 se os itens estão em ordem alfabética de nome
+} MochilaVetor;
+
+// Pool de nós: aloca os nós em blocos contíguos e recicla os nós liberados
+// por uma lista de livres (encadeada pelo próprio campo 'proximo')
+#define NOS_POR_BLOCO 1024
+
+typedef struct BlocoNos {
+    struct BlocoNos *proximo;
+    No nos[NOS_POR_BLOCO];
+} BlocoNos;
+
+typedef struct {
+    BlocoNos *blocos;     // blocos já alocados (o primeiro é o mais novo)
+    size_t usadosNoBloco; // nós ainda nunca entregues do bloco mais novo
+    No *livres;           // nós devolvidos, prontos para reuso
+    size_t emUso;
+    size_t totalBlocos;
+} PoolNos;
+
+typedef struct {
+    No *inicio;
+    IndiceHash indice;
+    PoolNos pool;
+} MochilaLista;
+
+// Lista desenrolada: cada nó guarda vários itens contíguos, de modo que
+// percorrer a lista segue um ponteiro a cada ITENS_POR_NO itens
+#define ITENS_POR_NO 8
+
+typedef struct NoDesenrolado {
+    int qtd;
+    struct NoDesenrolado *proximo;
+    Item itens[ITENS_POR_NO];
+} NoDesenrolado;
+
+typedef struct {
+    NoDesenrolado *inicio;
+    size_t total;
+} ListaDesenrolada;
+
+// Contas de memória por estrutura (memoria.h; MEMORIA=1 mostra o uso no fim)
+MEM_CONTA(memNosMalloc, "nos (malloc por no)");
+MEM_CONTA(memNosPool, "nos (blocos do pool)");
+MEM_CONTA(memNosDesenrolados, "nos desenrolados");
+MEM_CONTA(memIndiceHash, "indice hash");
+MEM_CONTA(memOrdenacao, "ordenacao (temporarios)");
+
 // ===============================
 // PROTÓTIPOS - VERSÃO VETOR
 // ===============================
-void inserirItemVetor(Item mochila[], int *total);
-void removerItemVetor(Item mochila[], int *total);
+void inicializarMochilaVetor(MochilaVetor *m);
+int adicionarItemVetor(MochilaVetor *m, const Item *item, long *comparacoes);
+int removerPorNomeVetor(MochilaVetor *m, const char *nome, int *comparacoes);
+int buscarHashVetor(MochilaVetor *m, const char *nome, int *comparacoes);
+void reconstruirIndiceVetor(MochilaVetor *m);
+int garantirOrdenacaoVetor(MochilaVetor *m, long *comparacoes);
+void liberarMochilaVetor(MochilaVetor *m);
+
+void inserirItemVetor(MochilaVetor *m);
+void removerItemVetor(MochilaVetor *m);
 void listarItensVetor(Item mochila[], int total);
 int buscarSequencialVetor(Item mochila[], int total, char nome[], int *comparacoes);
-void ordenarVetor(Item mochila[], int total);
+void ordenarVetor(Item mochila[], int total, long *comparacoes);
 int buscarBinariaVetor(Item mochila[], int total, char nome[], int *comparacoes);
 
 // ===============================
 // PROTÓTIPOS - VERSÃO LISTA
 // ===============================
-No* inserirItemLista(No *inicio);
-No* removerItemLista(No *inicio, char nome[]);
+void inicializarMochilaLista(MochilaLista *m);
+No* adicionarItemLista(MochilaLista *m, const Item *item);
+int removerPorNomeLista(MochilaLista *m, const char *nome, int *comparacoes);
+No* buscarHashLista(MochilaLista *m, const char *nome, int *comparacoes);
+
+void inserirItemLista(MochilaLista *m);
+void removerItemLista(MochilaLista *m, char nome[]);
 void listarItensLista(No *inicio);
 No* buscarSequencialLista(No *inicio, char nome[], int *comparacoes);
-void liberarLista(No *inicio);
+void ordenarLista(MochilaLista *m, long *comparacoes);
+No* buscarOrdenadaLista(No *inicio, const char *nome, int *comparacoes);
+void liberarLista(MochilaLista *m);
+
+// ===============================
+// PROTÓTIPOS - POOL DE NÓS
+// ===============================
+void poolInicializar(PoolNos *pool);
+No* poolAlocar(PoolNos *pool);
+void poolDevolver(PoolNos *pool, No *no);
+void poolLiberar(PoolNos *pool);
+
+// ===============================
+// PROTÓTIPOS - LISTA DESENROLADA
+// ===============================
+void inicializarListaDesenrolada(ListaDesenrolada *l);
+int adicionarItemDesenrolada(ListaDesenrolada *l, const Item *item);
+int removerPorNomeDesenrolada(ListaDesenrolada *l, const char *nome, int *comparacoes);
+Item* buscarSequencialDesenrolada(ListaDesenrolada *l, const char *nome, int *comparacoes);
+void listarItensDesenrolada(ListaDesenrolada *l);
+void liberarListaDesenrolada(ListaDesenrolada *l);
 
 // ===============================
-// FUNÇÃO AUXILIAR
+// PROTÓTIPOS - BENCHMARK
 // ===============================
-void limparBuffer();
+int benchmarkListas(long n);
+int benchmarkComparativo(long tamanhos[], int qtdTamanhos);
+
+// ===============================
+// PROTÓTIPOS - MODO LOTE
+// ===============================
+int executarLote(const char *caminho);
+
+// ===============================
+// PROTÓTIPOS - ÍNDICE HASH
+// ===============================
+uint32_t hashNome(const char *nome);
+void ihInicializar(IndiceHash *ih);
+int ihInserir(IndiceHash *ih, const char *nome, size_t valor);
+EntradaHash* ihBuscar(IndiceHash *ih, const char *nome, NomeDoValor nomeDe, const void *contexto, int *comparacoes);
+EntradaHash* ihLocalizarValor(IndiceHash *ih, const char *nome, size_t valor);
+void ihDeslocarValores(IndiceHash *ih, size_t inicio, size_t fim);
+void ihRemoverEntrada(IndiceHash *ih, EntradaHash *entrada);
+void ihLimpar(IndiceHash *ih);
+void ihLiberar(IndiceHash *ih);
+
+// ===============================
+// FUNÇÕES AUXILIARES
+// ===============================
+void lerItem(Item *novo);
+void lerNome(const char *mensagem, char nome[], int tamanho);
 
 // ===============================
 // PROGRAMA PRINCIPAL
 // ===============================
-int main() {
-    Item mochilaVetor[MAX_ITENS];
-    int totalItens = 0;
-    No *inicio = NULL;
+int main(int argc, char *argv[]) {
+    MochilaVetor mochilaVetor;
+    MochilaLista mochilaLista;
+    ListaDesenrolada mochilaDesenrolada;
     int opcaoPrincipal;
 
+    // Benchmark das listas: ./mochilafreefireaventureiro --bench-lista [n]
+    if (argc > 1 && strcmp(argv[1], "--bench-lista") == 0)
+        return benchmarkListas(argc > 2 ? atol(argv[2]) : 1000000L);
+
+    // Vetor x lista com a mesma carga: ./mochilafreefireaventureiro --bench [n1 n2 ...]
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        long tamanhos[16] = {1000, 10000};
+        int qtd = 0;
+        for (int i = 2; i < argc && qtd < 16; i++)
+            tamanhos[qtd++] = atol(argv[i]);
+        return benchmarkComparativo(tamanhos, qtd > 0 ? qtd : 2);
+    }
+
+    // Comandos de um arquivo: ./mochilafreefireaventureiro --lote arquivo
+    if (argc > 2 && strcmp(argv[1], "--lote") == 0)
+        return executarLote(argv[2]);
+
+    consoleIniciar();
+    inicializarMochilaVetor(&mochilaVetor);
+    inicializarMochilaLista(&mochilaLista);
+    inicializarListaDesenrolada(&mochilaDesenrolada);
+
     do {
-        printf("\n=====================================\n");
-        printf("     SISTEMA DE MOCHILA DO JOGADOR\n");
-        printf("=====================================\n");
-        printf("1 - Usar versao com Vetor\n");
-        printf("2 - Usar versao com Lista Encadeada\n");
-        printf("0 - Sair\n");
-        printf("Escolha: ");
-        scanf("%d", &opcaoPrincipal);
-        limparBuffer();
+        consoleInterface("\n=====================================\n");
+        consoleInterface("     SISTEMA DE MOCHILA DO JOGADOR\n");
+        consoleInterface("=====================================\n");
+        consoleInterface("1 - Usar versao com Vetor\n");
+        consoleInterface("2 - Usar versao com Lista Encadeada\n");
+        consoleInterface("3 - Usar versao com Lista Desenrolada\n");
+        consoleInterface("0 - Sair\n");
+        consoleInterface("Escolha: ");
+        opcaoPrincipal = -1;
+        if (consoleLerInteiro(&opcaoPrincipal) < 0) opcaoPrincipal = 0; // fim da entrada: sai
 
         switch (opcaoPrincipal) {
             case 1: {
                 int opcaoVetor;
                 do {
-                    printf("\n=== MOCHILA (VETOR) ===\n");
-                    printf("1 - Inserir item\n");
-                    printf("2 - Remover item\n");
-                    printf("3 - Listar itens\n");
-                    printf("4 - Buscar (sequencial)\n");
-                    printf("5 - Ordenar e buscar (binaria)\n");
-                    printf("0 - Voltar\n");
-                    printf("Escolha: ");
-                    scanf("%d", &opcaoVetor);
-                    limparBuffer();
-
-                    if (opcaoVetor == 1) inserirItemVetor(mochilaVetor, &totalItens);
-                    else if (opcaoVetor == 2) removerItemVetor(mochilaVetor, &totalItens);
-                    else if (opcaoVetor == 3) listarItensVetor(mochilaVetor, totalItens);
+                    consoleInterface("\n=== MOCHILA (VETOR) ===\n");
+                    consoleInterface("1 - Inserir item\n");
+                    consoleInterface("2 - Remover item\n");
+                    consoleInterface("3 - Listar itens\n");
+                    consoleInterface("4 - Buscar (sequencial)\n");
+                    consoleInterface("5 - Ordenar e buscar (binaria)\n");
+                    consoleInterface("6 - Ordenar e buscar (indice Eytzinger)\n");
+                    consoleInterface("7 - Buscar (indice hash)\n");
+                    consoleInterface("0 - Voltar\n");
+                    consoleInterface("Escolha: ");
+                    opcaoVetor = -1;
+                    if (consoleLerInteiro(&opcaoVetor) < 0) opcaoVetor = 0; // fim da entrada: volta
+
+                    Item *itens = VD_DADOS(&mochilaVetor.itens, Item);
+                    int totalItens = (int) mochilaVetor.itens.tamanho;
+
+                    if (opcaoVetor == 1) inserirItemVetor(&mochilaVetor);
+                    else if (opcaoVetor == 2) removerItemVetor(&mochilaVetor);
+                    else if (opcaoVetor == 3) listarItensVetor(itens, totalItens);
                     else if (opcaoVetor == 4) {
                         char nome[30];
                         int comp = 0;
-                        printf("Digite o nome do item: ");
-                        fgets(nome, sizeof(nome), stdin);
-                        nome[strcspn(nome, "\n")] = '\0';
-                        int pos = buscarSequencialVetor(mochilaVetor, totalItens, nome, &comp);
+                        lerNome("Digite o nome do item: ", nome, sizeof(nome));
+                        int pos = buscarSequencialVetor(itens, totalItens, nome, &comp);
                         if (pos != -1)
                             printf("\nItem encontrado: %s | Tipo: %s | Qtd: %d\n",
-                                   mochilaVetor[pos].nome, mochilaVetor[pos].tipo, mochilaVetor[pos].quantidade);
+                                   itens[pos].nome, itens[pos].tipo, itens[pos].quantidade);
                         else
                             printf("\nItem nao encontrado!\n");
                         printf("Comparacoes: %d\n", comp);
                     } else if (opcaoVetor == 5) {
                         char nome[30];
                         int comp = 0;
-                        ordenarVetor(mochilaVetor, totalItens);
-                        printf("\nItens ordenados!\n");
-                        listarItensVetor(mochilaVetor, totalItens);
-                        printf("\nDigite o nome do item para busca binaria: ");
-                        fgets(nome, sizeof(nome), stdin);
-                        nome[strcspn(nome, "\n")] = '\0';
-                        int pos = buscarBinariaVetor(mochilaVetor, totalItens, nome, &comp);
+                        long compOrdenacao = 0;
+                        if (garantirOrdenacaoVetor(&mochilaVetor, &compOrdenacao))
+                            printf("\nItens ordenados! (comparacoes: %ld)\n", compOrdenacao);
+                        else
+                            printf("\nItens ja estavam ordenados.\n");
+                        listarItensVetor(itens, totalItens);
+                        lerNome("\nDigite o nome do item para busca binaria: ", nome, sizeof(nome));
+                        int pos = buscarBinariaVetor(itens, totalItens, nome, &comp);
                         if (pos != -1)
                             printf("\nItem encontrado: %s | Tipo: %s | Qtd: %d\n",
-                                   mochilaVetor[pos].nome, mochilaVetor[pos].tipo, mochilaVetor[pos].quantidade);
+                                   itens[pos].nome, itens[pos].tipo, itens[pos].quantidade);
                         else
                             printf("\nItem nao encontrado!\n");
                         printf("Comparacoes (busca binaria): %d\n", comp);
+                    } else if (opcaoVetor == 6) {
+                        char nome[30];
+                        long comp = 0;
+                        long compOrdenacao = 0;
+                        IndiceEytzinger indice;
+                        garantirOrdenacaoVetor(&mochilaVetor, &compOrdenacao);
+                        ieInicializar(&indice);
+                        if (!ieConstruir(&indice, itens, (size_t)totalItens, sizeof(Item), offsetof(Item, nome))) {
+                            printf("\nMemoria insuficiente para o indice!\n");
+                            continue;
+                        }
+                        printf("\nItens ordenados e indexados!\n");
+                        lerNome("\nDigite o nome do item para busca no indice: ", nome, sizeof(nome));
+                        long pos = ieBuscar(&indice, nome, &comp);
+                        if (pos != -1)
+                            printf("\nItem encontrado: %s | Tipo: %s | Qtd: %d\n",
+                                   itens[pos].nome, itens[pos].tipo, itens[pos].quantidade);
+                        else
+                            printf("\nItem nao encontrado!\n");
+                        printf("Comparacoes (indice Eytzinger): %ld\n", comp);
+                        ieLiberar(&indice);
+                    } else if (opcaoVetor == 7) {
+                        char nome[30];
+                        int comp = 0;
+                        lerNome("Digite o nome do item: ", nome, sizeof(nome));
+                        int pos = buscarHashVetor(&mochilaVetor, nome, &comp);
+                        if (pos != -1)
+                            printf("\nItem encontrado: %s | Tipo: %s | Qtd: %d\n",
+                                   itens[pos].nome, itens[pos].tipo, itens[pos].quantidade);
+                        else
+                            printf("\nItem nao encontrado!\n");
+                        printf("Sondagens (indice hash): %d\n", comp);
                     }
 
                 } while (opcaoVetor != 0);
@@ -120,43 +319,92 @@ int main() {
             case 2: {
                 int opcaoLista;
                 do {
-                    printf("\n=== MOCHILA (LISTA ENCADEADA) ===\n");
-                    printf("1 - Inserir item\n");
-                    printf("2 - Remover item\n");
-                    printf("3 - Listar itens\n");
-                    printf("4 - Buscar (sequencial)\n");
-                    printf("0 - Voltar\n");
-                    printf("Escolha: ");
-                    scanf("%d", &opcaoLista);
-                    limparBuffer();
-
-                    if (opcaoLista == 1) inicio = inserirItemLista(inicio);
+                    consoleInterface("\n=== MOCHILA (LISTA ENCADEADA) ===\n");
+                    consoleInterface("1 - Inserir item\n");
+                    consoleInterface("2 - Remover item\n");
+                    consoleInterface("3 - Listar itens\n");
+                    consoleInterface("4 - Buscar (sequencial)\n");
+                    consoleInterface("5 - Buscar (indice hash)\n");
+                    consoleInterface("0 - Voltar\n");
+                    consoleInterface("Escolha: ");
+                    opcaoLista = -1;
+                    if (consoleLerInteiro(&opcaoLista) < 0) opcaoLista = 0; // fim da entrada: volta
+
+                    if (opcaoLista == 1) inserirItemLista(&mochilaLista);
                     else if (opcaoLista == 2) {
                         char nome[30];
-                        printf("Digite o nome do item a remover: ");
-                        fgets(nome, sizeof(nome), stdin);
-                        nome[strcspn(nome, "\n")] = '\0';
-                        inicio = removerItemLista(inicio, nome);
-                    } else if (opcaoLista == 3) listarItensLista(inicio);
-                    else if (opcaoLista == 4) {
+                        lerNome("Digite o nome do item a remover: ", nome, sizeof(nome));
+                        removerItemLista(&mochilaLista, nome);
+                    } else if (opcaoLista == 3) listarItensLista(mochilaLista.inicio);
+                    else if (opcaoLista == 4 || opcaoLista == 5) {
                         char nome[30];
                         int comp = 0;
-                        printf("Digite o nome do item: ");
-                        fgets(nome, sizeof(nome), stdin);
-                        nome[strcspn(nome, "\n")] = '\0';
-                        No *res = buscarSequencialLista(inicio, nome, &comp);
+                        No *res;
+                        lerNome("Digite o nome do item: ", nome, sizeof(nome));
+                        if (opcaoLista == 4)
+                            res = buscarSequencialLista(mochilaLista.inicio, nome, &comp);
+                        else
+                            res = buscarHashLista(&mochilaLista, nome, &comp);
                         if (res)
                             printf("\nItem encontrado: %s | Tipo: %s | Qtd: %d\n",
                                    res->dados.nome, res->dados.tipo, res->dados.quantidade);
                         else
                             printf("\nItem nao encontrado!\n");
-                        printf("Comparacoes: %d\n", comp);
+                        printf("%s: %d\n", opcaoLista == 4 ? "Comparacoes" : "Sondagens (indice hash)", comp);
                     }
 
                 } while (opcaoLista != 0);
                 break;
             }
 
+            case 3: {
+                int opcaoDesenrolada;
+                do {
+                    consoleInterface("\n=== MOCHILA (LISTA DESENROLADA, %d ITENS POR NO) ===\n", ITENS_POR_NO);
+                    consoleInterface("1 - Inserir item\n");
+                    consoleInterface("2 - Remover item\n");
+                    consoleInterface("3 - Listar itens\n");
+                    consoleInterface("4 - Buscar (sequencial)\n");
+                    consoleInterface("0 - Voltar\n");
+                    consoleInterface("Escolha: ");
+                    opcaoDesenrolada = -1;
+                    if (consoleLerInteiro(&opcaoDesenrolada) < 0) opcaoDesenrolada = 0; // fim da entrada: volta
+
+                    if (opcaoDesenrolada == 1) {
+                        Item novo;
+                        lerItem(&novo);
+                        if (adicionarItemDesenrolada(&mochilaDesenrolada, &novo))
+                            printf("\nItem inserido na lista desenrolada!\n");
+                        else
+                            printf("Erro de alocacao!\n");
+                    } else if (opcaoDesenrolada == 2) {
+                        char nome[30];
+                        int comp = 0;
+                        lerNome("Digite o nome do item a remover: ", nome, sizeof(nome));
+                        if (removerPorNomeDesenrolada(&mochilaDesenrolada, nome, &comp))
+                            printf("\nItem removido da lista desenrolada!\n");
+                        else
+                            printf("\nItem nao encontrado!\n");
+                        printf("Comparacoes: %d\n", comp);
+                    } else if (opcaoDesenrolada == 3) {
+                        listarItensDesenrolada(&mochilaDesenrolada);
+                    } else if (opcaoDesenrolada == 4) {
+                        char nome[30];
+                        int comp = 0;
+                        lerNome("Digite o nome do item: ", nome, sizeof(nome));
+                        Item *res = buscarSequencialDesenrolada(&mochilaDesenrolada, nome, &comp);
+                        if (res)
+                            printf("\nItem encontrado: %s | Tipo: %s | Qtd: %d\n",
+                                   res->nome, res->tipo, res->quantidade);
+                        else
+                            printf("\nItem nao encontrado!\n");
+                        printf("Comparacoes: %d\n", comp);
+                    }
+
+                } while (opcaoDesenrolada != 0);
+                break;
+            }
+
             case 0:
                 printf("\nEncerrando o sistema...\n");
                 break;
@@ -167,7 +415,9 @@ int main() {
 
     } while (opcaoPrincipal != 0);
 
-    liberarLista(inicio);
+    liberarLista(&mochilaLista);
+    liberarListaDesenrolada(&mochilaDesenrolada);
+    liberarMochilaVetor(&mochilaVetor);
     return 0;
 }
 
@@ -175,51 +425,149 @@ int main() {
 // IMPLEMENTAÇÃO - VERSÃO VETOR
 // ===============================
 
-void inserirItemVetor(Item mochila[], int *total) {
-    if (*total >= MAX_ITENS) {
-        printf("\nMochila cheia!\n");
-        return;
+static const char *nomeNoVetor(const void *contexto, size_t valor) {
+    const MochilaVetor *m = (const MochilaVetor *) contexto;
+    return VD_DADOS(&m->itens, Item)[valor].nome;
+}
+
+void inicializarMochilaVetor(MochilaVetor *m) {
+    vdInicializar(&m->itens, sizeof(Item));
+    ihInicializar(&m->indice);
+    m->ordenado = 1;   // vetor vazio já está ordenado
+}
+
+// Primeira posição cujo nome é maior que 'nome' (mantém a ordem de chegada
+// entre nomes iguais)
+static size_t posicaoInsercaoOrdenada(Item itens[], size_t total, const char *nome, long *comparacoes) {
+    size_t inicio = 0, fim = total;
+    while (inicio < fim) {
+        size_t meio = inicio + (fim - inicio) / 2;
+        (*comparacoes)++;
+        if (strcmp(itens[meio].nome, nome) <= 0) inicio = meio + 1;
+        else fim = meio;
     }
+    return inicio;
+}
 
-    Item novo;
-    printf("\nNome: ");
-    fgets(novo.nome, sizeof(novo.nome), stdin);
-    novo.nome[strcspn(novo.nome, "\n")] = '\0';
+// Insere o item e registra sua posição no índice. Em vetor ordenado, o item
+// entra direto na posição certa (se o vetor ainda for pequeno) ou no final
+// quando já vem depois do último nome; caso contrário vai para o final e o
+// vetor passa a ser considerado desordenado. As comparações de nome feitas
+// para achar a posição são somadas em *comparacoes.
+int adicionarItemVetor(MochilaVetor *m, const Item *item, long *comparacoes) {
+    size_t total = m->itens.tamanho;
+    size_t pos = total;
+
+    if (m->ordenado && total > 0) {
+        Item *itens = VD_DADOS(&m->itens, Item);
+        (*comparacoes)++;
+        if (strcmp(itens[total - 1].nome, item->nome) > 0) {
+            if (total < LIMITE_INSERCAO_ORDENADA)
+                pos = posicaoInsercaoOrdenada(itens, total, item->nome, comparacoes);
+            else
+                m->ordenado = 0;
+        }
+    }
+
+    if (vdAdicionar(&m->itens, item) == NULL)
+        return 0;
+    // a posição definitiva só é gravada depois do deslocamento, para que a
+    // entrada nova não seja confundida com a do item que ocupa 'pos' agora
+    if (!ihInserir(&m->indice, item->nome, pos == total ? pos : (size_t) -1)) {
+        m->itens.tamanho--;
+        return 0;
+    }
+
+    if (pos != total) {
+        // desloca a cauda uma posição e corrige o índice dos itens movidos de
+        // uma vez (a entrada nova, marcada com (size_t) -1, fica de fora)
+        Item *itens = VD_DADOS(&m->itens, Item);
+        memmove(&itens[pos + 1], &itens[pos], (total - pos) * sizeof(Item));
+        ihDeslocarValores(&m->indice, pos, total);
+        itens[pos] = *item;
+        ihLocalizarValor(&m->indice, item->nome, (size_t) -1)->valor = pos;
+    }
+    return 1;
+}
+
+// Remove pelo índice hash: o último item ocupa a posição liberada,
+// evitando deslocar todos os itens seguintes
+int removerPorNomeVetor(MochilaVetor *m, const char *nome, int *comparacoes) {
+    EntradaHash *e = ihBuscar(&m->indice, nome, nomeNoVetor, m, comparacoes);
+    if (e == NULL)
+        return 0;
+
+    size_t pos = e->valor;
+    size_t ultimo = m->itens.tamanho - 1;
+    Item *itens = VD_DADOS(&m->itens, Item);
+
+    ihRemoverEntrada(&m->indice, e);
+    if (pos != ultimo) {
+        EntradaHash *movido = ihLocalizarValor(&m->indice, itens[ultimo].nome, ultimo);
+        movido->valor = pos;
+        itens[pos] = itens[ultimo];
+        m->ordenado = 0;
+    }
+    m->itens.tamanho--;
+    return 1;
+}
 
-    printf("Tipo: ");
-    fgets(novo.tipo, sizeof(novo.tipo), stdin);
-    novo.tipo[strcspn(novo.tipo, "\n")] = '\0';
+// Ordena por nome só se necessário (a ordenação é adaptativa: trechos já em
+// ordem custam apenas uma passada). Retorna 1 se precisou ordenar.
+int garantirOrdenacaoVetor(MochilaVetor *m, long *comparacoes) {
+    if (m->ordenado)
+        return 0;
+    ordenarVetor(VD_DADOS(&m->itens, Item), (int) m->itens.tamanho, comparacoes);
+    reconstruirIndiceVetor(m);
+    m->ordenado = 1;
+    return 1;
+}
 
-    printf("Quantidade: ");
-    scanf("%d", &novo.quantidade);
-    limparBuffer();
+int buscarHashVetor(MochilaVetor *m, const char *nome, int *comparacoes) {
+    EntradaHash *e = ihBuscar(&m->indice, nome, nomeNoVetor, m, comparacoes);
+    return e ? (int) e->valor : -1;
+}
 
-    mochila[*total] = novo;
-    (*total)++;
+// Necessário sempre que os itens mudam de posição em bloco (ordenação)
+void reconstruirIndiceVetor(MochilaVetor *m) {
+    Item *itens = VD_DADOS(&m->itens, Item);
+    ihLimpar(&m->indice);
+    for (size_t i = 0; i < m->itens.tamanho; i++)
+        ihInserir(&m->indice, itens[i].nome, i);
+}
+
+void liberarMochilaVetor(MochilaVetor *m) {
+    ihLiberar(&m->indice);
+    vdLiberar(&m->itens);
+}
+
+void inserirItemVetor(MochilaVetor *m) {
+    Item novo;
+    long comparacoes = 0;
+    lerItem(&novo);
+
+    if (!adicionarItemVetor(m, &novo, &comparacoes)) {
+        printf("\nMemoria insuficiente!\n");
+        return;
+    }
     printf("\nItem inserido com sucesso!\n");
 }
 
-void removerItemVetor(Item mochila[], int *total) {
-    if (*total == 0) {
+void removerItemVetor(MochilaVetor *m) {
+    if (m->itens.tamanho == 0) {
         printf("\nMochila vazia!\n");
         return;
     }
 
     char nome[30];
-    printf("Nome do item a remover: ");
-    fgets(nome, sizeof(nome), stdin);
-    nome[strcspn(nome, "\n")] = '\0';
-
-    for (int i = 0; i < *total; i++) {
-        if (strcmp(mochila[i].nome, nome) == 0) {
-            for (int j = i; j < *total - 1; j++)
-                mochila[j] = mochila[j + 1];
-            (*total)--;
-            printf("\nItem removido com sucesso!\n");
-            return;
-        }
-    }
-    printf("\nItem nao encontrado!\n");
+    int comp = 0;
+    lerNome("Nome do item a remover: ", nome, sizeof(nome));
+
+    if (removerPorNomeVetor(m, nome, &comp))
+        printf("\nItem removido com sucesso!\n");
+    else
+        printf("\nItem nao encontrado!\n");
+    printf("Sondagens (indice hash): %d\n", comp);
 }
 
 void listarItensVetor(Item mochila[], int total) {
@@ -243,16 +591,142 @@ int buscarSequencialVetor(Item mochila[], int total, char nome[], int *comparaco
     return -1;
 }
 
-void ordenarVetor(Item mochila[], int total) {
-    for (int i = 0; i < total - 1; i++) {
-        for (int j = i + 1; j < total; j++) {
-            if (strcmp(mochila[i].nome, mochila[j].nome) > 0) {
-                Item temp = mochila[i];
-                mochila[i] = mochila[j];
-                mochila[j] = temp;
-            }
+// Ordenação adaptativa por nome (merge sort natural, no estilo do TimSort):
+//  1) divide o vetor em sequências já ordenadas ("runs"); sequências
+//     estritamente decrescentes são invertidas;
+//  2) runs curtas são estendidas até RUN_MINIMA com inserção binária;
+//  3) runs vizinhas são mescladas duas a duas até sobrar uma.
+// Vetor já ordenado custa n-1 comparações e nenhuma cópia; vetor ordenado com
+// poucos itens fora do lugar custa O(n). Estável.
+#define RUN_MINIMA 32
+
+static int compararNomes(const Item *a, const Item *b, long *comparacoes) {
+    (*comparacoes)++;
+    return strcmp(a->nome, b->nome);
+}
+
+// Ordena v[inicio..fim) sabendo que v[inicio..ordenadoAte) já está em ordem
+static void insercaoBinaria(Item v[], int inicio, int ordenadoAte, int fim, long *comparacoes) {
+    for (int i = ordenadoAte; i < fim; i++) {
+        Item chave = v[i];
+        int esq = inicio, dir = i;
+        while (esq < dir) {
+            int meio = esq + (dir - esq) / 2;
+            if (compararNomes(&chave, &v[meio], comparacoes) < 0) dir = meio;
+            else esq = meio + 1;
+        }
+        memmove(&v[esq + 1], &v[esq], (size_t)(i - esq) * sizeof(Item));
+        v[esq] = chave;
+    }
+}
+
+// Retorna o fim da run que começa em 'inicio' (já deixada em ordem crescente)
+static int encontrarRun(Item v[], int inicio, int total, long *comparacoes) {
+    int fim = inicio + 1;
+    if (fim == total)
+        return fim;
+    if (compararNomes(&v[fim], &v[inicio], comparacoes) < 0) {
+        while (fim + 1 < total && compararNomes(&v[fim + 1], &v[fim], comparacoes) < 0)
+            fim++;
+        fim++;
+        for (int i = inicio, j = fim - 1; i < j; i++, j--) {
+            Item temp = v[i];
+            v[i] = v[j];
+            v[j] = temp;
+        }
+    } else {
+        while (fim + 1 < total && compararNomes(&v[fim + 1], &v[fim], comparacoes) >= 0)
+            fim++;
+        fim++;
+    }
+    return fim;
+}
+
+// Mescla v[inicio..meio) e v[meio..fim). O começo da primeira run que já é
+// menor que o primeiro item da segunda e o final da segunda que já é maior que
+// o último da primeira ficam no lugar; só o trecho do meio é copiado.
+static void mesclarRuns(Item v[], int inicio, int meio, int fim, Item *temp, long *comparacoes) {
+    int esq, dir, a, b, k, qtdA;
+
+    if (compararNomes(&v[meio - 1], &v[meio], comparacoes) <= 0)
+        return;
+
+    esq = inicio;
+    dir = meio;
+    while (esq < dir) {
+        int m = esq + (dir - esq) / 2;
+        if (compararNomes(&v[m], &v[meio], comparacoes) <= 0) esq = m + 1;
+        else dir = m;
+    }
+    inicio = esq;
+
+    esq = meio;
+    dir = fim;
+    while (esq < dir) {
+        int m = esq + (dir - esq) / 2;
+        if (compararNomes(&v[m], &v[meio - 1], comparacoes) < 0) esq = m + 1;
+        else dir = m;
+    }
+    fim = esq;
+
+    qtdA = meio - inicio;
+    memcpy(temp, &v[inicio], (size_t) qtdA * sizeof(Item));
+    a = 0;
+    b = meio;
+    k = inicio;
+    while (a < qtdA && b < fim) {
+        if (compararNomes(&v[b], &temp[a], comparacoes) < 0) v[k++] = v[b++];
+        else v[k++] = temp[a++];
+    }
+    if (a < qtdA)
+        memcpy(&v[k], &temp[a], (size_t)(qtdA - a) * sizeof(Item));
+}
+
+void ordenarVetor(Item mochila[], int total, long *comparacoes) {
+    INSTR_CRONOMETRAR("ordenarVetor");
+    int *inicios, qtdRuns = 0, i;
+    Item *temp;
+
+    if (total < 2)
+        return;
+
+    // cada run (menos a última) tem pelo menos RUN_MINIMA itens
+    inicios = (int *) memAlocar(&memOrdenacao, (size_t)(total / RUN_MINIMA + 2) * sizeof(int));
+    temp = (Item *) memAlocar(&memOrdenacao, (size_t) total * sizeof(Item));
+    if (inicios == NULL || temp == NULL) {
+        memLiberar(inicios);
+        memLiberar(temp);
+        insercaoBinaria(mochila, 0, 1, total, comparacoes);
+        return;
+    }
+
+    for (i = 0; i < total; ) {
+        int fim = encontrarRun(mochila, i, total, comparacoes);
+        if (fim - i < RUN_MINIMA) {
+            int estendido = (i + RUN_MINIMA < total) ? i + RUN_MINIMA : total;
+            insercaoBinaria(mochila, i, fim, estendido, comparacoes);
+            fim = estendido;
         }
+        inicios[qtdRuns++] = i;
+        i = fim;
     }
+    inicios[qtdRuns] = total;
+
+    // mescla runs vizinhas duas a duas até sobrar uma
+    while (qtdRuns > 1) {
+        int novas = 0;
+        for (i = 0; i + 1 < qtdRuns; i += 2) {
+            mesclarRuns(mochila, inicios[i], inicios[i + 1], inicios[i + 2], temp, comparacoes);
+            inicios[novas++] = inicios[i];
+        }
+        if (i < qtdRuns)
+            inicios[novas++] = inicios[i];
+        inicios[novas] = total;
+        qtdRuns = novas;
+    }
+
+    memLiberar(inicios);
+    memLiberar(temp);
 }
 
 int buscarBinariaVetor(Item mochila[], int total, char nome[], int *comparacoes) {
@@ -272,53 +746,82 @@ int buscarBinariaVetor(Item mochila[], int total, char nome[], int *comparacoes)
 // IMPLEMENTAÇÃO - VERSÃO LISTA
 // ===============================
 
-No* inserirItemLista(No *inicio) {
-    No *novo = (No*) malloc(sizeof(No));
-    if (!novo) {
-        printf("Erro de alocacao!\n");
-        return inicio;
-    }
+static const char *nomeNoLista(const void *contexto, size_t valor) {
+    (void) contexto;
+    return ((const No *) valor)->dados.nome;
+}
 
-    printf("\nNome: ");
-    fgets(novo->dados.nome, sizeof(novo->dados.nome), stdin);
-    novo->dados.nome[strcspn(novo->dados.nome, "\n")] = '\0';
+void inicializarMochilaLista(MochilaLista *m) {
+    m->inicio = NULL;
+    ihInicializar(&m->indice);
+    poolInicializar(&m->pool);
+}
 
-    printf("Tipo: ");
-    fgets(novo->dados.tipo, sizeof(novo->dados.tipo), stdin);
-    novo->dados.tipo[strcspn(novo->dados.tipo, "\n")] = '\0';
+// Insere no início da lista e registra o nó no índice
+No* adicionarItemLista(MochilaLista *m, const Item *item) {
+    No *novo = poolAlocar(&m->pool);
+    if (!novo)
+        return NULL;
 
-    printf("Quantidade: ");
-    scanf("%d", &novo->dados.quantidade);
-    limparBuffer();
+    novo->dados = *item;
+    if (!ihInserir(&m->indice, item->nome, (size_t) novo)) {
+        poolDevolver(&m->pool, novo);
+        return NULL;
+    }
 
-    novo->proximo = inicio;
-    printf("\nItem inserido na lista!\n");
+    novo->anterior = NULL;
+    novo->proximo = m->inicio;
+    if (m->inicio != NULL)
+        m->inicio->anterior = novo;
+    m->inicio = novo;
     return novo;
 }
 
-No* removerItemLista(No *inicio, char nome[]) {
-    if (inicio == NULL) {
-        printf("\nLista vazia!\n");
-        return inicio;
-    }
+// Localiza o nó pelo índice hash e o desliga da lista sem percorrê-la
+int removerPorNomeLista(MochilaLista *m, const char *nome, int *comparacoes) {
+    EntradaHash *e = ihBuscar(&m->indice, nome, nomeNoLista, NULL, comparacoes);
+    if (e == NULL)
+        return 0;
 
-    No *atual = inicio, *anterior = NULL;
-    while (atual != NULL && strcmp(atual->dados.nome, nome) != 0) {
-        anterior = atual;
-        atual = atual->proximo;
-    }
+    No *atual = (No *) e->valor;
+    ihRemoverEntrada(&m->indice, e);
 
-    if (atual == NULL) {
-        printf("\nItem nao encontrado!\n");
-        return inicio;
+    if (atual->anterior == NULL) m->inicio = atual->proximo;
+    else atual->anterior->proximo = atual->proximo;
+    if (atual->proximo != NULL) atual->proximo->anterior = atual->anterior;
+
+    poolDevolver(&m->pool, atual);
+    return 1;
+}
+
+No* buscarHashLista(MochilaLista *m, const char *nome, int *comparacoes) {
+    EntradaHash *e = ihBuscar(&m->indice, nome, nomeNoLista, NULL, comparacoes);
+    return e ? (No *) e->valor : NULL;
+}
+
+void inserirItemLista(MochilaLista *m) {
+    Item novo;
+    lerItem(&novo);
+
+    if (adicionarItemLista(m, &novo) == NULL) {
+        printf("Erro de alocacao!\n");
+        return;
     }
+    printf("\nItem inserido na lista!\n");
+}
 
-    if (anterior == NULL) inicio = atual->proximo;
-    else anterior->proximo = atual->proximo;
+void removerItemLista(MochilaLista *m, char nome[]) {
+    int comp = 0;
+    if (m->inicio == NULL) {
+        printf("\nLista vazia!\n");
+        return;
+    }
 
-    free(atual);
-    printf("\nItem removido da lista!\n");
-    return inicio;
+    if (!removerPorNomeLista(m, nome, &comp))
+        printf("\nItem nao encontrado!\n");
+    else
+        printf("\nItem removido da lista!\n");
+    printf("Sondagens (indice hash): %d\n", comp);
 }
 
 void listarItensLista(No *inicio) {
@@ -348,19 +851,914 @@ No* buscarSequencialLista(No *inicio, char nome[], int *comparacoes) {
     return NULL;
 }
 
-void liberarLista(No *inicio) {
-    No *aux;
-    while (inicio != NULL) {
-        aux = inicio;
-        inicio = inicio->proximo;
-        free(aux);
+// Merge Sort da lista por nome (estável); refaz os ponteiros 'anterior' no final
+static No* mesclarListas(No *a, No *b, long *comparacoes) {
+    No cabeca;
+    No *fim = &cabeca;
+    while (a != NULL && b != NULL) {
+        (*comparacoes)++;
+        if (strcmp(b->dados.nome, a->dados.nome) < 0) {
+            fim->proximo = b;
+            b = b->proximo;
+        } else {
+            fim->proximo = a;
+            a = a->proximo;
+        }
+        fim = fim->proximo;
+    }
+    fim->proximo = (a != NULL) ? a : b;
+    return cabeca.proximo;
+}
+
+static No* ordenarNos(No *inicio, long *comparacoes) {
+    if (inicio == NULL || inicio->proximo == NULL)
+        return inicio;
+    No *lento = inicio, *rapido = inicio->proximo;
+    while (rapido != NULL && rapido->proximo != NULL) {
+        lento = lento->proximo;
+        rapido = rapido->proximo->proximo;
+    }
+    No *meio = lento->proximo;
+    lento->proximo = NULL;
+    return mesclarListas(ordenarNos(inicio, comparacoes), ordenarNos(meio, comparacoes), comparacoes);
+}
+
+void ordenarLista(MochilaLista *m, long *comparacoes) {
+    INSTR_CRONOMETRAR("ordenarLista");
+    No *anterior = NULL;
+    m->inicio = ordenarNos(m->inicio, comparacoes);
+    for (No *aux = m->inicio; aux != NULL; aux = aux->proximo) {
+        aux->anterior = anterior;
+        anterior = aux;
+    }
+}
+
+// Busca em lista ordenada: ainda é sequencial (não há acesso aleatório),
+// mas para assim que passa do ponto onde o nome estaria
+No* buscarOrdenadaLista(No *inicio, const char *nome, int *comparacoes) {
+    for (No *aux = inicio; aux != NULL; aux = aux->proximo) {
+        (*comparacoes)++;
+        int cmp = strcmp(aux->dados.nome, nome);
+        if (cmp == 0) return aux;
+        if (cmp > 0) break;
+    }
+    return NULL;
+}
+
+// Os nós pertencem ao pool: basta liberar os blocos, sem percorrer a lista
+void liberarLista(MochilaLista *m) {
+    m->inicio = NULL;
+    poolLiberar(&m->pool);
+    ihLiberar(&m->indice);
+}
+
+// ===============================
+// IMPLEMENTAÇÃO - POOL DE NÓS
+// ===============================
+
+void poolInicializar(PoolNos *pool) {
+    pool->blocos = NULL;
+    pool->usadosNoBloco = NOS_POR_BLOCO;
+    pool->livres = NULL;
+    pool->emUso = 0;
+    pool->totalBlocos = 0;
+}
+
+// Reaproveita um nó devolvido; se não houver, entrega o próximo nó do bloco
+// mais novo e só chama malloc quando o bloco acaba
+No* poolAlocar(PoolNos *pool) {
+    No *no;
+    if (pool->livres != NULL) {
+        no = pool->livres;
+        pool->livres = no->proximo;
+    } else {
+        if (pool->usadosNoBloco == NOS_POR_BLOCO) {
+            BlocoNos *bloco = (BlocoNos *) memAlocar(&memNosPool, sizeof(BlocoNos));
+            if (bloco == NULL)
+                return NULL;
+            bloco->proximo = pool->blocos;
+            pool->blocos = bloco;
+            pool->usadosNoBloco = 0;
+            pool->totalBlocos++;
+        }
+        no = &pool->blocos->nos[pool->usadosNoBloco++];
+    }
+    pool->emUso++;
+    return no;
+}
+
+void poolDevolver(PoolNos *pool, No *no) {
+    no->proximo = pool->livres;
+    pool->livres = no;
+    pool->emUso--;
+}
+
+void poolLiberar(PoolNos *pool) {
+    while (pool->blocos != NULL) {
+        BlocoNos *prox = pool->blocos->proximo;
+        memLiberar(pool->blocos);
+        pool->blocos = prox;
+    }
+    poolInicializar(pool);
+}
+
+// ===============================
+// IMPLEMENTAÇÃO - LISTA DESENROLADA
+// ===============================
+
+void inicializarListaDesenrolada(ListaDesenrolada *l) {
+    l->inicio = NULL;
+    l->total = 0;
+}
+
+// Acrescenta no primeiro nó; cria um nó novo no início quando ele está cheio
+int adicionarItemDesenrolada(ListaDesenrolada *l, const Item *item) {
+    NoDesenrolado *no = l->inicio;
+    if (no == NULL || no->qtd == ITENS_POR_NO) {
+        no = (NoDesenrolado *) memAlocar(&memNosDesenrolados, sizeof(NoDesenrolado));
+        if (no == NULL)
+            return 0;
+        no->qtd = 0;
+        no->proximo = l->inicio;
+        l->inicio = no;
+    }
+    no->itens[no->qtd++] = *item;
+    l->total++;
+    return 1;
+}
+
+// Remove deslocando só os itens do próprio nó; nós vazios saem da lista e
+// nós com pouco uso absorvem o vizinho seguinte quando os dois cabem em um
+int removerPorNomeDesenrolada(ListaDesenrolada *l, const char *nome, int *comparacoes) {
+    NoDesenrolado *anterior = NULL;
+    for (NoDesenrolado *no = l->inicio; no != NULL; anterior = no, no = no->proximo) {
+        for (int i = 0; i < no->qtd; i++) {
+            (*comparacoes)++;
+            if (strcmp(no->itens[i].nome, nome) != 0)
+                continue;
+
+            memmove(&no->itens[i], &no->itens[i + 1], (size_t)(no->qtd - i - 1) * sizeof(Item));
+            no->qtd--;
+            l->total--;
+
+            if (no->qtd == 0) {
+                if (anterior == NULL) l->inicio = no->proximo;
+                else anterior->proximo = no->proximo;
+                memLiberar(no);
+            } else if (no->proximo != NULL && no->qtd + no->proximo->qtd <= ITENS_POR_NO) {
+                NoDesenrolado *prox = no->proximo;
+                memcpy(&no->itens[no->qtd], prox->itens, (size_t)prox->qtd * sizeof(Item));
+                no->qtd += prox->qtd;
+                no->proximo = prox->proximo;
+                memLiberar(prox);
+            }
+            return 1;
+        }
+    }
+    return 0;
+}
+
+Item* buscarSequencialDesenrolada(ListaDesenrolada *l, const char *nome, int *comparacoes) {
+    for (NoDesenrolado *no = l->inicio; no != NULL; no = no->proximo) {
+        for (int i = 0; i < no->qtd; i++) {
+            (*comparacoes)++;
+            if (strcmp(no->itens[i].nome, nome) == 0)
+                return &no->itens[i];
+        }
+    }
+    return NULL;
+}
+
+void listarItensDesenrolada(ListaDesenrolada *l) {
+    printf("\n--- ITENS NA LISTA DESENROLADA ---\n");
+    if (l->inicio == NULL) {
+        printf("Lista vazia.\n");
+        return;
+    }
+
+    int n = 1;
+    for (NoDesenrolado *no = l->inicio; no != NULL; no = no->proximo) {
+        for (int i = 0; i < no->qtd; i++) {
+            printf("%d. %s | %s | Qtd: %d\n", n++, no->itens[i].nome,
+                   no->itens[i].tipo, no->itens[i].quantidade);
+        }
+    }
+}
+
+void liberarListaDesenrolada(ListaDesenrolada *l) {
+    while (l->inicio != NULL) {
+        NoDesenrolado *prox = l->inicio->proximo;
+        memLiberar(l->inicio);
+        l->inicio = prox;
+    }
+    l->total = 0;
+}
+
+// ===============================
+// BENCHMARK - LISTAS
+// ===============================
+// Compara a lista com malloc por nó (versão original), a lista com pool de
+// nós e a lista desenrolada com a mesma carga:
+//   1) insere n itens no início
+//   2) remove um item sim, um não, em uma única passada (fragmenta o heap)
+//   3) reinsere n/2 itens (reaproveita a memória liberada)
+//   4) percorre a lista 10 vezes com busca sequencial por um nome ausente
+//   5) libera tudo
+
+static double tempoAtual(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+}
+
+static void itemBenchmark(Item *item, long i) {
+    snprintf(item->nome, sizeof(item->nome), "item%09ld", i);
+    strcpy(item->tipo, "municao");
+    item->quantidade = (int)(i % 100);
+}
+
+static void imprimirFase(const char *fase, long operacoes, double segundos) {
+    printf("  %-22s %10.3f ms  %8.2f Mops/s\n", fase, segundos * 1e3,
+           segundos > 0.0 ? operacoes / segundos / 1e6 : 0.0);
+}
+
+// Lista simples (sem índice) sobre malloc ou sobre o pool
+static No* novoNoBenchmark(PoolNos *pool) {
+    return pool ? poolAlocar(pool) : (No *) memAlocar(&memNosMalloc, sizeof(No));
+}
+
+static void liberarNoBenchmark(PoolNos *pool, No *no) {
+    if (pool) poolDevolver(pool, no);
+    else memLiberar(no);
+}
+
+static void benchmarkListaEncadeada(long n, PoolNos *pool) {
+    No *inicio = NULL;
+    double t;
+    long i;
+    int comp;
+
+    printf("%s\n", pool ? "Lista encadeada com pool de nos" : "Lista encadeada com malloc por no");
+
+    t = tempoAtual();
+    for (i = 0; i < n; i++) {
+        No *novo = novoNoBenchmark(pool);
+        if (novo == NULL) {
+            printf("Memoria insuficiente apos %ld nos.\n", i);
+            break;
+        }
+        itemBenchmark(&novo->dados, i);
+        novo->proximo = inicio;
+        inicio = novo;
+    }
+    imprimirFase("insercao", n, tempoAtual() - t);
+
+    t = tempoAtual();
+    for (No *aux = inicio; aux != NULL && aux->proximo != NULL; aux = aux->proximo) {
+        No *removido = aux->proximo;
+        aux->proximo = removido->proximo;
+        liberarNoBenchmark(pool, removido);
+    }
+    imprimirFase("remocao alternada", n / 2, tempoAtual() - t);
+
+    t = tempoAtual();
+    for (i = 0; i < n / 2; i++) {
+        No *novo = novoNoBenchmark(pool);
+        if (novo == NULL) {
+            printf("Memoria insuficiente apos %ld nos.\n", i);
+            break;
+        }
+        itemBenchmark(&novo->dados, n + i);
+        novo->proximo = inicio;
+        inicio = novo;
+    }
+    imprimirFase("reinsercao", n / 2, tempoAtual() - t);
+
+    t = tempoAtual();
+    for (i = 0; i < 10; i++) {
+        comp = 0;
+        buscarSequencialLista(inicio, "inexistente", &comp);
+    }
+    imprimirFase("percurso (10x)", 10L * comp, tempoAtual() - t);
+
+    t = tempoAtual();
+    if (pool) {
+        poolLiberar(pool);
+    } else {
+        while (inicio != NULL) {
+            No *prox = inicio->proximo;
+            memLiberar(inicio);
+            inicio = prox;
+        }
+    }
+    imprimirFase("liberacao", n, tempoAtual() - t);
+}
+
+static void benchmarkListaDesenrolada(long n) {
+    ListaDesenrolada l;
+    Item item;
+    double t;
+    long i;
+    int comp;
+
+    printf("Lista desenrolada (%d itens por no)\n", ITENS_POR_NO);
+    inicializarListaDesenrolada(&l);
+
+    t = tempoAtual();
+    for (i = 0; i < n; i++) {
+        itemBenchmark(&item, i);
+        adicionarItemDesenrolada(&l, &item);
+    }
+    imprimirFase("insercao", n, tempoAtual() - t);
+
+    // mesma remoção alternada: compacta cada nó no lugar
+    t = tempoAtual();
+    for (NoDesenrolado *no = l.inicio; no != NULL; no = no->proximo) {
+        int k = 0;
+        for (int j = 0; j < no->qtd; j += 2)
+            no->itens[k++] = no->itens[j];
+        l.total -= (size_t)(no->qtd - k);
+        no->qtd = k;
+    }
+    imprimirFase("remocao alternada", n / 2, tempoAtual() - t);
+
+    t = tempoAtual();
+    for (i = 0; i < n / 2; i++) {
+        itemBenchmark(&item, n + i);
+        adicionarItemDesenrolada(&l, &item);
+    }
+    imprimirFase("reinsercao", n / 2, tempoAtual() - t);
+
+    t = tempoAtual();
+    for (i = 0; i < 10; i++) {
+        comp = 0;
+        buscarSequencialDesenrolada(&l, "inexistente", &comp);
+    }
+    imprimirFase("percurso (10x)", 10L * comp, tempoAtual() - t);
+
+    t = tempoAtual();
+    liberarListaDesenrolada(&l);
+    imprimirFase("liberacao", n, tempoAtual() - t);
+}
+
+int benchmarkListas(long n) {
+    PoolNos pool;
+
+    if (n < 2) n = 2;
+    printf("=== Benchmark de listas: %ld itens (sizeof(No) = %zu, sizeof(NoDesenrolado) = %zu) ===\n",
+           n, sizeof(No), sizeof(NoDesenrolado));
+
+    benchmarkListaEncadeada(n, NULL);
+    poolInicializar(&pool);
+    benchmarkListaEncadeada(n, &pool);
+    benchmarkListaDesenrolada(n);
+
+    // quantas chamadas ao alocador cada estrutura fez para a mesma carga
+    printf("\n");
+    memRelatorio(stdout);
+    return 0;
+}
+
+// ===============================
+// IMPLEMENTAÇÃO - ÍNDICE HASH
+// ===============================
+
+#define IH_CAPACIDADE_INICIAL 16
+
+// FNV-1a de 32 bits; 0 é reservado para posição livre
+uint32_t hashNome(const char *nome) {
+    uint32_t h = 2166136261u;
+    while (*nome) {
+        h ^= (unsigned char) *nome++;
+        h *= 16777619u;
+    }
+    return h ? h : 1;
+}
+
+void ihInicializar(IndiceHash *ih) {
+    ih->entradas = NULL;
+    ih->capacidade = 0;
+    ih->ocupadas = 0;
+}
+
+// Coloca a entrada na primeira posição livre a partir da posição ideal
+static void ihColocar(EntradaHash *entradas, size_t mascara, uint32_t hash, size_t valor) {
+    size_t i = hash & mascara;
+    while (entradas[i].hash != 0)
+        i = (i + 1) & mascara;
+    entradas[i].hash = hash;
+    entradas[i].valor = valor;
+}
+
+// Dobra a tabela reaproveitando os hashes guardados (sem reler os nomes)
+static int ihCrescer(IndiceHash *ih) {
+    INSTR_CRONOMETRAR("ihCrescer");
+    size_t nova = ih->capacidade ? ih->capacidade * 2 : IH_CAPACIDADE_INICIAL;
+    EntradaHash *entradas = (EntradaHash *) memZerada(&memIndiceHash, nova, sizeof(EntradaHash));
+    if (entradas == NULL)
+        return 0;
+    for (size_t i = 0; i < ih->capacidade; i++) {
+        if (ih->entradas[i].hash != 0)
+            ihColocar(entradas, nova - 1, ih->entradas[i].hash, ih->entradas[i].valor);
+    }
+    memLiberar(ih->entradas);
+    ih->entradas = entradas;
+    ih->capacidade = nova;
+    return 1;
+}
+
+// Nomes repetidos são aceitos: cada item tem sua própria entrada
+int ihInserir(IndiceHash *ih, const char *nome, size_t valor) {
+    INSTR_CRONOMETRAR("ihInserir");
+    // fator de carga máximo de 3/4
+    if ((ih->ocupadas + 1) * 4 > ih->capacidade * 3 && !ihCrescer(ih))
+        return 0;
+    ihColocar(ih->entradas, ih->capacidade - 1, hashNome(nome), valor);
+    ih->ocupadas++;
+    return 1;
+}
+
+// Cada posição ocupada visitada conta como uma sondagem; o strcmp só
+// acontece quando o hash guardado coincide
+EntradaHash* ihBuscar(IndiceHash *ih, const char *nome, NomeDoValor nomeDe, const void *contexto, int *comparacoes) {
+    INSTR_CRONOMETRAR("ihBuscar");
+    if (ih->ocupadas == 0)
+        return NULL;
+    uint32_t h = hashNome(nome);
+    size_t mascara = ih->capacidade - 1;
+    for (size_t i = h & mascara; ih->entradas[i].hash != 0; i = (i + 1) & mascara) {
+        (*comparacoes)++;
+        INSTR_CONTAR("hash.sondagens");
+        if (ih->entradas[i].hash == h && strcmp(nomeDe(contexto, ih->entradas[i].valor), nome) == 0)
+            return &ih->entradas[i];
+    }
+    return NULL;
+}
+
+// Encontra a entrada de um item específico (útil com nomes repetidos)
+EntradaHash* ihLocalizarValor(IndiceHash *ih, const char *nome, size_t valor) {
+    uint32_t h = hashNome(nome);
+    size_t mascara = ih->capacidade - 1;
+    for (size_t i = h & mascara; ih->entradas[i].hash != 0; i = (i + 1) & mascara) {
+        if (ih->entradas[i].valor == valor)
+            return &ih->entradas[i];
+    }
+    return NULL;
+}
+
+// Soma 1 aos valores em [inicio, fim) numa única varredura da tabela, sem
+// reler nomes: acompanha um memmove que abre espaço na posição 'inicio'. Sem
+// desvios (o valor de uma posição livre não é usado, pode mudar à vontade).
+void ihDeslocarValores(IndiceHash *ih, size_t inicio, size_t fim) {
+    EntradaHash *e = ih->entradas;
+    for (size_t i = 0; i < ih->capacidade; i++)
+        e[i].valor += e[i].valor - inicio < fim - inicio;
+}
+
+// Remoção com deslocamento para trás: as entradas seguintes do mesmo
+// agrupamento voltam para perto da posição ideal, sem deixar marcas de remoção
+void ihRemoverEntrada(IndiceHash *ih, EntradaHash *entrada) {
+    size_t mascara = ih->capacidade - 1;
+    size_t i = (size_t)(entrada - ih->entradas);
+    size_t j = i;
+
+    for (;;) {
+        j = (j + 1) & mascara;
+        if (ih->entradas[j].hash == 0)
+            break;
+        size_t ideal = ih->entradas[j].hash & mascara;
+        // a entrada em j pode ocupar i se i estiver entre sua posição ideal e j
+        if (((j - ideal) & mascara) >= ((j - i) & mascara)) {
+            ih->entradas[i] = ih->entradas[j];
+            i = j;
+        }
+    }
+    ih->entradas[i].hash = 0;
+    ih->ocupadas--;
+}
+
+void ihLimpar(IndiceHash *ih) {
+    if (ih->entradas != NULL)
+        memset(ih->entradas, 0, ih->capacidade * sizeof(EntradaHash));
+    ih->ocupadas = 0;
+}
+
+void ihLiberar(IndiceHash *ih) {
+    memLiberar(ih->entradas);
+    ihInicializar(ih);
+}
+
+// ===============================
+// FUNÇÕES AUXILIARES
+// ===============================
+void lerItem(Item *novo) {
+    consoleInterface("\nNome: ");
+    consoleLerLinha(novo->nome, sizeof(novo->nome));
+
+    consoleInterface("Tipo: ");
+    consoleLerLinha(novo->tipo, sizeof(novo->tipo));
+
+    consoleInterface("Quantidade: ");
+    novo->quantidade = 0;
+    consoleLerInteiro(&novo->quantidade);
+}
+
+void lerNome(const char *mensagem, char nome[], int tamanho) {
+    consoleInterface("%s", mensagem);
+    consoleLerLinha(nome, (size_t) tamanho);
+}
+
+// ===============================
+// MODO LOTE
+// ===============================
+// ./mochilafreefireaventureiro --lote arquivo (ou - para a entrada padrão).
+// Os comandos valem para a estrutura escolhida por último (como no menu
+// principal); a saída segue o formato de lote.h, com o número de
+// comparações/sondagens no último campo das buscas e remoções:
+//     estrutura vetor|lista|desenrolada       -> ok estrutura <nome>
+//     adicionar <nome> <tipo> <quantidade>    -> ok adicionar <total de itens>
+//     remover <nome>                          -> ok|nao remover <nome> <comparacoes>
+//     buscar <nome>          (sequencial)     -> ok buscar <nome> <tipo> <qtd> <comparacoes>
+//     buscar-hash <nome>     (vetor e lista)     | nao buscar <nome> <comparacoes>
+//     buscar-binaria <nome>  (vetor: ordena se preciso)
+//     buscar-indice <nome>   (vetor: índice Eytzinger, refeito só após mudanças)
+//     listar                                  -> ok listar <n>, depois n linhas "item <i> <nome> <tipo> <qtd>"
+
+typedef enum { LOTE_VETOR, LOTE_LISTA, LOTE_DESENROLADA } EstruturaLote;
+static const char *NOMES_ESTRUTURA_LOTE[] = {"vetor", "lista", "desenrolada"};
+
+static void relatarBuscaLote(const char *comando, const char *nome, const Item *achado, long comparacoes) {
+    if (achado)
+        printf("ok\t%s\t%s\t%s\t%d\t%ld\n", comando, achado->nome, achado->tipo, achado->quantidade, comparacoes);
+    else
+        printf("nao\t%s\t%s\t%ld\n", comando, nome, comparacoes);
+}
+
+static void listarItemLote(size_t i, const Item *item) {
+    printf("item\t%zu\t%s\t%s\t%d\n", i, item->nome, item->tipo, item->quantidade);
+}
+
+int executarLote(const char *caminho) {
+    MochilaVetor vetor;
+    MochilaLista lista;
+    ListaDesenrolada desenrolada;
+    IndiceEytzinger indice;
+    int indiceValido = 0;
+    EstruturaLote estrutura = LOTE_VETOR;
+    Lote lote;
+
+    if (!loteAbrir(&lote, caminho)) return 1;
+    inicializarMochilaVetor(&vetor);
+    inicializarMochilaLista(&lista);
+    inicializarListaDesenrolada(&desenrolada);
+    ieInicializar(&indice);
+
+    while (loteProximo(&lote)) {
+        const char *comando = loteCampo(&lote, 0), *nome = loteCampo(&lote, 1);
+        Item *itens = VD_DADOS(&vetor.itens, Item);
+        int total = (int) vetor.itens.tamanho;
+        int comp = 0;
+
+        if (loteComando(&lote, "estrutura", 1)) {
+            int e;
+            for (e = LOTE_VETOR; e <= LOTE_DESENROLADA; e++)
+                if (strcmp(nome, NOMES_ESTRUTURA_LOTE[e]) == 0) break;
+            if (e > LOTE_DESENROLADA) {
+                loteErro(&lote, "estrutura desconhecida: %s", nome);
+                continue;
+            }
+            estrutura = (EstruturaLote) e;
+            printf("ok\testrutura\t%s\n", NOMES_ESTRUTURA_LOTE[e]);
+        } else if (loteComando(&lote, "adicionar", 3)) {
+            Item novo;
+            long quantidade;
+            int ok;
+            size_t totalItens;
+            if (!loteInteiro(&lote, 3, &quantidade)) {
+                loteErro(&lote, "quantidade invalida: %s", loteCampo(&lote, 3));
+                continue;
+            }
+            snprintf(novo.nome, sizeof(novo.nome), "%s", nome);
+            snprintf(novo.tipo, sizeof(novo.tipo), "%s", loteCampo(&lote, 2));
+            novo.quantidade = (int) quantidade;
+            if (estrutura == LOTE_VETOR) {
+                long comparacoes = 0;
+                ok = adicionarItemVetor(&vetor, &novo, &comparacoes);
+                indiceValido = 0;
+                totalItens = vetor.itens.tamanho;
+            } else if (estrutura == LOTE_LISTA) {
+                ok = adicionarItemLista(&lista, &novo) != NULL;
+                totalItens = lista.pool.emUso;
+            } else {
+                ok = adicionarItemDesenrolada(&desenrolada, &novo);
+                totalItens = desenrolada.total;
+            }
+            if (!ok) {
+                loteErro(&lote, "memoria insuficiente");
+                break;
+            }
+            printf("ok\tadicionar\t%zu\n", totalItens);
+        } else if (loteComando(&lote, "remover", 1)) {
+            int removido;
+            if (estrutura == LOTE_VETOR) {
+                removido = removerPorNomeVetor(&vetor, nome, &comp);
+                if (removido) indiceValido = 0;
+            } else if (estrutura == LOTE_LISTA) {
+                removido = removerPorNomeLista(&lista, nome, &comp);
+            } else {
+                removido = removerPorNomeDesenrolada(&desenrolada, nome, &comp);
+            }
+            printf("%s\tremover\t%s\t%d\n", removido ? "ok" : "nao", nome, comp);
+        } else if (loteComando(&lote, "buscar", 1)) {
+            char chave[30];
+            const Item *achado;
+            snprintf(chave, sizeof(chave), "%s", nome);
+            if (estrutura == LOTE_VETOR) {
+                int pos = buscarSequencialVetor(itens, total, chave, &comp);
+                achado = pos != -1 ? &itens[pos] : NULL;
+            } else if (estrutura == LOTE_LISTA) {
+                No *no = buscarSequencialLista(lista.inicio, chave, &comp);
+                achado = no ? &no->dados : NULL;
+            } else {
+                achado = buscarSequencialDesenrolada(&desenrolada, chave, &comp);
+            }
+            relatarBuscaLote(comando, nome, achado, comp);
+        } else if (loteComando(&lote, "buscar-hash", 1) && estrutura != LOTE_DESENROLADA) {
+            const Item *achado;
+            if (estrutura == LOTE_VETOR) {
+                int pos = buscarHashVetor(&vetor, nome, &comp);
+                achado = pos != -1 ? &itens[pos] : NULL;
+            } else {
+                No *no = buscarHashLista(&lista, nome, &comp);
+                achado = no ? &no->dados : NULL;
+            }
+            relatarBuscaLote(comando, nome, achado, comp);
+        } else if (loteComando(&lote, "buscar-binaria", 1) && estrutura == LOTE_VETOR) {
+            char chave[30];
+            long compOrdenacao = 0;
+            int pos;
+            if (garantirOrdenacaoVetor(&vetor, &compOrdenacao)) indiceValido = 0;
+            snprintf(chave, sizeof(chave), "%s", nome);
+            pos = buscarBinariaVetor(itens, total, chave, &comp);
+            relatarBuscaLote(comando, nome, pos != -1 ? &itens[pos] : NULL, comp);
+        } else if (loteComando(&lote, "buscar-indice", 1) && estrutura == LOTE_VETOR) {
+            long compIndice = 0, compOrdenacao = 0, pos;
+            if (garantirOrdenacaoVetor(&vetor, &compOrdenacao)) indiceValido = 0;
+            if (!indiceValido) {
+                if (!ieConstruir(&indice, itens, (size_t)total, sizeof(Item), offsetof(Item, nome))) {
+                    loteErro(&lote, "memoria insuficiente para o indice");
+                    break;
+                }
+                indiceValido = 1;
+            }
+            pos = ieBuscar(&indice, nome, &compIndice);
+            relatarBuscaLote(comando, nome, pos != -1 ? &itens[pos] : NULL, compIndice);
+        } else if (loteComando(&lote, "listar", 0)) {
+            size_t i = 0;
+            if (estrutura == LOTE_VETOR) {
+                printf("ok\tlistar\t%d\n", total);
+                for (i = 0; i < (size_t)total; i++) listarItemLote(i, &itens[i]);
+            } else if (estrutura == LOTE_LISTA) {
+                printf("ok\tlistar\t%zu\n", lista.pool.emUso);
+                for (No *no = lista.inicio; no; no = no->proximo) listarItemLote(i++, &no->dados);
+            } else {
+                printf("ok\tlistar\t%zu\n", desenrolada.total);
+                for (NoDesenrolado *no = desenrolada.inicio; no; no = no->proximo)
+                    for (int k = 0; k < no->qtd; k++) listarItemLote(i++, &no->itens[k]);
+            }
+        } else {
+            loteErro(&lote, "comando desconhecido, incompleto ou nao disponivel em %s: %s",
+                     NOMES_ESTRUTURA_LOTE[estrutura], comando);
+        }
     }
+
+    ieLiberar(&indice);
+    liberarLista(&lista);
+    liberarListaDesenrolada(&desenrolada);
+    liberarMochilaVetor(&vetor);
+    return loteFechar(&lote);
 }
 
 // ===============================
-// FUNÇÃO AUXILIAR
+// BENCHMARK - VETOR x LISTA
 // ===============================
-void limparBuffer() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
-}
\ No newline at end of file
+// Executa a mesma carga nas duas mochilas para cada tamanho n:
+//   inserção de n itens, buscas sequenciais, ordenação + busca em ordem
+//   (binária no vetor, sequencial com parada antecipada na lista) e
+//   remoção por nome de n/10 itens.
+// Como não há contadores de hardware aqui, o custo de memória é estimado por
+// dois indicadores de percurso completo: linhas de cache de 64 bytes tocadas
+// e saltos não sequenciais (próxima linha diferente da seguinte na memória).
+
+typedef struct {
+    long linhas;
+    long saltos;
+    uintptr_t ultimaLinha;
+} ProxyCache;
+
+static void registrarAcesso(ProxyCache *p, const void *endereco, size_t tamanho) {
+    uintptr_t primeira = (uintptr_t) endereco / 64;
+    uintptr_t ultima = ((uintptr_t) endereco + tamanho - 1) / 64;
+    for (uintptr_t linha = primeira; linha <= ultima; linha++) {
+        if (linha == p->ultimaLinha)
+            continue;
+        p->linhas++;
+        if (linha != p->ultimaLinha + 1)
+            p->saltos++;
+        p->ultimaLinha = linha;
+    }
+}
+
+typedef struct {
+    double segundos;
+    long operacoes;
+    long comparacoes;
+} MedidaFase;
+
+static void imprimirLinhaComparativo(const char *fase, MedidaFase v, MedidaFase l) {
+    printf("  %-20s | %12.0f %10.1f | %12.0f %10.1f\n", fase,
+           v.segundos > 0.0 ? v.operacoes / v.segundos : 0.0,
+           v.operacoes ? (double) v.comparacoes / v.operacoes : 0.0,
+           l.segundos > 0.0 ? l.operacoes / l.segundos : 0.0,
+           l.operacoes ? (double) l.comparacoes / l.operacoes : 0.0);
+}
+
+static void nomeAleatorio(char nome[30]) {
+    for (int k = 0; k < 12; k++)
+        nome[k] = (char)('a' + rand() % 26);
+    nome[12] = '\0';
+}
+
+static int benchmarkTamanho(long n) {
+    const long buscas = 1000;
+    long remocoes = n / 10;
+    char (*nomes)[30] = malloc((size_t) n * sizeof(*nomes));
+    MochilaVetor mv;
+    MochilaLista ml;
+    MedidaFase v, l;
+    ProxyCache pv = {0, 0, 0}, pl = {0, 0, 0};
+    size_t memVetor, memLista;
+    double t;
+    int comp;
+
+    if (nomes == NULL) {
+        printf("Memoria insuficiente para n = %ld\n", n);
+        return 1;
+    }
+    srand(777);
+    for (long i = 0; i < n; i++)
+        nomeAleatorio(nomes[i]);
+
+    inicializarMochilaVetor(&mv);
+    inicializarMochilaLista(&ml);
+
+    printf("\nn = %ld\n", n);
+    printf("  %-20s | %12s %10s | %12s %10s\n", "operacao", "vetor op/s", "comps/op", "lista op/s", "comps/op");
+
+    // 1) inserção no final nas duas estruturas (o vetor deixa de se considerar
+    // ordenado, e a fase 3 mede a ordenação de verdade)
+    mv.ordenado = 0;
+    {
+        Item item;
+        strcpy(item.tipo, "municao");
+        v = (MedidaFase){0, n, 0};
+        t = tempoAtual();
+        for (long i = 0; i < n; i++) {
+            strcpy(item.nome, nomes[i]);
+            item.quantidade = (int)(i % 100);
+            adicionarItemVetor(&mv, &item, &v.comparacoes);
+        }
+        v.segundos = tempoAtual() - t;
+        t = tempoAtual();
+        for (long i = 0; i < n; i++) {
+            strcpy(item.nome, nomes[i]);
+            item.quantidade = (int)(i % 100);
+            adicionarItemLista(&ml, &item);
+        }
+        l = (MedidaFase){tempoAtual() - t, n, 0};
+        imprimirLinhaComparativo("insercao", v, l);
+    }
+    // 1b) inserção ordenada no vetor (só até LIMITE_INSERCAO_ORDENADA itens,
+    // depois dela o vetor volta a inserir no final); a lista não tem equivalente
+    {
+        MochilaVetor mo;
+        Item item;
+        long k = n < LIMITE_INSERCAO_ORDENADA ? n : LIMITE_INSERCAO_ORDENADA;
+        long comparacoes = 0;
+        inicializarMochilaVetor(&mo);
+        strcpy(item.tipo, "municao");
+        t = tempoAtual();
+        for (long i = 0; i < k; i++) {
+            strcpy(item.nome, nomes[i]);
+            item.quantidade = (int)(i % 100);
+            adicionarItemVetor(&mo, &item, &comparacoes);
+        }
+        t = tempoAtual() - t;
+        printf("  %-20s | %12.0f %10.1f | %12s %10s\n", "insercao ordenada",
+               t > 0.0 ? k / t : 0.0, k ? (double) comparacoes / k : 0.0, "-", "-");
+        liberarMochilaVetor(&mo);
+    }
+    memVetor = mv.itens.capacidade * sizeof(Item) + mv.indice.capacidade * sizeof(EntradaHash);
+    memLista = ml.pool.totalBlocos * sizeof(BlocoNos) + ml.indice.capacidade * sizeof(EntradaHash);
+
+    // 2) busca sequencial por nomes existentes
+    v = (MedidaFase){0, buscas, 0};
+    l = v;
+    t = tempoAtual();
+    for (long b = 0; b < buscas; b++) {
+        comp = 0;
+        buscarSequencialVetor(VD_DADOS(&mv.itens, Item), (int) mv.itens.tamanho, nomes[(b * 7919) % n], &comp);
+        v.comparacoes += comp;
+    }
+    v.segundos = tempoAtual() - t;
+    t = tempoAtual();
+    for (long b = 0; b < buscas; b++) {
+        comp = 0;
+        buscarSequencialLista(ml.inicio, nomes[(b * 7919) % n], &comp);
+        l.comparacoes += comp;
+    }
+    l.segundos = tempoAtual() - t;
+    imprimirLinhaComparativo("busca sequencial", v, l);
+
+    // indicadores de cache de um percurso completo (ordem de inserção)
+    {
+        Item *itens = VD_DADOS(&mv.itens, Item);
+        for (size_t i = 0; i < mv.itens.tamanho; i++)
+            registrarAcesso(&pv, &itens[i], sizeof(Item));
+        for (No *aux = ml.inicio; aux != NULL; aux = aux->proximo)
+            registrarAcesso(&pl, aux, sizeof(No));
+    }
+
+    // 3) ordenação por nome (uma "operação" = um item ordenado)
+    v = (MedidaFase){0, n, 0};
+    l = v;
+    t = tempoAtual();
+    garantirOrdenacaoVetor(&mv, &v.comparacoes);
+    v.segundos = tempoAtual() - t;
+    t = tempoAtual();
+    ordenarLista(&ml, &l.comparacoes);
+    l.segundos = tempoAtual() - t;
+    imprimirLinhaComparativo("ordenacao", v, l);
+
+    // 4) busca após ordenar
+    v = (MedidaFase){0, buscas, 0};
+    l = v;
+    t = tempoAtual();
+    for (long b = 0; b < buscas; b++) {
+        comp = 0;
+        buscarBinariaVetor(VD_DADOS(&mv.itens, Item), (int) mv.itens.tamanho, nomes[(b * 7919) % n], &comp);
+        v.comparacoes += comp;
+    }
+    v.segundos = tempoAtual() - t;
+    t = tempoAtual();
+    for (long b = 0; b < buscas; b++) {
+        comp = 0;
+        buscarOrdenadaLista(ml.inicio, nomes[(b * 7919) % n], &comp);
+        l.comparacoes += comp;
+    }
+    l.segundos = tempoAtual() - t;
+    imprimirLinhaComparativo("busca apos ordenar", v, l);
+
+    // 5) remoção por nome (índice hash nas duas versões)
+    v = (MedidaFase){0, remocoes, 0};
+    l = v;
+    t = tempoAtual();
+    for (long r = 0; r < remocoes; r++) {
+        comp = 0;
+        removerPorNomeVetor(&mv, nomes[r], &comp);
+        v.comparacoes += comp;
+    }
+    v.segundos = tempoAtual() - t;
+    t = tempoAtual();
+    for (long r = 0; r < remocoes; r++) {
+        comp = 0;
+        removerPorNomeLista(&ml, nomes[r], &comp);
+        l.comparacoes += comp;
+    }
+    l.segundos = tempoAtual() - t;
+    imprimirLinhaComparativo("remocao por nome", v, l);
+
+    printf("  %-20s | %23.1f | %23.1f\n", "memoria (bytes/item)",
+           (double) memVetor / n, (double) memLista / n);
+    printf("  %-20s | %23ld | %23ld\n", "linhas de cache", pv.linhas, pl.linhas);
+    printf("  %-20s | %22.1f%% | %22.1f%%\n", "saltos nao sequenc.",
+           pv.linhas ? 100.0 * pv.saltos / pv.linhas : 0.0,
+           pl.linhas ? 100.0 * pl.saltos / pl.linhas : 0.0);
+
+    liberarLista(&ml);
+    liberarMochilaVetor(&mv);
+    free(nomes);
+    return 0;
+}
+
+int benchmarkComparativo(long tamanhos[], int qtdTamanhos) {
+    printf("=== Benchmark: mochila com vetor x lista encadeada ===\n");
+    printf("(sizeof(Item) = %zu, sizeof(No) = %zu)\n", sizeof(Item), sizeof(No));
+    for (int i = 0; i < qtdTamanhos; i++) {
+        if (tamanhos[i] < 1)
+            continue;
+        if (benchmarkTamanho(tamanhos[i]) != 0)
+            return 1;
+    }
+    return 0;
+}
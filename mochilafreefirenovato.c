@@ -1,8 +1,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <sys/resource.h>
 
-#define MAX_ITENS 10
+#include "vetordinamico.h"
+#include "console.h"
+#include "lote.h"
+#include "instrumentacao.h"
 
 // ============================
 // Estrutura que representa um item do inventário
@@ -16,45 +21,59 @@ typedef struct {
 // ============================
 // Protótipos das funções
 // ============================
-void inserirItem(Item mochila[], int *totalItens);
-void removerItem(Item mochila[], int *totalItens);
-void listarItens(Item mochila[], int totalItens);
-void buscarItem(Item mochila[], int totalItens);
-void limparBuffer();
+void inserirItem(VetorDinamico *mochila);
+void removerItem(VetorDinamico *mochila);
+void listarItens(VetorDinamico *mochila);
+void buscarItem(VetorDinamico *mochila);
+long buscarIndicePorNome(VetorDinamico *mochila, const char *nome);
+int testeEstresse(long n);
+int executarLote(const char *caminho);
 
 // ============================
 // Função principal (menu interativo)
 // ============================
-int main() {
-    Item mochila[MAX_ITENS];
-    int totalItens = 0;
+int main(int argc, char *argv[]) {
+    VetorDinamico mochila;
     int opcao;
 
+    // Modo de teste de estresse: ./mochilafreefirenovato --stress [n]
+    if (argc > 1 && strcmp(argv[1], "--stress") == 0) {
+        long n = (argc > 2) ? atol(argv[2]) : 10000000L;
+        return testeEstresse(n);
+    }
+
+    // Modo lote: ./mochilafreefirenovato --lote arquivo (ou - para a entrada padrão)
+    if (argc > 2 && strcmp(argv[1], "--lote") == 0)
+        return executarLote(argv[2]);
+
+    consoleIniciar();
+    vdInicializar(&mochila, sizeof(Item));
+
     do {
-        printf("\n==============================\n");
-        printf("     MOCHILA DE SOBREVIVENCIA\n");
-        printf("==============================\n");
-        printf("1 - Adicionar item\n");
-        printf("2 - Remover item\n");
-        printf("3 - Listar itens\n");
-        printf("4 - Buscar item\n");
-        printf("0 - Sair\n");
-        printf("Escolha uma opcao: ");
-        scanf("%d", &opcao);
-        limparBuffer();
+        consoleInterface("\n==============================\n");
+        consoleInterface("     MOCHILA DE SOBREVIVENCIA\n");
+        consoleInterface("==============================\n");
+        consoleInterface("1 - Adicionar item\n");
+        consoleInterface("2 - Remover item\n");
+        consoleInterface("3 - Listar itens\n");
+        consoleInterface("4 - Buscar item\n");
+        consoleInterface("0 - Sair\n");
+        consoleInterface("Escolha uma opcao: ");
+        opcao = -1;
+        if (consoleLerInteiro(&opcao) < 0) opcao = 0; // fim da entrada: sai
 
         switch (opcao) {
             case 1:
-                inserirItem(mochila, &totalItens);
+                inserirItem(&mochila);
                 break;
             case 2:
-                removerItem(mochila, &totalItens);
+                removerItem(&mochila);
                 break;
             case 3:
-                listarItens(mochila, totalItens);
+                listarItens(&mochila);
                 break;
             case 4:
-                buscarItem(mochila, totalItens);
+                buscarItem(&mochila);
                 break;
             case 0:
                 printf("\nEncerrando o sistema...\n");
@@ -65,122 +84,242 @@ int main() {
 
     } while (opcao != 0);
 
+    vdLiberar(&mochila);
     return 0;
 }
 
 // ============================
 // Função para inserir novo item na mochila
 // ============================
-void inserirItem(Item mochila[], int *totalItens) {
-    if (*totalItens >= MAX_ITENS) {
-        printf("\nA mochila esta cheia! Nao e possivel adicionar mais itens.\n");
-        return;
-    }
-
+void inserirItem(VetorDinamico *mochila) {
     Item novoItem;
 
-    printf("\nDigite o nome do item: ");
-    fgets(novoItem.nome, sizeof(novoItem.nome), stdin);
-    novoItem.nome[strcspn(novoItem.nome, "\n")] = '\0'; // Remove o \n
+    consoleInterface("\nDigite o nome do item: ");
+    consoleLerLinha(novoItem.nome, sizeof(novoItem.nome));
 
-    printf("Digite o tipo do item (arma, municao, cura, etc): ");
-    fgets(novoItem.tipo, sizeof(novoItem.tipo), stdin);
-    novoItem.tipo[strcspn(novoItem.tipo, "\n")] = '\0';
+    consoleInterface("Digite o tipo do item (arma, municao, cura, etc): ");
+    consoleLerLinha(novoItem.tipo, sizeof(novoItem.tipo));
 
-    printf("Digite a quantidade: ");
-    scanf("%d", &novoItem.quantidade);
-    limparBuffer();
+    consoleInterface("Digite a quantidade: ");
+    novoItem.quantidade = 0;
+    consoleLerInteiro(&novoItem.quantidade);
 
-    mochila[*totalItens] = novoItem;
-    (*totalItens)++;
+    if (vdAdicionar(mochila, &novoItem) == NULL) {
+        printf("\nMemoria insuficiente! Nao e possivel adicionar mais itens.\n");
+        return;
+    }
 
     printf("\nItem adicionado com sucesso!\n");
-    listarItens(mochila, *totalItens);
+    if (consoleInterativo()) listarItens(mochila); // no modo silencioso só lista quem pede (opção 3)
 }
 
 // ============================
 // Função para remover item pelo nome
 // ============================
-void removerItem(Item mochila[], int *totalItens) {
-    if (*totalItens == 0) {
+void removerItem(VetorDinamico *mochila) {
+    if (mochila->tamanho == 0) {
         printf("\nA mochila esta vazia.\n");
         return;
     }
 
     char nomeRemover[30];
-    printf("\nDigite o nome do item a ser removido: ");
-    fgets(nomeRemover, sizeof(nomeRemover), stdin);
-    nomeRemover[strcspn(nomeRemover, "\n")] = '\0';
-
-    int encontrado = 0;
-    for (int i = 0; i < *totalItens; i++) {
-        if (strcmp(mochila[i].nome, nomeRemover) == 0) {
-            // Move os itens seguintes para preencher o espaço
-            for (int j = i; j < *totalItens - 1; j++) {
-                mochila[j] = mochila[j + 1];
-            }
-            (*totalItens)--;
-            encontrado = 1;
-            printf("\nItem '%s' removido com sucesso!\n", nomeRemover);
-            break;
-        }
-    }
+    consoleInterface("\nDigite o nome do item a ser removido: ");
+    consoleLerLinha(nomeRemover, sizeof(nomeRemover));
 
-    if (!encontrado) {
+    long pos = buscarIndicePorNome(mochila, nomeRemover);
+    if (pos != -1) {
+        // Move os itens seguintes para preencher o espaço
+        vdRemover(mochila, (size_t)pos);
+        printf("\nItem '%s' removido com sucesso!\n", nomeRemover);
+    } else {
         printf("\nItem nao encontrado!\n");
     }
 
-    listarItens(mochila, *totalItens);
+    if (consoleInterativo()) listarItens(mochila);
 }
 
 // ============================
 // Função para listar todos os itens da mochila
 // ============================
-void listarItens(Item mochila[], int totalItens) {
+void listarItens(VetorDinamico *mochila) {
+    Item *itens = VD_DADOS(mochila, Item);
     printf("\n======= ITENS NA MOCHILA =======\n");
 
-    if (totalItens == 0) {
+    if (mochila->tamanho == 0) {
         printf("Nenhum item cadastrado.\n");
         return;
     }
 
-    for (int i = 0; i < totalItens; i++) {
-        printf("%d. Nome: %s | Tipo: %s | Quantidade: %d\n",
-               i + 1, mochila[i].nome, mochila[i].tipo, mochila[i].quantidade);
+    for (size_t i = 0; i < mochila->tamanho; i++) {
+        printf("%zu. Nome: %s | Tipo: %s | Quantidade: %d\n",
+               i + 1, itens[i].nome, itens[i].tipo, itens[i].quantidade);
     }
 }
 
 // ============================
 // Função de busca sequencial por nome
 // ============================
-void buscarItem(Item mochila[], int totalItens) {
-    if (totalItens == 0) {
+void buscarItem(VetorDinamico *mochila) {
+    if (mochila->tamanho == 0) {
         printf("\nA mochila esta vazia.\n");
         return;
     }
 
     char nomeBusca[30];
-    printf("\nDigite o nome do item a buscar: ");
-    fgets(nomeBusca, sizeof(nomeBusca), stdin);
-    nomeBusca[strcspn(nomeBusca, "\n")] = '\0';
-
-    for (int i = 0; i < totalItens; i++) {
-        if (strcmp(mochila[i].nome, nomeBusca) == 0) {
-            printf("\nItem encontrado:\n");
-            printf("Nome: %s\n", mochila[i].nome);
-            printf("Tipo: %s\n", mochila[i].tipo);
-            printf("Quantidade: %d\n", mochila[i].quantidade);
-            return;
-        }
+    consoleInterface("\nDigite o nome do item a buscar: ");
+    consoleLerLinha(nomeBusca, sizeof(nomeBusca));
+
+    long pos = buscarIndicePorNome(mochila, nomeBusca);
+    if (pos != -1) {
+        Item *item = &VD_DADOS(mochila, Item)[pos];
+        printf("\nItem encontrado:\n");
+        printf("Nome: %s\n", item->nome);
+        printf("Tipo: %s\n", item->tipo);
+        printf("Quantidade: %d\n", item->quantidade);
+        return;
     }
 
     printf("\nItem nao encontrado!\n");
 }
 
 // ============================
-// Função auxiliar para limpar o buffer do teclado
+// Busca sequencial: retorna a posição do item ou -1
+// ============================
+long buscarIndicePorNome(VetorDinamico *mochila, const char *nome) {
+    INSTR_CRONOMETRAR("buscarIndicePorNome");
+    Item *itens = VD_DADOS(mochila, Item);
+    for (size_t i = 0; i < mochila->tamanho; i++) {
+        INSTR_CONTAR("busca.comparacoes");
+        if (strcmp(itens[i].nome, nome) == 0)
+            return (long)i;
+    }
+    return -1;
+}
+
+// ============================
+// Modo lote: os comandos do menu lidos de um arquivo (ver lote.h)
+//     adicionar <nome> <tipo> <quantidade>   -> ok adicionar <total de itens>
+//     remover <nome>                         -> ok remover <posição> | nao remover <nome>
+//     buscar <nome>                          -> ok buscar <posição> <nome> <tipo> <qtd> | nao buscar <nome>
+//     listar                                 -> ok listar <n>, depois n linhas "item <i> <nome> <tipo> <qtd>"
+// ============================
+int executarLote(const char *caminho) {
+    VetorDinamico mochila;
+    Lote lote;
+
+    if (!loteAbrir(&lote, caminho)) return 1;
+    vdInicializar(&mochila, sizeof(Item));
+
+    while (loteProximo(&lote)) {
+        Item *itens = VD_DADOS(&mochila, Item);
+        long quantidade, pos;
+
+        if (loteComando(&lote, "adicionar", 3)) {
+            Item novo;
+            if (!loteInteiro(&lote, 3, &quantidade)) {
+                loteErro(&lote, "quantidade invalida: %s", loteCampo(&lote, 3));
+                continue;
+            }
+            snprintf(novo.nome, sizeof(novo.nome), "%s", loteCampo(&lote, 1));
+            snprintf(novo.tipo, sizeof(novo.tipo), "%s", loteCampo(&lote, 2));
+            novo.quantidade = (int) quantidade;
+            if (vdAdicionar(&mochila, &novo) == NULL) {
+                loteErro(&lote, "memoria insuficiente");
+                break;
+            }
+            printf("ok\tadicionar\t%zu\n", mochila.tamanho);
+        } else if (loteComando(&lote, "remover", 1)) {
+            pos = buscarIndicePorNome(&mochila, loteCampo(&lote, 1));
+            if (pos != -1) {
+                vdRemover(&mochila, (size_t)pos);
+                printf("ok\tremover\t%ld\n", pos);
+            } else {
+                printf("nao\tremover\t%s\n", loteCampo(&lote, 1));
+            }
+        } else if (loteComando(&lote, "buscar", 1)) {
+            pos = buscarIndicePorNome(&mochila, loteCampo(&lote, 1));
+            if (pos != -1)
+                printf("ok\tbuscar\t%ld\t%s\t%s\t%d\n", pos, itens[pos].nome, itens[pos].tipo, itens[pos].quantidade);
+            else
+                printf("nao\tbuscar\t%s\n", loteCampo(&lote, 1));
+        } else if (loteComando(&lote, "listar", 0)) {
+            printf("ok\tlistar\t%zu\n", mochila.tamanho);
+            for (size_t i = 0; i < mochila.tamanho; i++)
+                printf("item\t%zu\t%s\t%s\t%d\n", i, itens[i].nome, itens[i].tipo, itens[i].quantidade);
+        } else {
+            loteErro(&lote, "comando desconhecido ou incompleto: %s", loteCampo(&lote, 0));
+        }
+    }
+
+    vdLiberar(&mochila);
+    return loteFechar(&lote);
+}
+
+// ============================
+// Teste de estresse do vetor dinâmico: insere n itens, faz buscas
+// sequenciais espalhadas pelo vetor, remove todos e mostra alocações/pico
 // ============================
-void limparBuffer() {
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
+static double segundosDesde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+int testeEstresse(long n) {
+    VetorDinamico mochila;
+    Item item;
+    clock_t inicio;
+    long encontrados = 0;
+    const long buscas = 100;
+    struct rusage uso;
+
+    if (n < 1) n = 1;
+    vdInicializar(&mochila, sizeof(Item));
+    printf("=== Teste de estresse: %ld itens (sizeof(Item) = %zu bytes) ===\n", n, sizeof(Item));
+
+    strcpy(item.tipo, "municao");
+    inicio = clock();
+    for (long i = 0; i < n; i++) {
+        snprintf(item.nome, sizeof(item.nome), "item%09ld", i);
+        item.quantidade = (int)(i % 100);
+        if (vdAdicionar(&mochila, &item) == NULL) {
+            printf("Memoria insuficiente apos %ld itens.\n", i);
+            vdLiberar(&mochila);
+            return 1;
+        }
+    }
+    printf("Insercao : %8.3f s | alocacoes: %zu | capacidade: %zu\n",
+           segundosDesde(inicio), mochila.alocacoes, mochila.capacidade);
+
+    inicio = clock();
+    for (long b = 0; b < buscas; b++) {
+        char nome[30];
+        snprintf(nome, sizeof(nome), "item%09ld", (b * 7919) % n);
+        if (buscarIndicePorNome(&mochila, nome) != -1) encontrados++;
+    }
+    printf("Busca    : %8.3f s | %ld buscas sequenciais, %ld encontradas\n",
+           segundosDesde(inicio), buscas, encontrados);
+
+    inicio = clock();
+    while (mochila.tamanho > (size_t)(n / 2))
+        vdRemover(&mochila, mochila.tamanho - 1);
+    vdEncolher(&mochila);
+    printf("Remocao  : %8.3f s | metade removida, capacidade apos encolher: %zu\n",
+           segundosDesde(inicio), mochila.capacidade);
+
+    // Remoções do início exercitam o deslocamento (memmove) dos demais itens
+    inicio = clock();
+    for (long r = 0; r < 10 && mochila.tamanho > 0; r++)
+        vdRemover(&mochila, 0);
+    printf("Remocao  : %8.3f s | 10 remocoes do inicio (com deslocamento)\n", segundosDesde(inicio));
+
+    while (mochila.tamanho > 0)
+        vdRemover(&mochila, mochila.tamanho - 1);
+    vdEncolher(&mochila);
+
+    getrusage(RUSAGE_SELF, &uso);
+    printf("Total de (re)alocacoes : %zu\n", mochila.alocacoes);
+    printf("Pico do vetor          : %.1f MiB\n", mochila.bytesPico / (1024.0 * 1024.0));
+    printf("Pico do processo (RSS) : %.1f MiB\n", uso.ru_maxrss / 1024.0);
+
+    vdLiberar(&mochila);
+    return 0;
 }
@@ -0,0 +1,304 @@
+/*
+  randomizador.h - Sorteio das peças do Tetris (sementes reprodutíveis)
+  ---------------------------------------------------------------------
+  Substitui o tipos[rand() % 4] de gerarPeca(). O rand() % n tem viés de
+  módulo, não permite fixar estados independentes (uma semente por thread ou
+  por simulação) e não dá nenhuma garantia de justiça na sequência.
+
+  Gerador base: xoshiro256** com estado semeado por splitmix64; números
+  limitados a [0, n) pelo método de Lemire (multiplicação + rejeição), sem viés.
+
+  Modos:
+  - RAND_UNIFORME:  cada peça independente, todas com a mesma chance.
+  - RAND_SACOLA:    "7-bag": embaralha uma sacola com um de cada tipo e a
+                    esvazia antes de embaralhar outra (seca máxima de 12 peças).
+  - RAND_HISTORICO: estilo TGM: guarda as 4 últimas peças e sorteia de novo
+                    (até HISTORICO_TENTATIVAS vezes) se a peça estiver nelas.
+                    A distribuição resultante só depende de QUAIS tipos estão no
+                    histórico, então é pré-calculada (uma tabela de alias por
+                    conjunto) e cada peça custa um único sorteio, sem repetições.
+  - RAND_PONDERADO: cada tipo com peso próprio, sorteio O(1) pelo método
+                    do alias (Vose).
+
+  Uso:
+      Randomizador r;
+      randomizadorInicializar(&r, RAND_SACOLA, "IOTLJSZ", semente);
+      char tipo = randomizadorProxima(&r);
+      randomizadorPreencher(&r, tipos, n);        // em lote
+      randomizadorDefinirPesos(&r, pesos);        // só para RAND_PONDERADO
+      randomizadorSalvar(&r, &e); ... randomizadorRestaurar(&r, &e); // volta no tempo
+
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef RANDOMIZADOR_H
+#define RANDOMIZADOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define MAX_TIPOS_RANDOMIZADOR 7
+#define TAMANHO_HISTORICO 4 /* cabe num uint32_t, um byte por peça */
+#define HISTORICO_TENTATIVAS 6
+
+typedef enum {
+    RAND_UNIFORME,
+    RAND_SACOLA,
+    RAND_HISTORICO,
+    RAND_PONDERADO
+} ModoRandomizador;
+
+typedef struct {
+    uint64_t s[4];                              /* estado do xoshiro256** */
+    ModoRandomizador modo;
+    int numTipos;
+    char tipos[MAX_TIPOS_RANDOMIZADOR];
+    char sacola[MAX_TIPOS_RANDOMIZADOR];        /* RAND_SACOLA */
+    int restantesSacola;
+    uint32_t historico;                         /* RAND_HISTORICO: índices das 4 últimas,
+                                                   um por byte (o mais novo no byte 0) */
+    /* alias por conjunto de tipos no histórico (só montado no modo histórico);
+       cada entrada junta limiar (32 bits de cima) e alias (de baixo) para que o
+       sorteio dependa de uma só leitura de memória */
+    uint64_t tabelaHistorico[1 << MAX_TIPOS_RANDOMIZADOR][MAX_TIPOS_RANDOMIZADOR];
+    uint32_t limiarAlias[MAX_TIPOS_RANDOMIZADOR]; /* RAND_PONDERADO: chance de ficar */
+    uint8_t alias[MAX_TIPOS_RANDOMIZADOR];      /*   na coluna ou ir para o alias */
+} Randomizador;
+
+/* Parte do estado que muda a cada sorteio (o resto são tabelas fixas depois
+   da inicialização): salvar e restaurar só isto volta a sequência a um ponto
+   anterior, sem copiar as tabelas */
+typedef struct {
+    uint64_t s[4];
+    uint32_t historico;
+    int restantesSacola;
+    char sacola[MAX_TIPOS_RANDOMIZADOR];
+} EstadoSorteio;
+
+static const char *NOMES_MODO_RANDOMIZADOR[] = {"uniforme", "sacola", "historico", "ponderado"};
+
+static inline uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rndRotacionar(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+/* Próximo número de 64 bits (xoshiro256**) */
+static inline uint64_t rndProximo(Randomizador *r) {
+    uint64_t *s = r->s;
+    uint64_t resultado = rndRotacionar(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rndRotacionar(s[3], 45);
+    return resultado;
+}
+
+/* Inteiro uniforme em [0, n) sem viés de módulo (Lemire) */
+static inline uint32_t rndLimitado(Randomizador *r, uint32_t n) {
+    uint64_t m = (uint64_t)(uint32_t)(rndProximo(r) >> 32) * n;
+    uint32_t baixo = (uint32_t)m;
+    if (baixo < n) {
+        uint32_t limiar = (uint32_t)-n % n;
+        while (baixo < limiar) {
+            m = (uint64_t)(uint32_t)(rndProximo(r) >> 32) * n;
+            baixo = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+static inline void randomizadorSemear(Randomizador *r, uint64_t semente) {
+    int i;
+    for (i = 0; i < 4; i++) r->s[i] = splitmix64(&semente);
+    r->restantesSacola = 0;
+    /* histórico começa cheio do último tipo (Z em "IOTLJSZ"), como no TGM,
+       para evitar essa peça logo de cara */
+    r->historico = r->numTipos > 0 ? 0x01010101u * (uint32_t)(r->numTipos - 1) : 0;
+}
+
+/* Tabela de alias (Vose) para n pesos. Retorna 0 se algum peso é negativo
+   ou todos são zero. */
+static inline int rndMontarAlias(const double *pesos, int n, uint32_t *limiar, uint8_t *alias) {
+    double escala[MAX_TIPOS_RANDOMIZADOR], soma = 0;
+    int pequenos[MAX_TIPOS_RANDOMIZADOR], grandes[MAX_TIPOS_RANDOMIZADOR];
+    int nP = 0, nG = 0, i;
+
+    for (i = 0; i < n; i++) {
+        if (pesos[i] < 0) return 0;
+        soma += pesos[i];
+    }
+    if (soma <= 0) return 0;
+    for (i = 0; i < n; i++) {
+        escala[i] = pesos[i] * n / soma;
+        if (escala[i] < 1.0) pequenos[nP++] = i;
+        else grandes[nG++] = i;
+    }
+    while (nP > 0 && nG > 0) {
+        int p = pequenos[--nP], g = grandes[--nG];
+        limiar[p] = (uint32_t)(escala[p] * 4294967295.0);
+        alias[p] = (uint8_t)g;
+        escala[g] -= 1.0 - escala[p];
+        if (escala[g] < 1.0) pequenos[nP++] = g;
+        else grandes[nG++] = g;
+    }
+    while (nG > 0) { i = grandes[--nG]; limiar[i] = UINT32_MAX; alias[i] = (uint8_t)i; }
+    while (nP > 0) { i = pequenos[--nP]; limiar[i] = UINT32_MAX; alias[i] = (uint8_t)i; }
+    return 1;
+}
+
+/* Sorteio O(1) numa tabela de alias: 32 bits de cima escolhem a coluna,
+   32 de baixo decidem entre ela e o seu alias */
+static inline uint32_t rndAlias(uint64_t x, int n, const uint32_t *limiar, const uint8_t *alias) {
+    uint32_t coluna = (uint32_t)(((x >> 32) * (uint64_t)n) >> 32);
+    return (uint32_t)x <= limiar[coluna] ? coluna : alias[coluna];
+}
+
+/* Para cada conjunto H de tipos no histórico: um tipo fora de H sai na
+   tentativa k com chance (|H|/n)^k / n (k = 0..T-1); um tipo de H só sai se as
+   T-1 primeiras tentativas caírem em H e a última for ele: (|H|/n)^(T-1) / n. */
+static inline void rndMontarHistorico(Randomizador *r) {
+    int n = r->numTipos;
+    uint32_t mascara;
+    for (mascara = 0; mascara < (1u << n); mascara++) {
+        double pesos[MAX_TIPOS_RANDOMIZADOR], q = (double)__builtin_popcount(mascara) / n;
+        double fora = 0, dentro = 1, potencia = 1;
+        int k, t;
+        for (k = 0; k < HISTORICO_TENTATIVAS; k++) {
+            fora += potencia;
+            if (k < HISTORICO_TENTATIVAS - 1) potencia *= q;
+        }
+        dentro = potencia;
+        uint32_t limiar[MAX_TIPOS_RANDOMIZADOR];
+        uint8_t alias[MAX_TIPOS_RANDOMIZADOR];
+        for (t = 0; t < n; t++) pesos[t] = ((mascara >> t) & 1) ? dentro : fora;
+        rndMontarAlias(pesos, n, limiar, alias);
+        for (t = 0; t < n; t++)
+            r->tabelaHistorico[mascara][t] = ((uint64_t)limiar[t] << 32) | alias[t];
+    }
+}
+
+/* Pesos iguais para todos os tipos (alias trivial) */
+static inline void randomizadorPesosIguais(Randomizador *r) {
+    int i;
+    for (i = 0; i < r->numTipos; i++) {
+        r->limiarAlias[i] = UINT32_MAX;
+        r->alias[i] = (uint8_t)i;
+    }
+}
+
+/* tipos: string com os tipos possíveis (ex.: "IOTLJSZ"), até MAX_TIPOS_RANDOMIZADOR */
+static inline void randomizadorInicializar(Randomizador *r, ModoRandomizador modo,
+                                           const char *tipos, uint64_t semente) {
+    memset(r, 0, sizeof(*r));
+    r->modo = modo;
+    r->numTipos = (int)strlen(tipos);
+    if (r->numTipos > MAX_TIPOS_RANDOMIZADOR) r->numTipos = MAX_TIPOS_RANDOMIZADOR;
+    memcpy(r->tipos, tipos, (size_t)r->numTipos);
+    randomizadorPesosIguais(r);
+    randomizadorSemear(r, semente);
+    if (modo == RAND_HISTORICO) rndMontarHistorico(r);
+}
+
+/* Define os pesos (um por tipo, na ordem de 'tipos') e monta a tabela de alias.
+   Retorna 0 se algum peso é negativo ou todos são zero. */
+static inline int randomizadorDefinirPesos(Randomizador *r, const double *pesos) {
+    return rndMontarAlias(pesos, r->numTipos, r->limiarAlias, r->alias);
+}
+
+/* Fisher-Yates da sacola com um de cada tipo */
+static inline void randomizadorNovaSacola(Randomizador *r) {
+    int i;
+    memcpy(r->sacola, r->tipos, (size_t)r->numTipos);
+    for (i = r->numTipos - 1; i > 0; i--) {
+        int j = (int)rndLimitado(r, (uint32_t)i + 1);
+        char t = r->sacola[i];
+        r->sacola[i] = r->sacola[j];
+        r->sacola[j] = t;
+    }
+    r->restantesSacola = r->numTipos;
+}
+
+/* Índice do próximo tipo no modo histórico (um sorteio na tabela do conjunto atual) */
+static inline uint32_t randomizadorHistorico(Randomizador *r) {
+    uint32_t h = r->historico;
+    uint32_t m = (1u << (h & 0xFF)) | (1u << ((h >> 8) & 0xFF)) |
+                 (1u << ((h >> 16) & 0xFF)) | (1u << (h >> 24));
+    uint64_t x = rndProximo(r);
+    uint32_t coluna = (uint32_t)(((x >> 32) * (uint64_t)r->numTipos) >> 32);
+    uint64_t entrada = r->tabelaHistorico[m][coluna];
+    uint32_t t = (uint32_t)x <= (uint32_t)(entrada >> 32) ? coluna : (uint32_t)(entrada & 0xFF);
+    r->historico = (h << 8) | t;
+    return t;
+}
+
+static inline char randomizadorProxima(Randomizador *r) {
+    switch (r->modo) {
+        case RAND_SACOLA:
+            if (r->restantesSacola == 0) randomizadorNovaSacola(r);
+            return r->sacola[--r->restantesSacola];
+        case RAND_HISTORICO:
+            return r->tipos[randomizadorHistorico(r)];
+        case RAND_PONDERADO:
+            return r->tipos[rndAlias(rndProximo(r), r->numTipos, r->limiarAlias, r->alias)];
+        case RAND_UNIFORME:
+        default:
+            return r->tipos[rndLimitado(r, (uint32_t)r->numTipos)];
+    }
+}
+
+/* Gera n tipos em 'saida' (o modo é decidido uma vez, fora do laço) */
+static inline void randomizadorPreencher(Randomizador *r, char *saida, size_t n) {
+    size_t i = 0;
+    switch (r->modo) {
+        case RAND_SACOLA:
+            while (i < n) {
+                size_t k;
+                if (r->restantesSacola == 0) randomizadorNovaSacola(r);
+                k = (size_t)r->restantesSacola < n - i ? (size_t)r->restantesSacola : n - i;
+                while (k--) saida[i++] = r->sacola[--r->restantesSacola];
+            }
+            break;
+        case RAND_UNIFORME:
+            for (; i < n; i++) saida[i] = r->tipos[rndLimitado(r, (uint32_t)r->numTipos)];
+            break;
+        case RAND_HISTORICO:
+            for (; i < n; i++) saida[i] = r->tipos[randomizadorHistorico(r)];
+            break;
+        default:
+            for (; i < n; i++) saida[i] = randomizadorProxima(r);
+    }
+}
+
+static inline void randomizadorSalvar(const Randomizador *r, EstadoSorteio *e) {
+    memcpy(e->s, r->s, sizeof(e->s));
+    e->historico = r->historico;
+    e->restantesSacola = r->restantesSacola;
+    memcpy(e->sacola, r->sacola, sizeof(e->sacola));
+}
+
+static inline void randomizadorRestaurar(Randomizador *r, const EstadoSorteio *e) {
+    memcpy(r->s, e->s, sizeof(r->s));
+    r->historico = e->historico;
+    r->restantesSacola = e->restantesSacola;
+    memcpy(r->sacola, e->sacola, sizeof(r->sacola));
+}
+
+/* Modo pelo nome ("uniforme", "sacola", "historico", "ponderado"); -1 se desconhecido */
+static inline int randomizadorModoPorNome(const char *nome) {
+    int i;
+    for (i = 0; i < 4; i++)
+        if (strcmp(nome, NOMES_MODO_RANDOMIZADOR[i]) == 0) return i;
+    return -1;
+}
+
+#endif /* RANDOMIZADOR_H */
@@ -0,0 +1,319 @@
+/*
+  renderizador.h - Renderizador diferencial para terminal (ANSI)
+  --------------------------------------------------------------
+  A tela é montada num quadro em memória (uma célula por coluna do terminal)
+  e comparada com o quadro anterior: só as células que mudaram são enviadas,
+  com movimentos de cursor ANSI, tudo num único write().
+
+  - Célula = uint32_t com o código Unicode (21 bits de baixo) e a cor (8 bits
+    de cima); linhas inteiras iguais são puladas com memcmp.
+  - Dentro de uma linha, um trecho inalterado curto entre duas mudanças é
+    reenviado em vez de mover o cursor (mover custa de 6 a 8 bytes).
+  - Emoji (a partir de U+1F000) ocupa duas células; a segunda fica marcada
+    como continuação. O seletor de variação U+FE0F é descartado, então
+    símbolos como ⚠ saem na forma de texto, com largura 1.
+  - A primeira apresentação (ou depois de renderizadorInvalidar) limpa a tela
+    e envia só o que não é espaço em branco.
+  - Opcionalmente, uma linha de entrada abaixo do quadro: a cada apresentação
+    ela é apagada (junto com o que o eco do terminal deixou abaixo dela) e
+    recebe o texto do prompt, com o cursor no fim.
+
+  Uso:
+      Renderizador *r = criarRenderizador(STDOUT_FILENO, 80, 22);
+      renderizadorLimpar(r);
+      renderizadorTexto(r, linha, coluna, COR_PADRAO, "Linhas: %d", n);
+      renderizadorEntrada(r, "Escolha: ");   // opcional
+      renderizadorApresentar(r);             // um write() só com as diferenças
+      ...
+      liberarRenderizador(r);                // restaura cor e cursor
+
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef RENDERIZADOR_H
+#define RENDERIZADOR_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Cores (bits 24-31 da célula): 0 = padrão do terminal, 1-7 = ANSI 31-37,
+   COR_BRILHANTE soma 60 (ANSI 91-97) */
+#define COR_PADRAO    0
+#define COR_VERMELHO  1
+#define COR_VERDE     2
+#define COR_AMARELO   3
+#define COR_AZUL      4
+#define COR_MAGENTA   5
+#define COR_CIANO     6
+#define COR_BRANCO    7
+#define COR_BRILHANTE 8
+
+#define RD_CONTINUACAO 0u               /* segunda célula de um caractere largo */
+#define RD_CELULA(ch, cor) ((uint32_t)(ch) | ((uint32_t)(cor) << 24))
+#define RD_CARACTERE(c) ((c) & 0x1FFFFFu)
+#define RD_COR(c) ((int)((c) >> 24))
+#define RD_BRANCO RD_CELULA(' ', COR_PADRAO)
+#define RD_SALTO_MAXIMO 4               /* até quantas células inalteradas reenviar em vez de mover */
+
+typedef struct {
+    int fd;
+    int largura, altura;
+    uint32_t *atual, *anterior;
+    char *saida;                        /* bytes de um quadro, enviados num write() */
+    size_t tamanho, capacidade;
+    int valido;                         /* 'anterior' corresponde ao que está na tela */
+    int cursorLinha, cursorColuna;      /* posição do cursor do terminal (-1: desconhecida) */
+    int corAtual;                       /* cor ativa no terminal (-1: desconhecida) */
+    int comEntrada;
+    char entrada[160];                  /* texto da linha de entrada */
+    long quadros, bytesTotal, bytesUltimo, celulasUltimo;
+} Renderizador;
+
+static inline Renderizador *criarRenderizador(int fd, int largura, int altura) {
+    Renderizador *r = (Renderizador *)calloc(1, sizeof(Renderizador));
+    size_t celulas = (size_t)largura * altura;
+    if (!r) return NULL;
+    r->fd = fd;
+    r->largura = largura;
+    r->altura = altura;
+    r->atual = (uint32_t *)malloc(celulas * sizeof(uint32_t));
+    r->anterior = (uint32_t *)malloc(celulas * sizeof(uint32_t));
+    /* pior caso: cor + 4 bytes de UTF-8 por célula e um movimento de cursor por célula */
+    r->capacidade = celulas * 24 + 512;
+    r->saida = (char *)malloc(r->capacidade);
+    if (!r->atual || !r->anterior || !r->saida) {
+        free(r->atual);
+        free(r->anterior);
+        free(r->saida);
+        free(r);
+        return NULL;
+    }
+    for (size_t i = 0; i < celulas; i++) r->atual[i] = RD_BRANCO;
+    return r;
+}
+
+/* Próxima apresentação redesenha a tela inteira */
+static inline void renderizadorInvalidar(Renderizador *r) { r->valido = 0; }
+
+static inline void renderizadorLimpar(Renderizador *r) {
+    size_t celulas = (size_t)r->largura * r->altura;
+    for (size_t i = 0; i < celulas; i++) r->atual[i] = RD_BRANCO;
+}
+
+static inline void renderizadorCelula(Renderizador *r, int linha, int coluna, uint32_t ch, int cor) {
+    if (linha < 0 || linha >= r->altura || coluna < 0 || coluna >= r->largura) return;
+    if (ch == ' ') cor = COR_PADRAO; /* sem cor de fundo, espaço é igual em qualquer cor */
+    r->atual[linha * r->largura + coluna] = RD_CELULA(ch, cor);
+}
+
+/* Decodifica um caractere UTF-8; retorna quantos bytes ele ocupa (1 se inválido) */
+static inline int rdDecodificar(const unsigned char *s, uint32_t *ch) {
+    if (s[0] < 0x80) { *ch = s[0]; return 1; }
+    if ((s[0] & 0xE0) == 0xC0 && (s[1] & 0xC0) == 0x80) {
+        *ch = ((uint32_t)(s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+        return 2;
+    }
+    if ((s[0] & 0xF0) == 0xE0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80) {
+        *ch = ((uint32_t)(s[0] & 0x0F) << 12) | ((uint32_t)(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+        return 3;
+    }
+    if ((s[0] & 0xF8) == 0xF0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80 &&
+        (s[3] & 0xC0) == 0x80) {
+        *ch = ((uint32_t)(s[0] & 0x07) << 18) | ((uint32_t)(s[1] & 0x3F) << 12) |
+              ((uint32_t)(s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+        return 4;
+    }
+    *ch = '?';
+    return 1;
+}
+
+/* Escreve texto formatado a partir de (linha, coluna), cortando na borda direita.
+   Retorna a coluna seguinte ao último caractere escrito. */
+static inline int renderizadorTexto(Renderizador *r, int linha, int coluna, int cor,
+                                    const char *formato, ...) {
+    char texto[512];
+    const unsigned char *p = (const unsigned char *)texto;
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(texto, sizeof(texto), formato, args);
+    va_end(args);
+    if (linha < 0 || linha >= r->altura) return coluna;
+
+    while (*p && coluna < r->largura) {
+        uint32_t ch;
+        p += rdDecodificar(p, &ch);
+        if (ch == 0xFE0F || ch == '\n' || ch == '\r') continue;
+        if (ch >= 0x1F000) { /* emoji: duas células */
+            if (coluna + 1 >= r->largura) break;
+            renderizadorCelula(r, linha, coluna++, ch, cor);
+            renderizadorCelula(r, linha, coluna++, RD_CONTINUACAO, cor);
+        } else {
+            renderizadorCelula(r, linha, coluna++, ch, cor);
+        }
+    }
+    return coluna;
+}
+
+/* Texto da linha de entrada (logo abaixo do quadro) */
+static inline void renderizadorEntrada(Renderizador *r, const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(r->entrada, sizeof(r->entrada), formato, args);
+    va_end(args);
+    r->comEntrada = 1;
+}
+
+/* ---- montagem dos bytes de saída ---- */
+
+static inline void rdBytes(Renderizador *r, const char *s, size_t n) {
+    memcpy(r->saida + r->tamanho, s, n);
+    r->tamanho += n;
+}
+
+static inline void rdNumero(Renderizador *r, int n) {
+    char d[12];
+    int k = 0;
+    do { d[k++] = (char)('0' + n % 10); n /= 10; } while (n);
+    while (k) r->saida[r->tamanho++] = d[--k];
+}
+
+static inline void rdMoverCursor(Renderizador *r, int linha, int coluna) {
+    rdBytes(r, "\x1b[", 2);
+    rdNumero(r, linha + 1);
+    if (coluna > 0) {
+        r->saida[r->tamanho++] = ';';
+        rdNumero(r, coluna + 1);
+    }
+    r->saida[r->tamanho++] = 'H';
+    r->cursorLinha = linha;
+    r->cursorColuna = coluna;
+}
+
+static inline void rdCor(Renderizador *r, int cor) {
+    if (cor == r->corAtual) return;
+    if (cor == COR_PADRAO) {
+        rdBytes(r, "\x1b[0m", 4);
+    } else {
+        rdBytes(r, "\x1b[", 2);
+        rdNumero(r, (cor & COR_BRILHANTE ? 90 : 30) + (cor & 7));
+        r->saida[r->tamanho++] = 'm';
+    }
+    r->corAtual = cor;
+}
+
+static inline void rdCaractere(Renderizador *r, uint32_t ch) {
+    char *s = r->saida + r->tamanho;
+    if (ch < 0x80) {
+        s[0] = (char)ch;
+        r->tamanho += 1;
+    } else if (ch < 0x800) {
+        s[0] = (char)(0xC0 | (ch >> 6));
+        s[1] = (char)(0x80 | (ch & 0x3F));
+        r->tamanho += 2;
+    } else if (ch < 0x10000) {
+        s[0] = (char)(0xE0 | (ch >> 12));
+        s[1] = (char)(0x80 | ((ch >> 6) & 0x3F));
+        s[2] = (char)(0x80 | (ch & 0x3F));
+        r->tamanho += 3;
+    } else {
+        s[0] = (char)(0xF0 | (ch >> 18));
+        s[1] = (char)(0x80 | ((ch >> 12) & 0x3F));
+        s[2] = (char)(0x80 | ((ch >> 6) & 0x3F));
+        s[3] = (char)(0x80 | (ch & 0x3F));
+        r->tamanho += 4;
+    }
+}
+
+/* Envia a célula da coluna c da linha (e a continuação, se for larga); retorna a próxima coluna */
+static inline int rdEmitirCelula(Renderizador *r, const uint32_t *linha, int c) {
+    uint32_t cel = linha[c];
+    rdCor(r, RD_COR(cel));
+    rdCaractere(r, RD_CARACTERE(cel) ? RD_CARACTERE(cel) : ' ');
+    r->celulasUltimo++;
+    if (c + 1 < r->largura && linha[c + 1] == RD_CELULA(RD_CONTINUACAO, RD_COR(cel)) &&
+        RD_CARACTERE(cel) >= 0x1F000) {
+        r->cursorColuna += 2;
+        return c + 2;
+    }
+    r->cursorColuna += 1;
+    return c + 1;
+}
+
+/* Compara o quadro atual com o anterior e envia as diferenças num único write().
+   Retorna os bytes escritos (ou -1 se o write falhou). */
+static inline long renderizadorApresentar(Renderizador *r) {
+    int L = r->largura;
+    r->tamanho = 0;
+    r->celulasUltimo = 0;
+    r->cursorLinha = r->cursorColuna = -1;
+    r->corAtual = -1;
+
+    if (!r->valido) { /* tela limpa: o "quadro anterior" passa a ser todo branco */
+        size_t celulas = (size_t)L * r->altura;
+        rdBytes(r, "\x1b[0m\x1b[H\x1b[2J", 11);
+        r->corAtual = COR_PADRAO;
+        for (size_t i = 0; i < celulas; i++) r->anterior[i] = RD_BRANCO;
+        r->valido = 1;
+    }
+
+    for (int y = 0; y < r->altura; y++) {
+        const uint32_t *at = r->atual + (size_t)y * L, *an = r->anterior + (size_t)y * L;
+        if (memcmp(at, an, (size_t)L * sizeof(uint32_t)) == 0) continue;
+        int x = 0;
+        while (x < L) {
+            if (at[x] == an[x]) { x++; continue; }
+            /* mudança na metade direita de um caractere largo: reenvia desde a esquerda */
+            if (x > 0 && RD_CARACTERE(at[x]) == RD_CONTINUACAO && RD_CARACTERE(at[x - 1]) >= 0x1F000) x--;
+            if (r->cursorLinha == y && r->cursorColuna <= x && x - r->cursorColuna <= RD_SALTO_MAXIMO) {
+                int c = r->cursorColuna; /* trecho curto inalterado: reenviar sai mais barato */
+                while (c < x) c = rdEmitirCelula(r, at, c);
+            } else if (r->cursorLinha != y || r->cursorColuna != x) {
+                rdMoverCursor(r, y, x);
+            }
+            x = rdEmitirCelula(r, at, x);
+        }
+    }
+    memcpy(r->anterior, r->atual, (size_t)L * r->altura * sizeof(uint32_t));
+
+    if (r->comEntrada) { /* linha de entrada: apaga dela até o fim da tela e escreve o prompt */
+        size_t n = strlen(r->entrada);
+        rdCor(r, COR_PADRAO);
+        rdMoverCursor(r, r->altura, 0);
+        rdBytes(r, "\x1b[J", 3);
+        rdBytes(r, r->entrada, n);
+    } else if (r->corAtual != COR_PADRAO && r->corAtual != -1) {
+        rdCor(r, COR_PADRAO);
+    }
+
+    r->quadros++;
+    r->bytesUltimo = (long)r->tamanho;
+    r->bytesTotal += (long)r->tamanho;
+    if (r->tamanho > 0) {
+        size_t enviado = 0;
+        while (enviado < r->tamanho) {
+            ssize_t k = write(r->fd, r->saida + enviado, r->tamanho - enviado);
+            if (k <= 0) return -1;
+            enviado += (size_t)k;
+        }
+    }
+    return (long)r->tamanho;
+}
+
+/* Restaura cor e cursor, desce o cursor para baixo do quadro e libera tudo */
+static inline void liberarRenderizador(Renderizador *r) {
+    char fim[32];
+    int n;
+    if (!r) return;
+    n = snprintf(fim, sizeof(fim), "\x1b[0m\x1b[?25h\x1b[%d;1H\n", r->altura + 2);
+    if (write(r->fd, fim, (size_t)n) < 0) { /* nada a fazer: o terminal já foi embora */ }
+    free(r->atual);
+    free(r->anterior);
+    free(r->saida);
+    free(r);
+}
+
+#endif /* RENDERIZADOR_H */
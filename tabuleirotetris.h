@@ -0,0 +1,247 @@
+/*
+  tabuleirotetris.h - Motor do tabuleiro do Tetris (10 x 20) com máscaras de bits
+  ------------------------------------------------------------------------------
+  Cada linha do tabuleiro é um uint16_t: o bit c indica a coluna c ocupada.
+  Com isso colisão, fixação da peça e remoção de linhas viram operações de bits
+  sobre no máximo 4 linhas por peça.
+
+  - Linha 0 é o fundo do tabuleiro.
+  - As formas das peças ficam numa tabela (tipo x rotação), também em bits,
+    com o deslocamento do fundo e do topo de cada coluna da forma.
+  - A queda ("gravidade") usa a altura de cada coluna: a peça para na primeira
+    altura em que alguma de suas colunas encosta na pilha.
+
+  Uso típico:
+      Tabuleiro t;
+      inicializarTabuleiro(&t);
+      int linhas = colocarPeca(&t, 'T', rotacao, coluna);  // -1: jogada inválida / estouro
+      exibirTabuleiro(&t);
+
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef TABULEIROTETRIS_H
+#define TABULEIROTETRIS_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#define LARGURA_TABULEIRO 10
+#define ALTURA_TABULEIRO 20
+#define LINHA_CHEIA ((uint16_t)((1u << LARGURA_TABULEIRO) - 1))
+#define NUM_TIPOS_PECA 7
+#define NUM_ROTACOES 4
+
+typedef struct {
+    uint16_t linhas[ALTURA_TABULEIRO + 8]; /* 4 linhas de folga acima do topo + 4 de guarda
+                                              para os laços fixos de 4 linhas */
+    uint8_t alturaColuna[LARGURA_TABULEIRO + 4]; /* 1 + linha mais alta ocupada (0 = vazia);
+                                                    4 colunas de folga para os laços fixos de 4 */
+    int altura;                            /* maior altura de coluna */
+    long linhasRemovidas;
+    long pecasColocadas;
+} Tabuleiro;
+
+typedef struct {
+    uint16_t linhas[4];                    /* de baixo para cima, bit 0 = coluna mais à esquerda */
+    int largura, altura;
+    int8_t fundo[4];                       /* linha mais baixa ocupada em cada coluna da forma */
+    int8_t topo[4];                        /* 1 + linha mais alta ocupada em cada coluna */
+    /* colunas fora da forma usam fundo = 127 e topo = -128, de modo que os laços
+       sempre percorrem 4 colunas/linhas sem desvios dependentes da peça */
+} FormaPeca;
+
+/* Tipos na ordem da tabela de formas */
+static const char TIPOS_PECA[NUM_TIPOS_PECA] = {'I', 'O', 'T', 'L', 'J', 'S', 'Z'};
+
+/* Formas (linhas de baixo para cima) das 4 rotações de cada tipo */
+static const uint16_t LINHAS_FORMAS[NUM_TIPOS_PECA][NUM_ROTACOES][4] = {
+    /* I */ {{0xF}, {1, 1, 1, 1}, {0xF}, {1, 1, 1, 1}},
+    /* O */ {{3, 3}, {3, 3}, {3, 3}, {3, 3}},
+    /* T */ {{7, 2}, {1, 3, 1}, {2, 7}, {2, 3, 2}},
+    /* L */ {{7, 4}, {3, 1, 1}, {1, 7}, {2, 2, 3}},
+    /* J */ {{7, 1}, {3, 2, 2}, {4, 7}, {1, 1, 3}},
+    /* S */ {{3, 6}, {2, 3, 1}, {3, 6}, {2, 3, 1}},
+    /* Z */ {{6, 3}, {1, 3, 2}, {6, 3}, {1, 3, 2}},
+};
+
+/* Índice do tipo na tabela de formas (-1 se desconhecido) */
+static inline int indiceTipoPeca(char tipo) {
+    switch (tipo) {
+        case 'I': return 0;
+        case 'O': return 1;
+        case 'T': return 2;
+        case 'L': return 3;
+        case 'J': return 4;
+        case 'S': return 5;
+        case 'Z': return 6;
+        default:  return -1;
+    }
+}
+
+/* Tabela de formas completa, montada na primeira chamada */
+static inline const FormaPeca *formaPeca(int tipo, int rotacao) {
+    static FormaPeca formas[NUM_TIPOS_PECA][NUM_ROTACOES];
+    static int pronta = 0;
+    if (!pronta) {
+        int t, r, i, c;
+        for (t = 0; t < NUM_TIPOS_PECA; t++) {
+            for (r = 0; r < NUM_ROTACOES; r++) {
+                FormaPeca *f = &formas[t][r];
+                uint16_t uniao = 0;
+                memset(f, 0, sizeof(*f));
+                for (i = 0; i < 4 && LINHAS_FORMAS[t][r][i]; i++) {
+                    f->linhas[i] = LINHAS_FORMAS[t][r][i];
+                    uniao |= f->linhas[i];
+                }
+                f->altura = i;
+                f->largura = 32 - __builtin_clz(uniao);
+                for (c = 0; c < 4; c++) {
+                    f->fundo[c] = 127;
+                    f->topo[c] = -128;
+                }
+                for (c = 0; c < f->largura; c++) {
+                    f->fundo[c] = -1;
+                    for (i = 0; i < f->altura; i++) {
+                        if (f->linhas[i] & (1u << c)) {
+                            if (f->fundo[c] < 0) f->fundo[c] = (int8_t)i;
+                            f->topo[c] = (int8_t)(i + 1);
+                        }
+                    }
+                }
+            }
+        }
+        pronta = 1;
+    }
+    return &formas[tipo][rotacao & 3];
+}
+
+static inline void inicializarTabuleiro(Tabuleiro *t) {
+    memset(t, 0, sizeof(*t));
+    formaPeca(0, 0); /* garante a tabela pronta antes de qualquer jogada */
+}
+
+/* 1 se a forma na posição (coluna, linha) sai do tabuleiro ou encosta em blocos */
+static inline int colidePeca(const Tabuleiro *t, int tipo, int rotacao, int coluna, int linha) {
+    const FormaPeca *f = formaPeca(tipo, rotacao);
+    int i;
+    if (coluna < 0 || coluna + f->largura > LARGURA_TABULEIRO || linha < 0) return 1;
+    if (linha + f->altura > ALTURA_TABULEIRO + 4) return 1;
+    for (i = 0; i < f->altura; i++) {
+        if (t->linhas[linha + i] & (uint16_t)(f->linhas[i] << coluna)) return 1;
+    }
+    return 0;
+}
+
+static inline int quedaForma(const Tabuleiro *t, const FormaPeca *f, int coluna) {
+    int c, linha = 0;
+    for (c = 0; c < 4; c++) {
+        int apoio = t->alturaColuna[coluna + c] - f->fundo[c];
+        linha = apoio > linha ? apoio : linha;
+    }
+    return linha;
+}
+
+/* Linha onde a peça para ao cair livremente na coluna dada */
+static inline int linhaDeQueda(const Tabuleiro *t, int tipo, int rotacao, int coluna) {
+    return quedaForma(t, formaPeca(tipo, rotacao), coluna);
+}
+
+/* Recalcula a altura de cada coluna varrendo as linhas de cima para baixo */
+static inline void recalcularAlturas(Tabuleiro *t) {
+    uint16_t restantes = LINHA_CHEIA;
+    int l;
+    memset(t->alturaColuna, 0, sizeof(t->alturaColuna));
+    t->altura = 0;
+    for (l = ALTURA_TABULEIRO + 3; l >= 0 && restantes; l--) {
+        uint16_t novas = t->linhas[l] & restantes;
+        if (novas && t->altura == 0) t->altura = l + 1;
+        restantes &= (uint16_t)~novas;
+        while (novas) {
+            int c = __builtin_ctz(novas);
+            t->alturaColuna[c] = (uint8_t)(l + 1);
+            novas &= (uint16_t)(novas - 1);
+        }
+    }
+}
+
+static inline int fixarForma(Tabuleiro *t, const FormaPeca *f, int coluna, int linha) {
+    int i, c, removidas = 0, topoPeca = linha + f->altura;
+
+    /* linhas acima da forma recebem 0; linha + 3 sempre cabe nas linhas de guarda */
+    for (i = 0; i < 4; i++)
+        t->linhas[linha + i] |= (uint16_t)(f->linhas[i] << coluna);
+    for (c = 0; c < 4; c++) {
+        int topo = linha + f->topo[c];
+        int atual = t->alturaColuna[coluna + c];
+        t->alturaColuna[coluna + c] = (uint8_t)(topo > atual ? topo : atual);
+    }
+    t->altura = topoPeca > t->altura ? topoPeca : t->altura;
+    t->pecasColocadas++;
+
+    /* só as linhas tocadas pela peça podem ter ficado completas (as de cima
+       nunca estão cheias, pois linhas cheias são removidas na hora) */
+    {
+        unsigned cheias = 0;
+        int destino, origem;
+        for (i = 0; i < 4; i++)
+            cheias |= (unsigned)(t->linhas[linha + i] == LINHA_CHEIA) << i;
+        if (!cheias) return 0;
+
+        destino = linha;
+        for (origem = linha; origem < t->altura; origem++) {
+            if (origem < linha + 4 && ((cheias >> (origem - linha)) & 1)) {
+                removidas++;
+                continue;
+            }
+            t->linhas[destino++] = t->linhas[origem];
+        }
+        for (; destino < t->altura; destino++) t->linhas[destino] = 0;
+        t->linhasRemovidas += removidas;
+        recalcularAlturas(t);
+    }
+    return removidas;
+}
+
+/* Grava a peça em (coluna, linha), remove as linhas completas e devolve quantas
+   foram removidas. Não verifica colisão: use colidePeca()/linhaDeQueda() antes. */
+static inline int fixarPeca(Tabuleiro *t, int tipo, int rotacao, int coluna, int linha) {
+    return fixarForma(t, formaPeca(tipo, rotacao), coluna, linha);
+}
+
+/* Derruba a peça (tipo 'I', 'O', 'T', 'L', 'J', 'S' ou 'Z') na coluna e rotação dadas.
+   Retorna as linhas removidas ou -1 se a jogada é inválida ou a peça
+   ficaria acima do topo (fim de jogo). */
+static inline int colocarPeca(Tabuleiro *t, char tipo, int rotacao, int coluna) {
+    int idx = indiceTipoPeca(tipo);
+    const FormaPeca *f;
+    int linha;
+    if (idx < 0) return -1;
+    f = formaPeca(idx, rotacao);
+    if (coluna < 0 || coluna + f->largura > LARGURA_TABULEIRO) return -1;
+    linha = quedaForma(t, f, coluna);
+    if (linha + f->altura > ALTURA_TABULEIRO) return -1;
+    return fixarForma(t, f, coluna, linha);
+}
+
+/* Largura da peça na rotação dada (para validar a coluna escolhida) */
+static inline int larguraPeca(char tipo, int rotacao) {
+    int idx = indiceTipoPeca(tipo);
+    return idx < 0 ? 0 : formaPeca(idx, rotacao)->largura;
+}
+
+static inline void exibirTabuleiro(const Tabuleiro *t) {
+    int l, c;
+    for (l = ALTURA_TABULEIRO - 1; l >= 0; l--) {
+        putchar('|');
+        for (c = 0; c < LARGURA_TABULEIRO; c++)
+            putchar((t->linhas[l] >> c) & 1 ? '#' : '.');
+        printf("|\n");
+    }
+    printf("+");
+    for (c = 0; c < LARGURA_TABULEIRO; c++) putchar('-');
+    printf("+  linhas: %ld | pecas: %ld\n", t->linhasRemovidas, t->pecasColocadas);
+}
+
+#endif /* TABULEIROTETRIS_H */
@@ -0,0 +1,135 @@
+/*
+  teclado.h - Teclado sem bloqueio para laços em tempo real (termios + poll)
+  ------------------------------------------------------------------------
+  Põe o terminal em modo "cru" (sem eco, sem esperar o Enter) e lê as teclas
+  só quando há bytes disponíveis, para que o laço do jogo nunca pare num scanf.
+
+  - tecladoAtivar() desliga ICANON e ECHO (Ctrl-C continua gerando SIGINT) e
+    registra a restauração do terminal com atexit(); tecladoRestaurar() pode
+    ser chamada antes, a restauração só acontece uma vez.
+  - tecladoAguardar(ms) espera com poll() até chegar uma tecla ou o prazo
+    acabar (o prazo do próximo passo do laço).
+  - tecladoLer() decodifica um byte ou uma sequência de escape das setas.
+  - Se a entrada não é um terminal (pipe, arquivo), o modo cru é ignorado e as
+    teclas são os próprios bytes lidos: útil para repetir uma sessão gravada.
+
+  Uso:
+      tecladoAtivar();
+      while (rodando) {
+          if (tecladoAguardar(msAteProximoPasso) > 0)
+              while ((t = tecladoLer()) >= 0) tratar(t);
+          ...
+      }
+      tecladoRestaurar();
+
+  Funções static inline: basta incluir o arquivo no programa.
+*/
+
+#ifndef TECLADO_H
+#define TECLADO_H
+
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+/* Teclas especiais (fora da faixa de um byte) */
+#define TECLA_NENHUMA  -1   /* nada disponível agora */
+#define TECLA_FIM      -2   /* fim da entrada (EOF ou erro) */
+#define TECLA_CIMA     0x100
+#define TECLA_BAIXO    0x101
+#define TECLA_DIREITA  0x102
+#define TECLA_ESQUERDA 0x103
+
+typedef struct {
+    struct termios original;
+    int ativo;          /* termios alterado (e ainda não restaurado) */
+    int terminal;       /* a entrada é um terminal */
+    int encerrado;      /* a entrada acabou: só resta esperar o prazo */
+    unsigned char bytes[64];
+    int inicio, fim;    /* bytes lidos e ainda não decodificados */
+} Teclado;
+
+static Teclado teclado;
+
+static inline void tecladoRestaurar(void) {
+    if (!teclado.ativo) return;
+    tcsetattr(STDIN_FILENO, TCSAFLUSH, &teclado.original);
+    teclado.ativo = 0;
+}
+
+/* Modo cru na entrada padrão. Retorna 0 se não foi possível alterar o terminal. */
+static inline int tecladoAtivar(void) {
+    static int registrado = 0;
+    struct termios cru;
+    teclado.inicio = teclado.fim = 0;
+    teclado.encerrado = 0;
+    teclado.terminal = isatty(STDIN_FILENO);
+    if (!teclado.terminal) return 1;
+    if (tcgetattr(STDIN_FILENO, &teclado.original) != 0) return 0;
+    cru = teclado.original;
+    cru.c_lflag &= (tcflag_t) ~(ICANON | ECHO);
+    cru.c_cc[VMIN] = 0;  /* read() nunca bloqueia: a espera fica com o poll() */
+    cru.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSAFLUSH, &cru) != 0) return 0;
+    teclado.ativo = 1;
+    if (!registrado) {
+        atexit(tecladoRestaurar);
+        registrado = 1;
+    }
+    return 1;
+}
+
+/* Espera até 'ms' milissegundos por uma tecla. Retorna 1 se há bytes para ler,
+   0 se o prazo acabou e -1 se a espera foi interrompida por um sinal. */
+static inline int tecladoAguardar(int ms) {
+    struct pollfd p;
+    int r;
+    if (teclado.inicio < teclado.fim) return 1;
+    if (teclado.encerrado) {
+        r = poll(NULL, 0, ms < 0 ? 0 : ms);
+        return r < 0 && errno == EINTR ? -1 : 0;
+    }
+    p.fd = STDIN_FILENO;
+    p.events = POLLIN;
+    p.revents = 0;
+    r = poll(&p, 1, ms < 0 ? 0 : ms);
+    if (r < 0) return errno == EINTR ? -1 : 1; /* outro erro: o read() relata */
+    return r > 0;
+}
+
+/* Próxima tecla já disponível (TECLA_NENHUMA se não há nada agora, TECLA_FIM
+   depois que a entrada acabou) */
+static inline int tecladoLer(void) {
+    unsigned char *b = teclado.bytes;
+    if (teclado.inicio == teclado.fim) {
+        ssize_t n;
+        struct pollfd p;
+        if (teclado.encerrado) return TECLA_FIM;
+        p.fd = STDIN_FILENO;
+        p.events = POLLIN;
+        p.revents = 0;
+        if (poll(&p, 1, 0) <= 0) return TECLA_NENHUMA;
+        n = read(STDIN_FILENO, b, sizeof(teclado.bytes));
+        if (n < 0 && (errno == EINTR || errno == EAGAIN)) return TECLA_NENHUMA;
+        if (n <= 0) {
+            teclado.encerrado = 1;
+            return TECLA_FIM;
+        }
+        teclado.inicio = 0;
+        teclado.fim = (int)n;
+    }
+    /* setas: ESC [ A..D (ou ESC O A..D no modo de aplicação do cursor) */
+    if (b[teclado.inicio] == 0x1b && teclado.fim - teclado.inicio >= 3 &&
+        (b[teclado.inicio + 1] == '[' || b[teclado.inicio + 1] == 'O')) {
+        unsigned char c = b[teclado.inicio + 2];
+        if (c >= 'A' && c <= 'D') {
+            teclado.inicio += 3;
+            return TECLA_CIMA + (c - 'A');
+        }
+    }
+    return b[teclado.inicio++];
+}
+
+#endif /* TECLADO_H */
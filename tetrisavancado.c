@@ -1,62 +1,82 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "tabuleirotetris.h"
+#include "filaanel.h"
+#include "filaspsc.h"
+#include "randomizador.h"
+#include "renderizador.h"
+#include "teclado.h"
+#include "console.h"
+#include "lote.h"
+#include "instrumentacao.h"
+#include "memoria.h"
 
+// Contas de memória das estruturas que crescem (memoria.h; MEMORIA=1 mostra o uso no fim)
+MEM_CONTA(memBot, "bot (feixes e tabela)");
+MEM_CONTA(memComandos, "comandos (script/mistura)");
+MEM_CONTA(memDiario, "diario de desfazer");
+
+// Tamanhos configuráveis na compilação (ex.: -DTAMANHO_FILA=4096 -DTAMANHO_PILHA=4096)
+#ifndef TAMANHO_FILA
 #define TAMANHO_FILA 5   // Tamanho da fila circular
+#endif
+#ifndef TAMANHO_PILHA
 #define TAMANHO_PILHA 3  // Tamanho da pilha de reserva
+#endif
 
 // Estrutura que representa uma peça do Tetris
 typedef struct {
-    char tipo; // 'I', 'O', 'T', 'L'
+    char tipo; // 'I', 'O', 'T', 'L', 'J', 'S', 'Z'
     int id;    // Identificador único
 } Peca;
 
 // ---------------- Fila Circular ---------------- //
-typedef struct {
-    Peca itens[TAMANHO_FILA];
-    int inicio;
-    int fim;
-    int qtd;
-} Fila;
-
-void inicializarFila(Fila *f) {
-    f->inicio = 0;
-    f->fim = -1;
-    f->qtd = 0;
-}
+// Anel com capacidade potência de 2 (>= TAMANHO_FILA) e índice por máscara (filaanel.h)
+FILA_ANEL_DECLARAR(Fila, Peca, TAMANHO_FILA, anel)
 
-int filaCheia(Fila *f) { return f->qtd == TAMANHO_FILA; }
-int filaVazia(Fila *f) { return f->qtd == 0; }
+void inicializarFila(Fila *f) { anelInicializar(f); }
+int filaQtd(Fila *f) { return (int)anelQuantidade(f); }
+int filaCheia(Fila *f) { return filaQtd(f) == TAMANHO_FILA; }
+int filaVazia(Fila *f) { return anelVazia(f); }
 
 void enfileirar(Fila *f, Peca p) {
+    INSTR_CRONOMETRAR("enfileirar");
     if (filaCheia(f)) return;
-    f->fim = (f->fim + 1) % TAMANHO_FILA;
-    f->itens[f->fim] = p;
-    f->qtd++;
+    anelEnfileirar(f, &p);
 }
 
 Peca desenfileirar(Fila *f) {
+    INSTR_CRONOMETRAR("desenfileirar");
     Peca removida = {' ', -1};
-    if (filaVazia(f)) return removida;
-    removida = f->itens[f->inicio];
-    f->inicio = (f->inicio + 1) % TAMANHO_FILA;
-    f->qtd--;
+    anelDesenfileirar(f, &removida);
     return removida;
 }
 
 // ---------------- Pilha Linear ---------------- //
+// Cresce em direção ao início do vetor: itens[topo] é o topo e itens[topo + i]
+// a i-ésima peça abaixo dele, então as k peças do topo ficam contíguas e na
+// mesma ordem da frente da fila (trocarBloco).
 typedef struct {
     Peca itens[TAMANHO_PILHA];
-    int topo;
+    int topo; // TAMANHO_PILHA = pilha vazia
 } Pilha;
 
-void inicializarPilha(Pilha *p) { p->topo = -1; }
-int pilhaCheia(Pilha *p) { return p->topo == TAMANHO_PILHA - 1; }
-int pilhaVazia(Pilha *p) { return p->topo == -1; }
+void inicializarPilha(Pilha *p) { p->topo = TAMANHO_PILHA; }
+int pilhaQtd(Pilha *p) { return TAMANHO_PILHA - p->topo; }
+int pilhaCheia(Pilha *p) { return p->topo == 0; }
+int pilhaVazia(Pilha *p) { return p->topo == TAMANHO_PILHA; }
 
 void empilhar(Pilha *p, Peca x) {
     if (pilhaCheia(p)) return;
-    p->topo++;
+    p->topo--;
     p->itens[p->topo] = x;
 }
 
@@ -64,27 +84,43 @@ Peca desempilhar(Pilha *p) {
     Peca removida = {' ', -1};
     if (pilhaVazia(p)) return removida;
     removida = p->itens[p->topo];
-    p->topo--;
+    p->topo++;
     return removida;
 }
 
 // ---------------- Geração de peças ---------------- //
+// Sorteio configurável (uniforme, sacola de 7, histórico, ponderado; ver randomizador.h)
+#define TIPOS_JOGO "IOTLJSZ"
+static Randomizador randomizador;
+
 Peca gerarPeca(int id) {
     Peca nova;
-    char tipos[] = {'I', 'O', 'T', 'L'};
-    nova.tipo = tipos[rand() % 4];
+    nova.tipo = randomizadorProxima(&randomizador);
     nova.id = id;
     return nova;
 }
 
+// Completa a fila até TAMANHO_FILA com peças sorteadas em lote
+void reabastecerFila(Fila *f, int *contadorID) {
+    char tipos[TAMANHO_FILA];
+    Peca novas[TAMANHO_FILA];
+    int faltam = TAMANHO_FILA - filaQtd(f);
+    randomizadorPreencher(&randomizador, tipos, (size_t)faltam);
+    for (int i = 0; i < faltam; i++) {
+        novas[i].tipo = tipos[i];
+        novas[i].id = (*contadorID)++;
+    }
+    anelEnfileirarLote(f, novas, (uint32_t)faltam);
+}
+
 // ---------------- Exibição ---------------- //
 void exibirFila(Fila *f) {
     printf("Fila de peças: ");
     if (filaVazia(f)) { printf("(vazia)\n"); return; }
-    int pos = f->inicio;
-    for (int i = 0; i < f->qtd; i++) {
-        printf("[%c %d] ", f->itens[pos].tipo, f->itens[pos].id);
-        pos = (pos + 1) % TAMANHO_FILA;
+    Peca pecas[TAMANHO_FILA];
+    int n = anelEspiarIntervalo(f, 0, pecas, TAMANHO_FILA);
+    for (int i = 0; i < n; i++) {
+        printf("[%c %d] ", pecas[i].tipo, pecas[i].id);
     }
     printf("\n");
 }
@@ -92,110 +128,2559 @@ void exibirFila(Fila *f) {
 void exibirPilha(Pilha *p) {
     printf("Pilha de reserva (Topo -> Base): ");
     if (pilhaVazia(p)) { printf("(vazia)\n"); return; }
-    for (int i = p->topo; i >= 0; i--) {
+    for (int i = p->topo; i < TAMANHO_PILHA; i++) {
         printf("[%c %d] ", p->itens[i].tipo, p->itens[i].id);
     }
     printf("\n");
 }
 
-// ---------------- Trocas ---------------- //
-// Troca a peça da frente da fila com o topo da pilha
-void trocarFrentePilha(Fila *f, Pilha *p) {
-    if (filaVazia(f) || pilhaVazia(p)) {
-        printf("\n⚠️  Não é possível realizar troca: fila ou pilha vazia.\n");
-        return;
+// ---------------- Saída: clássica ou tela diferencial ---------------- //
+// Com --tela o estado é desenhado por renderizador.h (só as diferenças, num
+// write() por quadro); as mensagens das ações vão para uma linha do quadro e
+// as perguntas para a linha de entrada logo abaixo dele.
+static Renderizador *tela = NULL; // NULL: saída clássica com printf
+static char mensagemTela[256];
+
+// Mensagem de uma ação (na tela diferencial, acumulada até o próximo quadro)
+void avisar(const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    if (!tela) {
+        vprintf(formato, args);
+    } else {
+        size_t n = strlen(mensagemTela);
+        char texto[256], *t = texto;
+        vsnprintf(texto, sizeof(texto), formato, args);
+        while (*t == '\n' || *t == ' ') t++;
+        if (*t && n > 0 && n + 1 < sizeof(mensagemTela)) mensagemTela[n++] = ' ';
+        snprintf(mensagemTela + n, sizeof(mensagemTela) - n, "%s", t);
+        for (char *c = mensagemTela; *c; c++)
+            if (*c == '\n') *c = ' ';
+    }
+    va_end(args);
+}
+
+// Texto antes de uma leitura (na tela diferencial, na linha de entrada; sem
+// tela, só no modo interativo do console)
+void perguntar(const char *formato, ...) {
+    va_list args;
+    va_start(args, formato);
+    if (!tela) {
+        if (consoleInterativo()) vprintf(formato, args);
+    } else {
+        vsnprintf(tela->entrada, sizeof(tela->entrada), formato, args);
+        tela->comEntrada = 1;
+        renderizadorApresentar(tela);
     }
-    Peca temp = f->itens[f->inicio];
-    f->itens[f->inicio] = p->itens[p->topo];
+    va_end(args);
+}
+
+// ---------------- Trocas ---------------- //
+// Troca a peça da frente da fila com o topo da pilha (retorna 0 se não foi possível)
+int trocarFrentePilha(Fila *f, Pilha *p) {
+    if (filaVazia(f) || pilhaVazia(p)) return 0;
+    Peca *frente = anelEspiar(f, 0);
+    Peca temp = *frente;
+    *frente = p->itens[p->topo];
     p->itens[p->topo] = temp;
-    printf("\n🔄 Troca pontual realizada entre a frente da fila e o topo da pilha.\n");
+    return 1;
 }
 
-// Troca os 3 primeiros da fila com as 3 da pilha (se possível)
-void trocarTres(Fila *f, Pilha *p) {
-    if (f->qtd < 3 || p->topo < 2) {
-        printf("\n⚠️  Não é possível realizar troca múltipla: elementos insuficientes.\n");
-        return;
+// Maior k possível em trocarBloco()
+#define MAIOR_BLOCO (TAMANHO_FILA < TAMANHO_PILHA ? TAMANHO_FILA : TAMANHO_PILHA)
+// Comando.quantidade e RegistroDesfazer.quantidade guardam k em uint16_t
+_Static_assert(MAIOR_BLOCO <= 65535, "MAIOR_BLOCO precisa caber em uint16_t");
+
+// Troca as k primeiras da fila com as k do topo da pilha (a i-ésima da fila com a
+// i-ésima a partir do topo). Como as k do topo são contíguas, a troca é de no
+// máximo dois trechos de memória. Retorna 0 se não há peças suficientes.
+int trocarBloco(Fila *f, Pilha *p, int k) {
+    INSTR_CRONOMETRAR("trocarBloco");
+    if (k < 1 || filaQtd(f) < k || pilhaQtd(p) < k) return 0;
+    anelTrocarIntervalo(f, 0, &p->itens[p->topo], (uint32_t)k);
+    return 1;
+}
+
+// Troca os 3 primeiros da fila com as 3 da pilha (retorna 0 se não foi possível)
+int trocarTres(Fila *f, Pilha *p) { return trocarBloco(f, p, 3); }
+
+// ---------------- Estado do jogo ---------------- //
+typedef struct {
+    Fila fila;
+    Pilha pilha;
+    Tabuleiro tabuleiro;
+    int contadorID;
+} EstadoJogo;
+
+void inicializarJogo(EstadoJogo *e) {
+    inicializarFila(&e->fila);
+    inicializarPilha(&e->pilha);
+    inicializarTabuleiro(&e->tabuleiro);
+    e->contadorID = 0;
+    reabastecerFila(&e->fila, &e->contadorID); // fila começa cheia (sorteio em lote)
+}
+
+// ---------------- Ações do menu ---------------- //
+// As opções do menu sem nenhuma entrada/saída: o modo interativo e o modo sem
+// tela (--script / --mix) chamam exatamente as mesmas funções.
+#define ACAO_IMPOSSIVEL  -1  // fila ou pilha sem peças suficientes
+#define ACAO_INVALIDA    -2  // coluna fora do tabuleiro: peça descartada
+#define ACAO_FIM_DE_JOGO -3  // a peça não coube: tabuleiro reiniciado
+#define ACAO_SEM_MEMORIA -4  // o diário de desfazer não pôde crescer (nada foi feito)
+
+// Derruba p no tabuleiro; retorna as linhas removidas, ACAO_INVALIDA ou ACAO_FIM_DE_JOGO
+int aplicarJogada(Tabuleiro *t, Peca p, int rotacao, int coluna) {
+    INSTR_CRONOMETRAR("aplicarJogada");
+    if (coluna < 0 || coluna + larguraPeca(p.tipo, rotacao) > LARGURA_TABULEIRO) return ACAO_INVALIDA;
+    int linhas = colocarPeca(t, p.tipo, rotacao, coluna);
+    if (linhas < 0) {
+        inicializarTabuleiro(t);
+        return ACAO_FIM_DE_JOGO;
     }
-    for (int i = 0; i < 3; i++) {
-        int posFila = (f->inicio + i) % TAMANHO_FILA;
-        Peca temp = f->itens[posFila];
-        f->itens[posFila] = p->itens[p->topo - i];
-        p->itens[p->topo - i] = temp;
+    INSTR_SOMAR("tabuleiro.linhas", linhas);
+    return linhas;
+}
+
+// Opção 1: joga a peça da frente da fila e completa a fila
+int acaoJogar(EstadoJogo *e, int rotacao, int coluna, Peca *jogada) {
+    if (filaVazia(&e->fila)) return ACAO_IMPOSSIVEL;
+    *jogada = desenfileirar(&e->fila);
+    int resultado = aplicarJogada(&e->tabuleiro, *jogada, rotacao, coluna);
+    reabastecerFila(&e->fila, &e->contadorID);
+    return resultado;
+}
+
+// Opção 2: move a peça da frente da fila para a pilha de reserva
+int acaoReservar(EstadoJogo *e, Peca *reservada) {
+    if (filaVazia(&e->fila) || pilhaCheia(&e->pilha)) return ACAO_IMPOSSIVEL;
+    *reservada = desenfileirar(&e->fila);
+    empilhar(&e->pilha, *reservada);
+    reabastecerFila(&e->fila, &e->contadorID);
+    return 0;
+}
+
+// Opção 3: joga a peça do topo da pilha de reserva
+int acaoUsarReserva(EstadoJogo *e, int rotacao, int coluna, Peca *usada) {
+    if (pilhaVazia(&e->pilha)) return ACAO_IMPOSSIVEL;
+    *usada = desempilhar(&e->pilha);
+    return aplicarJogada(&e->tabuleiro, *usada, rotacao, coluna);
+}
+
+// Pede rotação e coluna ao jogador para a peça p
+void lerJogada(Peca p, int *rotacao, int *coluna) {
+    *rotacao = 0;
+    *coluna = -1; // sem resposta: coluna inválida, a peça é descartada
+    perguntar("Rotação (0-3): ");
+    consoleLerInteiro(rotacao);
+    *rotacao &= 3;
+    perguntar("Coluna (0-%d): ", LARGURA_TABULEIRO - larguraPeca(p.tipo, *rotacao));
+    consoleLerInteiro(coluna);
+}
+
+// Mensagem para o resultado de acaoJogar()/acaoUsarReserva()
+void relatarJogada(int resultado) {
+    if (resultado == ACAO_INVALIDA) {
+        avisar("\n⚠️  Coluna inválida! A peça foi descartada.\n");
+    } else if (resultado == ACAO_FIM_DE_JOGO) {
+        avisar("\n💥 A peça não cabe mais no tabuleiro! Fim de jogo, tabuleiro reiniciado.\n");
+    } else if (resultado == ACAO_SEM_MEMORIA) {
+        avisar("\n❌ Memória insuficiente para registrar a ação.\n");
+    } else if (resultado > 0) {
+        avisar("\n✨ %d linha(s) completa(s) removida(s)!\n", resultado);
     }
-    printf("\n🔄 Troca múltipla realizada entre os 3 primeiros da fila e da pilha.\n");
 }
 
-// ---------------- Função principal ---------------- //
-int main() {
+// ---------------- Desenho do estado ---------------- //
+static const char *OPCOES_MENU[] = {
+    "1 - Jogar peça da frente da fila",
+    "2 - Enviar peça da fila para a pilha de reserva",
+    "3 - Usar peça da pilha de reserva",
+    "4 - Trocar peça da frente da fila com o topo da pilha",
+    "5 - Trocar os 3 primeiros da fila com as 3 da pilha",
+    "6 - Jogada automática (bot)",
+    "7 - Trocar as k primeiras da fila com as k da pilha",
+    "8 - Desfazer a última ação",
+    "0 - Sair",
+};
+#define NUM_OPCOES_MENU ((int)(sizeof(OPCOES_MENU) / sizeof(OPCOES_MENU[0])))
+
+// Saída clássica: o estado inteiro e o menu, linha a linha
+void exibirEstadoClassico(EstadoJogo *e) {
+    printf("\n==================== ESTADO ATUAL ====================\n");
+    exibirTabuleiro(&e->tabuleiro);
+    exibirFila(&e->fila);
+    exibirPilha(&e->pilha);
+    printf("=======================================================\n");
+    printf("\nOpções:\n");
+    for (int i = 0; i < NUM_OPCOES_MENU; i++) printf("%s\n", OPCOES_MENU[i]);
+}
+
+// Quadro da tela diferencial: tabuleiro à esquerda (2 colunas por célula),
+// fila, pilha, placar, menu e mensagem à direita
+#define LARGURA_TELA 80
+#define ALTURA_TELA (ALTURA_TABULEIRO + 2)
+#define COLUNA_PAINEL (2 * LARGURA_TABULEIRO + 4)
+
+static int corPeca(char tipo) {
+    switch (tipo) {
+        case 'I': return COR_CIANO;
+        case 'O': return COR_AMARELO;
+        case 'T': return COR_MAGENTA;
+        case 'L': return COR_AMARELO | COR_BRILHANTE;
+        case 'J': return COR_AZUL | COR_BRILHANTE;
+        case 'S': return COR_VERDE;
+        case 'Z': return COR_VERMELHO;
+        default:  return COR_PADRAO;
+    }
+}
+
+// Escreve "[T 12] " a partir de (linha, coluna); retorna a coluna seguinte
+static int desenharPeca(Renderizador *r, int linha, int coluna, Peca p) {
+    coluna = renderizadorTexto(r, linha, coluna, COR_PADRAO, "[");
+    coluna = renderizadorTexto(r, linha, coluna, corPeca(p.tipo) | COR_BRILHANTE, "%c", p.tipo);
+    return renderizadorTexto(r, linha, coluna, COR_PADRAO, " %d] ", p.id);
+}
+
+// Tabuleiro, fila, pilha e placar (linhas 0 a 8 do painel)
+static void desenharJogo(Renderizador *r, EstadoJogo *e) {
+    const Tabuleiro *t = &e->tabuleiro;
+    int x = COLUNA_PAINEL, c;
+
+    renderizadorLimpar(r);
+    for (int l = 0; l < ALTURA_TABULEIRO; l++) {
+        int y = ALTURA_TABULEIRO - l;
+        renderizadorCelula(r, y, 0, '|', COR_PADRAO);
+        for (c = 0; c < LARGURA_TABULEIRO; c++) {
+            int cheia = (t->linhas[l] >> c) & 1;
+            renderizadorCelula(r, y, 1 + 2 * c, cheia ? '[' : ' ', COR_BRANCO);
+            renderizadorCelula(r, y, 2 + 2 * c, cheia ? ']' : '.', cheia ? COR_BRANCO : COR_AZUL);
+        }
+        renderizadorCelula(r, y, 1 + 2 * LARGURA_TABULEIRO, '|', COR_PADRAO);
+    }
+    for (c = 0; c < 2 * LARGURA_TABULEIRO + 2; c++) {
+        uint32_t borda = c == 0 || c == 2 * LARGURA_TABULEIRO + 1 ? '+' : '-';
+        renderizadorCelula(r, 0, c, borda, COR_PADRAO);
+        renderizadorCelula(r, ALTURA_TABULEIRO + 1, c, borda, COR_PADRAO);
+    }
+
+    renderizadorTexto(r, 0, x, COR_BRANCO | COR_BRILHANTE, "TETRIS - Fila e Pilha de Reserva");
+    renderizadorTexto(r, 2, x, COR_PADRAO, "Fila de peças:");
+    c = x;
+    for (int i = 0; i < filaQtd(&e->fila); i++) c = desenharPeca(r, 3, c, *anelEspiar(&e->fila, (uint32_t)i));
+    renderizadorTexto(r, 5, x, COR_PADRAO, "Pilha de reserva (Topo -> Base):");
+    c = x;
+    if (pilhaVazia(&e->pilha)) renderizadorTexto(r, 6, x, COR_PADRAO, "(vazia)");
+    for (int i = e->pilha.topo; i < TAMANHO_PILHA; i++) c = desenharPeca(r, 6, c, e->pilha.itens[i]);
+    renderizadorTexto(r, 8, x, COR_PADRAO, "Linhas: %ld   Peças: %ld   Altura: %d",
+                      t->linhasRemovidas, t->pecasColocadas, t->altura);
+}
+
+void desenharQuadro(Renderizador *r, EstadoJogo *e) {
+    INSTR_CRONOMETRAR("desenharQuadro");
+    desenharJogo(r, e);
+    for (int i = 0; i < NUM_OPCOES_MENU; i++)
+        renderizadorTexto(r, 10 + i, COLUNA_PAINEL, COR_PADRAO, "%s", OPCOES_MENU[i]);
+    renderizadorTexto(r, ALTURA_TABULEIRO, COLUNA_PAINEL, COR_AMARELO | COR_BRILHANTE, "%s", mensagemTela);
+}
+
+// Mostra o estado no modo escolhido (a mensagem acumulada vai junto e é zerada)
+void mostrarEstado(EstadoJogo *e) {
+    if (tela) {
+        desenharQuadro(tela, e);
+        mensagemTela[0] = '\0';
+    } else if (consoleInterativo()) {
+        exibirEstadoClassico(e); // modo silencioso: só as mensagens de cada ação
+    }
+}
+
+// ---------------- Benchmark do tabuleiro ---------------- //
+#define JOGADAS_SORTEADAS 4096  // potência de 2: índice por máscara
+
+typedef struct {
+    char tipo;
+    int rotacao;
+    int coluna;
+} Jogada;
+
+static double tempoMonotonico(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Sorteia uma jogada válida (rotação e coluna dentro do tabuleiro) para a peça
+static Jogada sortearJogada(char tipo) {
+    Jogada j;
+    j.tipo = tipo;
+    j.rotacao = (int)rndLimitado(&randomizador, 4);
+    j.coluna = (int)rndLimitado(&randomizador, LARGURA_TABULEIRO - larguraPeca(tipo, j.rotacao) + 1);
+    return j;
+}
+
+static void relatarBenchmark(const char *nome, long n, double seg, const Tabuleiro *t, long partidas) {
+    printf("%-28s %12ld %10.3f %14.0f %8.1f %10ld %8ld\n", nome, n, seg,
+           seg > 0 ? n / seg : 0.0, seg > 0 ? seg * 1e9 / n : 0.0,
+           t->linhasRemovidas, partidas);
+}
+
+// Joga n peças sem interface: (1) só o motor, com jogadas sorteadas de antemão;
+// (2) o ciclo completo fila -> (pilha) -> tabuleiro -> nova peça na fila
+int benchmarkTabuleiro(long n) {
+    static Jogada jogadas[JOGADAS_SORTEADAS];
+    Tabuleiro t;
     Fila fila;
     Pilha pilha;
+    long i, partidas;
     int contadorID = 0;
-    int opcao;
+    double ini, seg;
+
+    randomizadorSemear(&randomizador, 12345);
+    for (i = 0; i < JOGADAS_SORTEADAS; i++)
+        jogadas[i] = sortearJogada(gerarPeca(0).tipo);
+
+    printf("\n=== Benchmark do tabuleiro (%dx%d, %ld pecas) ===\n",
+           LARGURA_TABULEIRO, ALTURA_TABULEIRO, n);
+    printf("%-28s %12s %10s %14s %8s %10s %8s\n",
+           "modo", "pecas", "tempo(s)", "pecas/s", "ns/peca", "linhas", "partidas");
+
+    // 1) motor puro
+    inicializarTabuleiro(&t);
+    partidas = 1;
+    ini = tempoMonotonico();
+    for (i = 0; i < n; i++) {
+        const Jogada *j = &jogadas[i & (JOGADAS_SORTEADAS - 1)];
+        if (colocarPeca(&t, j->tipo, j->rotacao, j->coluna) < 0) {
+            long linhas = t.linhasRemovidas, pecas = t.pecasColocadas;
+            inicializarTabuleiro(&t); // estouro: nova partida, acumulando os totais
+            t.linhasRemovidas = linhas;
+            t.pecasColocadas = pecas;
+            partidas++;
+        }
+    }
+    seg = tempoMonotonico() - ini;
+    relatarBenchmark("motor (jogadas prontas)", n, seg, &t, partidas);
 
-    srand(time(NULL));
+    // 2) ciclo completo com fila e pilha de reserva
+    inicializarTabuleiro(&t);
     inicializarFila(&fila);
     inicializarPilha(&pilha);
+    reabastecerFila(&fila, &contadorID);
+    partidas = 1;
+    ini = tempoMonotonico();
+    for (i = 0; i < n; i++) {
+        Peca p;
+        if ((i & 15) == 0 && !pilhaCheia(&pilha)) {
+            empilhar(&pilha, desenfileirar(&fila)); // reserva de vez em quando
+            reabastecerFila(&fila, &contadorID);
+        }
+        if (pilhaCheia(&pilha)) {
+            p = desempilhar(&pilha);
+        } else {
+            p = desenfileirar(&fila);
+            reabastecerFila(&fila, &contadorID);
+        }
+        const Jogada *j = &jogadas[i & (JOGADAS_SORTEADAS - 1)];
+        int rotacao = j->rotacao;
+        int coluna = j->coluna;
+        if (coluna + larguraPeca(p.tipo, rotacao) > LARGURA_TABULEIRO) coluna = 0;
+        if (colocarPeca(&t, p.tipo, rotacao, coluna) < 0) {
+            long linhas = t.linhasRemovidas, pecas = t.pecasColocadas;
+            inicializarTabuleiro(&t);
+            t.linhasRemovidas = linhas;
+            t.pecasColocadas = pecas;
+            partidas++;
+        }
+    }
+    seg = tempoMonotonico() - ini;
+    relatarBenchmark("fila + pilha + tabuleiro", n, seg, &t, partidas);
+    return 0;
+}
+
+// ---------------- Bot: busca em feixe com antecipação ---------------- //
+// O bot conhece a peça da frente, as próximas da fila (antecipação) e o topo
+// da pilha. Em cada nível da busca a peça jogada é a próxima da fila ou, se
+// compensar, a reserva (modelando trocarFrentePilha() antes de jogar: a peça
+// da fila passa a ser a nova reserva). Na raiz também é avaliada a variante
+// em que trocarTres() é aplicada antes de tudo.
+//
+// Cada tabuleiro recebe uma nota heurística (altura agregada, buracos,
+// irregularidade e linhas removidas); só os FEIXE melhores estados de cada
+// nível seguem para o próximo. Uma tabela de transposição, indexada pelo hash
+// do tabuleiro, descarta estados repetidos dentro da mesma busca e guarda a
+// nota já calculada para as buscas seguintes.
+
+#define FEIXE_PADRAO 8
+#define PROFUNDIDADE_PADRAO 3
+#define BITS_TRANSPOSICAO 18       // 2^18 entradas na tabela
+
+// Pesos da heurística (ajustados por algoritmo genético, "El-Tetris"/Yiyuan Lee)
+#define PESO_ALTURA   -0.510066
+#define PESO_LINHAS    0.760666
+#define PESO_BURACOS  -0.35663
+#define PESO_IRREGULAR -0.184483
+#define NOTA_MINIMA   -1e300
+
+typedef struct {
+    int trocarTres;  // 1: aplicar trocarTres() antes da jogada
+    int trocar;      // 1: aplicar trocarFrentePilha() antes da jogada
+    int rotacao;
+    int coluna;      // -1: nenhuma jogada possível (fim de jogo)
+    double nota;
+} JogadaBot;
+
+typedef struct {
+    Tabuleiro tab;
+    char reserva;       // topo da pilha neste estado (0 = pilha vazia)
+    long linhas;        // linhas removidas ao longo do caminho
+    double nota;
+    JogadaBot primeira; // primeira jogada do caminho: é a que será executada
+} EstadoBot;
+
+typedef struct {
+    uint64_t chave;
+    uint32_t geracao;   // busca em que o estado foi visto por último
+    double nota;        // nota heurística do tabuleiro (sem as linhas do caminho)
+} EntradaTransposicao;
+
+typedef struct {
+    int feixe;
+    int profundidade;
+    EntradaTransposicao *tabela;
+    uint64_t mascara;
+    uint32_t geracao;
+    EstadoBot *atual, *proximo; // feixes de trabalho (feixe estados cada)
+    long nosAvaliados;          // tabuleiros gerados
+    long repetidos;             // descartados por já estarem no feixe (mesma busca)
+    long notasReaproveitadas;   // notas tiradas da tabela (buscas anteriores)
+} Bot;
 
-    // Inicializa fila com peças
-    for (int i = 0; i < TAMANHO_FILA; i++) {
-        enfileirar(&fila, gerarPeca(contadorID++));
+int inicializarBot(Bot *b, int feixe, int profundidade) {
+    memset(b, 0, sizeof(*b));
+    b->feixe = feixe < 1 ? 1 : feixe;
+    b->profundidade = profundidade < 1 ? 1 : profundidade;
+    b->mascara = (1u << BITS_TRANSPOSICAO) - 1;
+    b->tabela = memZerada(&memBot, (size_t)b->mascara + 1, sizeof(EntradaTransposicao));
+    b->atual = memAlocar(&memBot, b->feixe * sizeof(EstadoBot));
+    b->proximo = memAlocar(&memBot, b->feixe * sizeof(EstadoBot));
+    if (!b->tabela || !b->atual || !b->proximo) {
+        memLiberar(b->tabela);
+        memLiberar(b->atual);
+        memLiberar(b->proximo);
+        return 0;
     }
+    return 1;
+}
 
-    do {
-        printf("\n==================== ESTADO ATUAL ====================\n");
-        exibirFila(&fila);
-        exibirPilha(&pilha);
-        printf("=======================================================\n");
-
-        printf("\nOpções:\n");
-        printf("1 - Jogar peça da frente da fila\n");
-        printf("2 - Enviar peça da fila para a pilha de reserva\n");
-        printf("3 - Usar peça da pilha de reserva\n");
-        printf("4 - Trocar peça da frente da fila com o topo da pilha\n");
-        printf("5 - Trocar os 3 primeiros da fila com as 3 da pilha\n");
-        printf("0 - Sair\n");
-        printf("Escolha: ");
-        scanf("%d", &opcao);
+void liberarBot(Bot *b) {
+    memLiberar(b->tabela);
+    memLiberar(b->atual);
+    memLiberar(b->proximo);
+    memset(b, 0, sizeof(*b));
+}
 
-        switch (opcao) {
-            case 1: {
-                if (!filaVazia(&fila)) {
-                    Peca jogada = desenfileirar(&fila);
-                    printf("\n🎮 Peça jogada: [%c %d]\n", jogada.tipo, jogada.id);
-                    enfileirar(&fila, gerarPeca(contadorID++));
-                }
-                break;
-            }
-            case 2: {
-                if (!filaVazia(&fila) && !pilhaCheia(&pilha)) {
-                    Peca reservada = desenfileirar(&fila);
-                    empilhar(&pilha, reservada);
-                    printf("\n📦 Peça enviada para a pilha: [%c %d]\n", reservada.tipo, reservada.id);
-                    enfileirar(&fila, gerarPeca(contadorID++));
-                }
-                break;
+// Hash do estado: linhas do tabuleiro (lidas de 4 em 4), reserva e número da jogada
+static uint64_t hashEstado(const Tabuleiro *t, char reserva) {
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ ((uint64_t)(unsigned char)reserva << 32) ^ (uint64_t)t->pecasColocadas;
+    for (int i = 0; i < ALTURA_TABULEIRO; i += 4) {
+        uint64_t bloco;
+        memcpy(&bloco, &t->linhas[i], sizeof(bloco));
+        h = (h ^ bloco) * 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 31;
+    }
+    return h;
+}
+
+// Nota heurística do tabuleiro (quanto maior, melhor)
+static double avaliarTabuleiro(const Tabuleiro *t) {
+    int alturaTotal = 0, irregularidade = 0, buracos = 0;
+    uint16_t acima = 0;
+
+    for (int c = 0; c < LARGURA_TABULEIRO; c++) {
+        alturaTotal += t->alturaColuna[c];
+        if (c > 0) irregularidade += abs(t->alturaColuna[c] - t->alturaColuna[c - 1]);
+    }
+    // buraco = célula vazia com algum bloco acima na mesma coluna
+    for (int l = t->altura - 1; l >= 0; l--) {
+        buracos += __builtin_popcount((uint16_t)~t->linhas[l] & acima & LINHA_CHEIA);
+        acima |= t->linhas[l];
+    }
+    return PESO_ALTURA * alturaTotal + PESO_BURACOS * buracos + PESO_IRREGULAR * irregularidade;
+}
+
+// 1 se a rotação r do tipo repete a forma de uma rotação anterior (ex.: O, I)
+static int rotacaoRepetida(int tipo, int r) {
+    for (int anterior = 0; anterior < r; anterior++) {
+        if (memcmp(formaPeca(tipo, anterior)->linhas, formaPeca(tipo, r)->linhas,
+                   sizeof(formaPeca(tipo, r)->linhas)) == 0)
+            return 1;
+    }
+    return 0;
+}
+
+// Coloca o candidato no feixe (ordenado da maior para a menor nota) se couber
+static void inserirNoFeixe(EstadoBot *feixe, int *n, int capacidade, const EstadoBot *e) {
+    int i = *n;
+    if (i == capacidade) {
+        if (e->nota <= feixe[capacidade - 1].nota) return;
+        i--;
+    } else {
+        (*n)++;
+    }
+    while (i > 0 && feixe[i - 1].nota < e->nota) {
+        feixe[i] = feixe[i - 1];
+        i--;
+    }
+    feixe[i] = *e;
+}
+
+// Gera os filhos de todos os estados do feixe atual jogando a peça seq
+static int expandirFeixe(Bot *b, const EstadoBot *atual, int nAtual, char seq,
+                         EstadoBot *proximo, int raiz) {
+    int nProximo = 0;
+
+    for (int e = 0; e < nAtual; e++) {
+        const EstadoBot *origem = &atual[e];
+        // opção 0: joga a peça da fila; opção 1: troca com a reserva e joga a reserva
+        for (int trocar = 0; trocar <= 1; trocar++) {
+            char tipo = seq, reserva = origem->reserva;
+            if (trocar) {
+                if (origem->reserva == 0 || origem->reserva == seq) continue;
+                tipo = origem->reserva;
+                reserva = seq;
             }
-            case 3: {
-                if (!pilhaVazia(&pilha)) {
-                    Peca usada = desempilhar(&pilha);
-                    printf("\n🧱 Peça usada da pilha: [%c %d]\n", usada.tipo, usada.id);
+            int idx = indiceTipoPeca(tipo);
+            for (int r = 0; r < NUM_ROTACOES; r++) {
+                if (rotacaoRepetida(idx, r)) continue;
+                int largura = formaPeca(idx, r)->largura;
+                for (int c = 0; c + largura <= LARGURA_TABULEIRO; c++) {
+                    EstadoBot filho;
+                    filho.tab = origem->tab;
+                    int linhas = colocarPeca(&filho.tab, tipo, r, c);
+                    if (linhas < 0) continue; // estouro: caminho descartado
+                    b->nosAvaliados++;
+
+                    filho.reserva = reserva;
+                    uint64_t chave = hashEstado(&filho.tab, reserva);
+                    EntradaTransposicao *ent = &b->tabela[chave & b->mascara];
+                    double notaTab;
+                    if (ent->chave == chave) {
+                        if (ent->geracao == b->geracao) {
+                            b->repetidos++;
+                            continue;
+                        }
+                        notaTab = ent->nota;
+                        b->notasReaproveitadas++;
+                    } else {
+                        notaTab = avaliarTabuleiro(&filho.tab);
+                        ent->chave = chave;
+                        ent->nota = notaTab;
+                    }
+                    ent->geracao = b->geracao;
+
+                    filho.linhas = origem->linhas + linhas;
+                    filho.nota = notaTab + PESO_LINHAS * filho.linhas;
+                    if (raiz) {
+                        filho.primeira.trocarTres = 0;
+                        filho.primeira.trocar = trocar;
+                        filho.primeira.rotacao = r;
+                        filho.primeira.coluna = c;
+                    } else {
+                        filho.primeira = origem->primeira;
+                    }
+                    inserirNoFeixe(proximo, &nProximo, b->feixe, &filho);
                 }
-                break;
             }
-            case 4:
-                trocarFrentePilha(&fila, &pilha);
-                break;
-            case 5:
-                trocarTres(&fila, &pilha);
-                break;
-            case 0:
-                printf("\n👋 Encerrando o programa...\n");
-                break;
-            default:
-                printf("\n❌ Opção inválida!\n");
         }
-    } while (opcao != 0);
+    }
+    return nProximo;
+}
+
+// Busca em feixe sobre a sequência de peças seq[0..n) partindo do tabuleiro t
+static JogadaBot buscarFeixe(Bot *b, const Tabuleiro *t, const char *seq, int n, char reserva) {
+    JogadaBot melhor = {0, 0, 0, -1, NOTA_MINIMA};
+    int nAtual = 1;
+    int niveis = n < b->profundidade ? n : b->profundidade;
+
+    b->atual[0].tab = *t;
+    b->atual[0].reserva = reserva;
+    b->atual[0].linhas = 0;
+    b->atual[0].nota = 0;
+    b->atual[0].primeira = melhor;
+
+    for (int nivel = 0; nivel < niveis; nivel++) {
+        int nProximo = expandirFeixe(b, b->atual, nAtual, seq[nivel], b->proximo, nivel == 0);
+        if (nProximo == 0) break; // nenhum filho sobrevive: fica com o melhor do nível anterior
+        EstadoBot *troca = b->atual;
+        b->atual = b->proximo;
+        b->proximo = troca;
+        nAtual = nProximo;
+        melhor = b->atual[0].primeira;
+        melhor.nota = b->atual[0].nota;
+    }
+    return melhor;
+}
+
+// Copia os tipos da fila (da frente para o fim) em seq; retorna quantos
+int sequenciaFila(Fila *f, char *seq) {
+    Peca pecas[TAMANHO_FILA];
+    int n = anelEspiarIntervalo(f, 0, pecas, TAMANHO_FILA);
+    for (int i = 0; i < n; i++) seq[i] = pecas[i].tipo;
+    return n;
+}
+
+// Escolhe a melhor jogada para o estado atual do jogo
+JogadaBot escolherJogadaBot(Bot *b, Fila *f, Pilha *p, const Tabuleiro *t) {
+    INSTR_CRONOMETRAR("escolherJogadaBot");
+    char seq[TAMANHO_FILA];
+    int n = sequenciaFila(f, seq);
+    char reserva = pilhaVazia(p) ? 0 : p->itens[p->topo].tipo;
+    JogadaBot melhor;
+
+    b->geracao++;
+    melhor = buscarFeixe(b, t, seq, n, reserva);
+
+    // variante: trocarTres() antes de jogar (as 3 da pilha passam à frente da fila)
+    if (filaQtd(f) >= 3 && pilhaQtd(p) >= 3) {
+        char seqTres[TAMANHO_FILA];
+        memcpy(seqTres, seq, n);
+        for (int i = 0; i < 3; i++) seqTres[i] = p->itens[p->topo + i].tipo;
+        b->geracao++;
+        JogadaBot alternativa = buscarFeixe(b, t, seqTres, n, seq[0]);
+        if (alternativa.coluna >= 0 && alternativa.nota > melhor.nota) {
+            melhor = alternativa;
+            melhor.trocarTres = 1;
+        }
+    }
+    return melhor;
+}
+
+// Aplica a jogada do bot ao jogo. Retorna as linhas removidas ou -1 (fim de jogo).
+int executarJogadaBot(Fila *f, Pilha *p, Tabuleiro *t, int *contadorID, JogadaBot j, Peca *jogada) {
+    if (j.coluna < 0) return -1;
+    if (j.trocarTres) trocarTres(f, p);
+    if (j.trocar) trocarFrentePilha(f, p);
+    *jogada = desenfileirar(f);
+    reabastecerFila(f, contadorID);
+    return colocarPeca(t, jogada->tipo, j.rotacao, j.coluna);
+}
+
+// Partidas automáticas: o bot joga n peças e o desempenho é medido
+int benchmarkBot(long n, int feixe, int profundidade) {
+    Bot bot;
+    Tabuleiro t;
+    Fila fila;
+    Pilha pilha;
+    int contadorID = 0;
+    long partidas = 1, linhasTotais = 0, trocas = 0, trocasTres = 0;
+    double ini, seg;
+
+    if (!inicializarBot(&bot, feixe, profundidade)) {
+        printf("Erro: memória insuficiente para o bot.\n");
+        return 1;
+    }
+    randomizadorSemear(&randomizador, 12345);
+    inicializarTabuleiro(&t);
+    inicializarFila(&fila);
+    inicializarPilha(&pilha);
+    reabastecerFila(&fila, &contadorID);
+    // enche a pilha de reserva para que as trocas estejam disponíveis
+    while (!pilhaCheia(&pilha)) {
+        empilhar(&pilha, desenfileirar(&fila));
+        reabastecerFila(&fila, &contadorID);
+    }
+
+    printf("\n=== Bot: %ld peças, feixe %d, profundidade %d (fila %d, pilha %d) ===\n",
+           n, bot.feixe, bot.profundidade, TAMANHO_FILA, TAMANHO_PILHA);
+    ini = tempoMonotonico();
+    for (long i = 0; i < n; i++) {
+        Peca jogada;
+        JogadaBot j = escolherJogadaBot(&bot, &fila, &pilha, &t);
+        trocas += j.trocar;
+        trocasTres += j.trocarTres;
+        int linhas = executarJogadaBot(&fila, &pilha, &t, &contadorID, j, &jogada);
+        if (linhas < 0) {
+            long pecas = t.pecasColocadas;
+            inicializarTabuleiro(&t); // fim de jogo: recomeça mantendo a contagem
+            t.pecasColocadas = pecas;
+            partidas++;
+        } else {
+            linhasTotais += linhas;
+        }
+    }
+    seg = tempoMonotonico() - ini;
+
+    printf("Tempo: %.3f s | %.0f peças/s | %.1f us/peça\n", seg, seg > 0 ? n / seg : 0.0,
+           seg * 1e6 / n);
+    printf("Linhas removidas: %ld (%.3f por peça, %.1f por partida) | partidas: %ld\n",
+           linhasTotais, (double)linhasTotais / n, (double)linhasTotais / partidas, partidas);
+    printf("Trocas com a reserva: %ld | trocas de 3: %ld\n", trocas, trocasTres);
+    printf("Tabuleiros gerados: %ld (%.0f por peça) | repetidos descartados: %ld | notas reaproveitadas: %ld\n",
+           bot.nosAvaliados, (double)bot.nosAvaliados / n, bot.repetidos, bot.notasReaproveitadas);
+    liberarBot(&bot);
+    return 0;
+}
+
+// ---------------- Gerador de peças em thread (fila SPSC) ---------------- //
+// Para a simulação sem interface: uma thread produtora gera as peças com
+// antecedência numa fila sem travas (um produtor, um consumidor), e o laço do
+// jogo só retira a próxima peça pronta, sem esperar pelo sorteio.
+
+#define CAPACIDADE_GERADOR 1024
+
+FILA_SPSC_DECLARAR(FilaGerada, Peca, CAPACIDADE_GERADOR, spsc)
+
+// O que o produtor faz quando a fila está cheia (e o consumidor quando está vazia)
+typedef enum {
+    ESPERA_GIRAR,   // espera ativa com pausa de CPU (menor latência, ocupa um núcleo)
+    ESPERA_CEDER,   // sched_yield(): devolve o núcleo ao escalonador
+    ESPERA_DORMIR   // dorme 50 us: quase não gasta CPU, reage mais devagar
+} PoliticaEspera;
+
+static const char *NOMES_POLITICA[] = {"girar", "ceder", "dormir"};
+
+typedef struct {
+    FilaGerada fila;          // primeiro campo: herda o alinhamento de 64 bytes
+    pthread_t thread;
+    _Atomic int parar;
+    PoliticaEspera politica;
+    Randomizador rnd;         // sorteio próprio da thread (mesmo modo do jogo)
+    int proximoID;
+    long esperasProdutor;     // vezes que a fila estava cheia (lido após o join)
+    long esperasConsumidor;   // vezes que a fila estava vazia
+} GeradorPecas;
+
+static void aguardarVez(PoliticaEspera politica) {
+    if (politica == ESPERA_GIRAR) {
+        fsPausa();
+    } else if (politica == ESPERA_CEDER) {
+        sched_yield();
+    } else {
+        struct timespec pausa = {0, 50000};
+        nanosleep(&pausa, NULL);
+    }
+}
+
+static void *threadGeradora(void *arg) {
+    GeradorPecas *g = arg;
+
+    while (!atomic_load_explicit(&g->parar, memory_order_relaxed)) {
+        Peca nova;
+        nova.tipo = randomizadorProxima(&g->rnd);
+        nova.id = g->proximoID;
+        while (!spscProduzir(&g->fila, &nova)) { // fila cheia: contrapressão
+            if (atomic_load_explicit(&g->parar, memory_order_relaxed)) return NULL;
+            g->esperasProdutor++;
+            INSTR_CONTAR("gerador.esperasProdutor");
+            aguardarVez(g->politica);
+        }
+        g->proximoID++;
+        INSTR_CONTAR("gerador.pecas");
+    }
+    return NULL;
+}
+
+GeradorPecas *iniciarGerador(PoliticaEspera politica, uint64_t semente, int primeiroID) {
+    GeradorPecas *g = aligned_alloc(FS_LINHA_CACHE, sizeof(GeradorPecas));
+    if (g == NULL) return NULL;
+    spscInicializar(&g->fila);
+    atomic_init(&g->parar, 0);
+    g->politica = politica;
+    g->rnd = randomizador;
+    randomizadorSemear(&g->rnd, semente);
+    g->proximoID = primeiroID;
+    g->esperasProdutor = 0;
+    g->esperasConsumidor = 0;
+    if (pthread_create(&g->thread, NULL, threadGeradora, g) != 0) {
+        free(g);
+        return NULL;
+    }
+    return g;
+}
+
+// Próxima peça pronta; só espera se o produtor ficou para trás
+Peca proximaPecaGerada(GeradorPecas *g) {
+    Peca p;
+    while (!spscConsumir(&g->fila, &p)) {
+        g->esperasConsumidor++;
+        INSTR_CONTAR("gerador.esperasConsumidor");
+        aguardarVez(g->politica);
+    }
+    return p;
+}
+
+// Encerra a thread e libera o gerador; retorna quantas vezes o produtor esperou
+long pararGerador(GeradorPecas *g) {
+    long esperas;
+    atomic_store_explicit(&g->parar, 1, memory_order_relaxed);
+    pthread_join(g->thread, NULL);
+    esperas = g->esperasProdutor;
+    free(g);
+    return esperas;
+}
+
+// Histograma de latência com resolução de 1 ns até 100 us (acima disso: última faixa)
+#define FAIXAS_LATENCIA 100000
+
+typedef struct {
+    long faixas[FAIXAS_LATENCIA + 1];
+    long total;
+    long maximo;
+} HistogramaLatencia;
+
+static void registrarLatencia(HistogramaLatencia *h, long ns) {
+    if (ns < 0) ns = 0;
+    h->faixas[ns < FAIXAS_LATENCIA ? ns : FAIXAS_LATENCIA]++;
+    h->total++;
+    if (ns > h->maximo) h->maximo = ns;
+}
+
+static long percentilLatencia(const HistogramaLatencia *h, double p) {
+    long alvo = (long)(p * h->total), acumulado = 0;
+    for (long i = 0; i <= FAIXAS_LATENCIA; i++) {
+        acumulado += h->faixas[i];
+        if (acumulado > alvo) return i < FAIXAS_LATENCIA ? i : h->maximo;
+    }
+    return h->maximo;
+}
+
+static long nsDesde(const struct timespec *a, const struct timespec *b) {
+    return (b->tv_sec - a->tv_sec) * 1000000000L + (b->tv_nsec - a->tv_nsec);
+}
+
+// Trabalho do laço do jogo por peça: derruba a peça no tabuleiro
+static void jogarPecaSimulada(Tabuleiro *t, Peca p, long i) {
+    int rotacao = (int)(i & 3);
+    int coluna = (int)(i % (LARGURA_TABULEIRO - larguraPeca(p.tipo, rotacao) + 1));
+    if (colocarPeca(t, p.tipo, rotacao, coluna) < 0) {
+        long linhas = t->linhasRemovidas, pecas = t->pecasColocadas;
+        inicializarTabuleiro(t);
+        t->linhasRemovidas = linhas;
+        t->pecasColocadas = pecas;
+    }
+}
+
+static void relatarGerador(const char *nome, long n, double seg, const HistogramaLatencia *h,
+                           long esperasProd, long esperasCons) {
+    printf("%-22s %12.0f %7ld %7ld %8ld %9ld %12ld %12ld\n", nome, seg > 0 ? n / seg : 0.0,
+           percentilLatencia(h, 0.50), percentilLatencia(h, 0.99), percentilLatencia(h, 0.999),
+           h->maximo, esperasProd, esperasCons);
+}
+
+// Compara gerar a peça no próprio laço (gerarPeca) com retirá-la da fila SPSC
+// alimentada pela thread geradora, em cada política de espera
+int benchmarkGerador(long n) {
+    HistogramaLatencia *h = malloc(sizeof(HistogramaLatencia));
+    Tabuleiro t;
+    struct timespec a, b;
+    double ini, seg;
+    long relogio = 0;
+
+    if (h == NULL) return 1;
+    for (int i = 0; i < 1000; i++) { // custo de uma leitura do relógio (incluído nas latências)
+        clock_gettime(CLOCK_MONOTONIC, &a);
+        clock_gettime(CLOCK_MONOTONIC, &b);
+        relogio += nsDesde(&a, &b);
+    }
+
+    printf("\n=== Benchmark do gerador de peças (%ld peças, fila SPSC de %d) ===\n", n,
+           CAPACIDADE_GERADOR);
+    printf("Latência = tempo para obter a próxima peça, em ns (inclui ~%ld ns do relógio)\n",
+           relogio / 1000);
+    printf("%-22s %12s %7s %7s %8s %9s %12s %12s\n", "modo", "pecas/s", "p50", "p99", "p99.9",
+           "max", "esp.produtor", "esp.consum.");
+
+    // 1) síncrono: gerarPeca() dentro do laço
+    memset(h, 0, sizeof(*h));
+    inicializarTabuleiro(&t);
+    randomizadorSemear(&randomizador, 12345);
+    ini = tempoMonotonico();
+    for (long i = 0; i < n; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &a);
+        Peca p = gerarPeca((int)i);
+        clock_gettime(CLOCK_MONOTONIC, &b);
+        registrarLatencia(h, nsDesde(&a, &b));
+        jogarPecaSimulada(&t, p, i);
+    }
+    seg = tempoMonotonico() - ini;
+    relatarGerador("sincrono (gerarPeca)", n, seg, h, 0, 0);
+
+    // 2) thread geradora + fila SPSC, uma rodada por política
+    for (int pol = ESPERA_GIRAR; pol <= ESPERA_DORMIR; pol++) {
+        char nome[32];
+        long ultimoID = -1, foraDeOrdem = 0;
+        GeradorPecas *g = iniciarGerador((PoliticaEspera)pol, 12345, 0);
+        if (g == NULL) {
+            printf("Erro ao criar a thread geradora.\n");
+            free(h);
+            return 1;
+        }
+        memset(h, 0, sizeof(*h));
+        inicializarTabuleiro(&t);
+        ini = tempoMonotonico();
+        for (long i = 0; i < n; i++) {
+            clock_gettime(CLOCK_MONOTONIC, &a);
+            Peca p = proximaPecaGerada(g);
+            clock_gettime(CLOCK_MONOTONIC, &b);
+            registrarLatencia(h, nsDesde(&a, &b));
+            if (p.id != ultimoID + 1) foraDeOrdem++;
+            ultimoID = p.id;
+            jogarPecaSimulada(&t, p, i);
+        }
+        seg = tempoMonotonico() - ini;
+        long esperasCons = g->esperasConsumidor;
+        long esperasProd = pararGerador(g);
+        snprintf(nome, sizeof(nome), "spsc (%s)", NOMES_POLITICA[pol]);
+        relatarGerador(nome, n, seg, h, esperasProd, esperasCons);
+        if (foraDeOrdem) printf("   ERRO: %ld peças fora de ordem!\n", foraDeOrdem);
+    }
+    free(h);
+    return 0;
+}
+
+// ---------------- Benchmark do randomizador ---------------- //
+#define LOTE_RANDOMIZADOR 65536
+
+typedef struct {
+    long contagem[256];
+    long ultimaPos[256];
+    long secaMaxima;   // maior intervalo entre duas peças iguais
+    long repeticoes;   // mesma peça duas vezes seguidas
+    long total;
+    char anterior;
+} QualidadeSorteio;
+
+static void acumularQualidade(QualidadeSorteio *q, const char *tipos, long n) {
+    for (long i = 0; i < n; i++) {
+        unsigned char t = (unsigned char)tipos[i];
+        long pos = q->total + i;
+        if (pos - q->ultimaPos[t] > q->secaMaxima) q->secaMaxima = pos - q->ultimaPos[t];
+        q->ultimaPos[t] = pos;
+        q->contagem[t]++;
+        q->repeticoes += (tipos[i] == q->anterior);
+        q->anterior = tipos[i];
+    }
+    q->total += n;
+}
+
+static void relatarSorteio(const char *nome, long n, double seg, const QualidadeSorteio *q,
+                           const char *tipos, const double *pesos) {
+    double soma = 0, quiQuadrado = 0;
+    int k = (int)strlen(tipos);
+    for (int i = 0; i < k; i++) soma += pesos[i];
+    for (int i = 0; i < k; i++) {
+        double esperado = n * pesos[i] / soma;
+        double d = q->contagem[(unsigned char)tipos[i]] - esperado;
+        if (esperado > 0) quiQuadrado += d * d / esperado;
+    }
+    printf("%-22s %8.1f %7.2f %10.1f %6ld %8.2f%%  ", nome, seg > 0 ? n / seg / 1e6 : 0.0,
+           seg * 1e9 / n, quiQuadrado, q->secaMaxima, 100.0 * q->repeticoes / n);
+    for (int i = 0; i < k; i++)
+        printf("%c:%.1f ", tipos[i], 100.0 * q->contagem[(unsigned char)tipos[i]] / n);
+    printf("\n");
+}
+
+// Sorteia n peças em lotes com cada modo e mede velocidade e qualidade da sequência
+int benchmarkRandomizador(long n, const double *pesosPonderado) {
+    static char lote[LOTE_RANDOMIZADOR];
+    static QualidadeSorteio q;
+    const double iguais[MAX_TIPOS_RANDOMIZADOR] = {1, 1, 1, 1, 1, 1, 1};
+    double seg;
+
+    printf("\n=== Benchmark do randomizador (%ld peças, lotes de %d) ===\n", n, LOTE_RANDOMIZADOR);
+    printf("(qui² com 6 graus de liberdade: ~12.6 é o limite de 95%% para uma distribuição correta)\n");
+    printf("%-22s %8s %7s %10s %6s %9s  %s\n", "modo", "Mpecas/s", "ns/pc", "qui2", "seca",
+           "repetidas", "frequencias (%)");
+
+    // referência: o sorteio antigo, rand() % 4 entre I/O/T/L
+    memset(&q, 0, sizeof(q));
+    seg = 0;
+    srand(12345);
+    for (long feitos = 0; feitos < n; feitos += LOTE_RANDOMIZADOR) {
+        long k = n - feitos < LOTE_RANDOMIZADOR ? n - feitos : LOTE_RANDOMIZADOR;
+        double ini = tempoMonotonico();
+        for (long i = 0; i < k; i++) lote[i] = "IOTL"[rand() % 4];
+        seg += tempoMonotonico() - ini;
+        acumularQualidade(&q, lote, k);
+    }
+    relatarSorteio("antigo (rand() % 4)", n, seg, &q, "IOTL", iguais);
+
+    for (int modo = RAND_UNIFORME; modo <= RAND_PONDERADO; modo++) {
+        Randomizador r;
+        const double *pesos = modo == RAND_PONDERADO ? pesosPonderado : iguais;
+        randomizadorInicializar(&r, (ModoRandomizador)modo, TIPOS_JOGO, 12345);
+        if (modo == RAND_PONDERADO) randomizadorDefinirPesos(&r, pesos);
+
+        memset(&q, 0, sizeof(q));
+        seg = 0;
+        for (long feitos = 0; feitos < n; feitos += LOTE_RANDOMIZADOR) {
+            long k = n - feitos < LOTE_RANDOMIZADOR ? n - feitos : LOTE_RANDOMIZADOR;
+            double ini = tempoMonotonico();
+            randomizadorPreencher(&r, lote, (size_t)k);
+            seg += tempoMonotonico() - ini;
+            acumularQualidade(&q, lote, k);
+        }
+        relatarSorteio(NOMES_MODO_RANDOMIZADOR[modo], n, seg, &q, TIPOS_JOGO, pesos);
+    }
 
+    // fila do jogo reabastecida em lote (4 peças saem, 4 são sorteadas e entram)
+    {
+        Fila fila;
+        Peca saida[4];
+        int contadorID = 0;
+        long rodadas = n / 4, soma = 0;
+        inicializarFila(&fila);
+        reabastecerFila(&fila, &contadorID);
+        double ini = tempoMonotonico();
+        for (long i = 0; i < rodadas; i++) {
+            anelDesenfileirarLote(&fila, saida, 4);
+            soma += saida[3].id;
+            reabastecerFila(&fila, &contadorID);
+        }
+        seg = tempoMonotonico() - ini;
+        printf("%-22s %8.1f %7.2f   (modo %s, soma %ld)\n", "fila (reabastecer)",
+               seg > 0 ? 4.0 * rodadas / seg / 1e6 : 0.0, seg * 1e9 / (4.0 * rodadas),
+               NOMES_MODO_RANDOMIZADOR[randomizador.modo], soma);
+    }
     return 0;
-}
\ No newline at end of file
+}
+
+// ---------------- Benchmark da troca em bloco ---------------- //
+// Compara a troca elemento a elemento (anelEspiar() a cada peça, como era
+// trocarTres()) com trocarBloco() para k = 1, 2, 4, ... até o menor entre
+// TAMANHO_FILA e TAMANHO_PILHA. A cada rodada a fila gira uma posição, de modo
+// que o trecho trocado atravessa o fim do anel em parte das rodadas.
+// Para filas profundas: compilar com -DTAMANHO_FILA=4096 -DTAMANHO_PILHA=4096.
+
+static int trocarBlocoElementoAElemento(Fila *f, Pilha *p, int k) {
+    if (k < 1 || filaQtd(f) < k || pilhaQtd(p) < k) return 0;
+    for (int i = 0; i < k; i++) {
+        Peca *naFila = anelEspiar(f, i);
+        Peca temp = *naFila;
+        *naFila = p->itens[p->topo + i];
+        p->itens[p->topo + i] = temp;
+    }
+    return 1;
+}
+
+// Executa 'rodadas' trocas de k peças; retorna os segundos gastos
+static double medirTroca(int (*trocar)(Fila *, Pilha *, int), Fila *f, Pilha *p, int k,
+                         long rodadas) {
+    double ini = tempoMonotonico();
+    for (long r = 0; r < rodadas; r++) {
+        trocar(f, p, k);
+        Peca girada = desenfileirar(f);
+        enfileirar(f, girada);
+    }
+    return tempoMonotonico() - ini;
+}
+
+// n = total aproximado de peças trocadas por k
+int benchmarkTroca(long n) {
+    static Fila fila;   // static: com tamanhos grandes não cabe na pilha de chamadas
+    static Pilha pilha;
+    int contadorID = 0;
+    long somaIDs = 0;
+
+    inicializarFila(&fila);
+    inicializarPilha(&pilha);
+    reabastecerFila(&fila, &contadorID);
+    while (!pilhaCheia(&pilha)) empilhar(&pilha, gerarPeca(contadorID++));
+
+    printf("\n=== Troca em bloco fila <-> pilha (fila %d, pilha %d, %zu bytes/peca, ~%ld pecas por k) ===\n",
+           TAMANHO_FILA, TAMANHO_PILHA, sizeof(Peca), n);
+    printf("%8s %12s | %12s %9s %8s | %12s %9s %8s | %8s\n", "k", "rodadas", "elem(ns/tr)",
+           "ns/peca", "GB/s", "bloco(ns/tr)", "ns/peca", "GB/s", "ganho");
+    for (int k = 1;; k = k * 2 > MAIOR_BLOCO && k < MAIOR_BLOCO ? MAIOR_BLOCO : k * 2) {
+        long rodadas = n / k > 0 ? n / k : 1;
+        double bytes = 2.0 * k * sizeof(Peca) * rodadas; // cada peça é lida e escrita dos dois lados
+        double segElem = medirTroca(trocarBlocoElementoAElemento, &fila, &pilha, k, rodadas);
+        double segBloco = medirTroca(trocarBloco, &fila, &pilha, k, rodadas);
+        printf("%8d %12ld | %12.1f %9.3f %8.2f | %12.1f %9.3f %8.2f | %7.2fx\n", k, rodadas,
+               segElem * 1e9 / rodadas, segElem * 1e9 / rodadas / k, bytes / segElem / 1e9,
+               segBloco * 1e9 / rodadas, segBloco * 1e9 / rodadas / k, bytes / segBloco / 1e9,
+               segBloco > 0 ? segElem / segBloco : 0.0);
+        if (k >= MAIOR_BLOCO) break;
+    }
+
+    // as trocas só permutam peças: o conjunto de IDs tem de continuar o mesmo
+    for (int i = 0; i < filaQtd(&fila); i++) somaIDs += anelEspiar(&fila, (uint32_t)i)->id;
+    for (int i = pilha.topo; i < TAMANHO_PILHA; i++) somaIDs += pilha.itens[i].id;
+    if (somaIDs != (long)contadorID * (contadorID - 1) / 2) {
+        printf("ERRO: peças perdidas ou duplicadas nas trocas!\n");
+        return 1;
+    }
+    return 0;
+}
+
+// ---------------- Modo sem tela: script ou mistura de operações ---------------- //
+// Executa uma sequência de opções do menu sem exibir nada e mede o custo das
+// estruturas. A sequência vem de um arquivo (--script, uma operação por linha)
+// ou é sorteada (--mix n, proporções em --proporcao). Duas passagens a partir
+// do mesmo estado inicial: a primeira mede só a vazão (sem relógio por
+// operação); a segunda cronometra cada operação num histograma log2 por tipo.
+// As duas devem terminar no mesmo estado (conferido pelo hash do tabuleiro).
+//
+// Formato do script ('#' inicia comentário; números 1-5 valem como as opções):
+//     jogar [rotacao [coluna]]    reservar    usar [rotacao [coluna]]
+//     trocar                      trocar3       trocark k
+// Sem coluna, a jogada usa uma coluna válida sorteada na leitura do script.
+
+#define FAIXAS_LOG2 40         // faixa k: [2^(k-1), 2^k) ns; faixa 0: 0 ns
+#define MIX_PADRAO 10000000
+
+typedef enum {
+    OP_JOGAR, OP_RESERVAR, OP_USAR, OP_TROCAR, OP_TROCAR_TRES, OP_TROCAR_BLOCO, NUM_OPERACOES
+} Operacao;
+static const char *NOMES_OPERACAO[NUM_OPERACOES] = {"jogar", "reservar", "usar",
+                                                    "trocar", "trocar3", "trocark"};
+
+typedef struct {
+    uint8_t op;
+    uint8_t rotacao;
+    uint8_t sorteio;    // escolhe a coluna quando coluna < 0
+    int8_t coluna;
+    uint16_t quantidade; // k de trocark
+} Comando;
+
+typedef struct {
+    long executadas, impossiveis;
+    long faixas[FAIXAS_LOG2];
+    long nsTotal, nsMax;
+} EstatisticaOperacao;
+
+typedef struct {
+    long linhas, pecas, fimDeJogo, invalidas;
+} TotaisSemTela;
+
+static int lerOperacao(const char *nome) {
+    for (int op = 0; op < NUM_OPERACOES; op++)
+        if (strcmp(nome, NOMES_OPERACAO[op]) == 0) return op;
+    if (nome[0] == '7' && nome[1] == '\0') return OP_TROCAR_BLOCO;
+    if (nome[0] >= '1' && nome[0] <= '5' && nome[1] == '\0') return nome[0] - '1';
+    return -1;
+}
+
+// Lê o script inteiro para um vetor de comandos (a leitura não entra na medição)
+static Comando *lerScript(const char *caminho, long *n) {
+    FILE *arq = fopen(caminho, "r");
+    char linha[256], nome[32];
+    long capacidade = 1024, numLinha = 0;
+    Comando *cmds;
+
+    if (!arq) {
+        printf("Não foi possível abrir o script %s\n", caminho);
+        return NULL;
+    }
+    cmds = memAlocar(&memComandos, capacidade * sizeof(Comando));
+    *n = 0;
+    while (cmds && fgets(linha, sizeof(linha), arq)) {
+        int rotacao = 0, coluna = -1, op;
+        char *comentario = strchr(linha, '#');
+        numLinha++;
+        if (comentario) *comentario = '\0';
+        // em trocark o primeiro número é k
+        if (sscanf(linha, "%31s %d %d", nome, &rotacao, &coluna) < 1) continue;
+        op = lerOperacao(nome);
+        if (op < 0 || coluna > LARGURA_TABULEIRO || (op == OP_TROCAR_BLOCO && (rotacao < 1 || rotacao > 65535))) {
+            printf("%s:%ld: operação inválida: %s", caminho, numLinha, linha);
+            memLiberar(cmds);
+            fclose(arq);
+            return NULL;
+        }
+        if (*n == capacidade) {
+            Comando *maior = memRealocar(&memComandos, cmds, 2 * capacidade * sizeof(Comando));
+            if (!maior) { memLiberar(cmds); cmds = NULL; break; }
+            cmds = maior;
+            capacidade *= 2;
+        }
+        cmds[*n].op = (uint8_t)op;
+        cmds[*n].rotacao = (uint8_t)(rotacao & 3);
+        cmds[*n].sorteio = (uint8_t)rndLimitado(&randomizador, 256);
+        cmds[*n].coluna = (int8_t)(coluna < 0 ? -1 : coluna);
+        cmds[*n].quantidade = (uint16_t)(op == OP_TROCAR_BLOCO ? rotacao : 0);
+        (*n)++;
+    }
+    fclose(arq);
+    if (!cmds) printf("Erro: memória insuficiente para o script.\n");
+    return cmds;
+}
+
+// Sorteia n comandos com as proporções dadas (jogar, reservar, usar, trocar, trocar3, trocark)
+static Comando *gerarMistura(long n, const double *proporcao) {
+    Comando *cmds = memAlocar(&memComandos, n * sizeof(Comando));
+    uint32_t limiar[NUM_OPERACOES];
+    uint8_t alias[NUM_OPERACOES];
+    if (!cmds || !rndMontarAlias(proporcao, NUM_OPERACOES, limiar, alias)) {
+        memLiberar(cmds);
+        return NULL;
+    }
+    for (long i = 0; i < n; i++) {
+        uint64_t x = rndProximo(&randomizador); // o alias usa os 64 bits
+        uint64_t y = rndProximo(&randomizador);
+        cmds[i].op = (uint8_t)rndAlias(x, NUM_OPERACOES, limiar, alias);
+        cmds[i].rotacao = (uint8_t)(y & 3);
+        cmds[i].sorteio = (uint8_t)(y >> 8);
+        cmds[i].coluna = -1;
+        cmds[i].quantidade = (uint16_t)(1 + rndLimitado(&randomizador, MAIOR_BLOCO));
+    }
+    return cmds;
+}
+
+// Coluna do comando para a peça do tipo dado (sorteada entre as válidas se coluna < 0)
+static inline int colunaComando(Comando c, char tipo) {
+    return c.coluna >= 0 ? c.coluna
+                         : c.sorteio % (LARGURA_TABULEIRO - larguraPeca(tipo, c.rotacao) + 1);
+}
+
+// Executa um comando; retorna o resultado da ação (ACAO_* ou linhas removidas)
+static inline int executarComando(EstadoJogo *e, Comando c) {
+    Peca p;
+    switch (c.op) {
+        case OP_JOGAR:
+        case OP_USAR: {
+            const Peca *alvo = c.op == OP_JOGAR ? anelEspiar(&e->fila, 0)
+                             : pilhaVazia(&e->pilha) ? NULL : &e->pilha.itens[e->pilha.topo];
+            if (!alvo) return ACAO_IMPOSSIVEL;
+            int coluna = colunaComando(c, alvo->tipo);
+            return c.op == OP_JOGAR ? acaoJogar(e, c.rotacao, coluna, &p)
+                                    : acaoUsarReserva(e, c.rotacao, coluna, &p);
+        }
+        case OP_RESERVAR:
+            return acaoReservar(e, &p);
+        case OP_TROCAR:
+            return trocarFrentePilha(&e->fila, &e->pilha) ? 0 : ACAO_IMPOSSIVEL;
+        case OP_TROCAR_TRES:
+            return trocarTres(&e->fila, &e->pilha) ? 0 : ACAO_IMPOSSIVEL;
+        case OP_TROCAR_BLOCO:
+            return trocarBloco(&e->fila, &e->pilha, c.quantidade) ? 0 : ACAO_IMPOSSIVEL;
+    }
+    return ACAO_IMPOSSIVEL;
+}
+
+static inline void contarResultado(TotaisSemTela *tot, const Comando *c, int r) {
+    if (r >= 0 && (c->op == OP_JOGAR || c->op == OP_USAR)) {
+        tot->pecas++;
+        tot->linhas += r;
+    } else if (r == ACAO_FIM_DE_JOGO) {
+        tot->fimDeJogo++;
+    } else if (r == ACAO_INVALIDA) {
+        tot->invalidas++;
+    }
+}
+
+static inline int faixaLog2(long ns) {
+    int k = ns > 0 ? 64 - __builtin_clzl((unsigned long)ns) : 0;
+    return k < FAIXAS_LOG2 ? k : FAIXAS_LOG2 - 1;
+}
+
+// Limite superior (ns) da faixa onde o percentil p cai
+static long percentilLog2(const EstatisticaOperacao *s, double p) {
+    long alvo = (long)(p * s->executadas), acumulado = 0;
+    for (int k = 0; k < FAIXAS_LOG2; k++) {
+        acumulado += s->faixas[k];
+        if (acumulado > alvo) return k == 0 ? 0 : 1L << k;
+    }
+    return s->nsMax;
+}
+
+// Custo mediano de um par de leituras do relógio (descontado de cada medição)
+static int compararLong(const void *a, const void *b) {
+    long x = *(const long *)a, y = *(const long *)b;
+    return (x > y) - (x < y);
+}
+
+static long sobrecargaRelogio(void) {
+    static long amostras[10001];
+    struct timespec a, b;
+    for (int i = 0; i < 10001; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &a);
+        clock_gettime(CLOCK_MONOTONIC, &b);
+        amostras[i] = nsDesde(&a, &b);
+    }
+    qsort(amostras, 10001, sizeof(long), compararLong);
+    return amostras[5000];
+}
+
+static uint64_t hashJogo(const EstadoJogo *e) {
+    char reserva = e->pilha.topo == TAMANHO_PILHA ? 0 : e->pilha.itens[e->pilha.topo].tipo;
+    uint64_t h = hashEstado(&e->tabuleiro, reserva);
+    return h ^ (uint64_t)e->contadorID * 0x9E3779B97F4A7C15ull ^ (uint64_t)(e->pilha.topo + 1);
+}
+
+static void relatarSemTela(const EstatisticaOperacao *est, long sobrecarga) {
+    printf("\n%-9s %11s %11s %9s %8s %8s %8s %10s\n", "operacao", "executadas", "impossiveis",
+           "media(ns)", "p50", "p99", "p99.9", "max(ns)");
+    for (int op = 0; op < NUM_OPERACOES; op++) {
+        const EstatisticaOperacao *s = &est[op];
+        if (s->executadas == 0) continue;
+        printf("%-9s %11ld %11ld %9.1f %8ld %8ld %8ld %10ld\n", NOMES_OPERACAO[op], s->executadas,
+               s->impossiveis, (double)s->nsTotal / s->executadas, percentilLog2(s, 0.50),
+               percentilLog2(s, 0.99), percentilLog2(s, 0.999), s->nsMax);
+    }
+    printf("(percentis: limite superior da faixa log2; descontados %ld ns do relógio por medição)\n",
+           sobrecarga);
+
+    printf("\nHistogramas (ns, faixas log2):\n");
+    for (int op = 0; op < NUM_OPERACOES; op++) {
+        const EstatisticaOperacao *s = &est[op];
+        long maior = 0;
+        if (s->executadas == 0) continue;
+        for (int k = 0; k < FAIXAS_LOG2; k++)
+            if (s->faixas[k] > maior) maior = s->faixas[k];
+        printf("%s\n", NOMES_OPERACAO[op]);
+        for (int k = 0; k < FAIXAS_LOG2; k++) {
+            if (s->faixas[k] == 0) continue;
+            int barra = (int)(40.0 * s->faixas[k] / maior + 0.5);
+            printf("  [%7ld, %7ld) %11ld %6.2f%% ", k == 0 ? 0 : 1L << (k - 1), k == 0 ? 1 : 1L << k,
+                   s->faixas[k], 100.0 * s->faixas[k] / s->executadas);
+            for (int b = 0; b < barra; b++) putchar('#');
+            putchar('\n');
+        }
+    }
+}
+
+// Roda os comandos 'repeticoes' vezes sem exibir nada e relata vazão e latências
+int executarSemTela(const Comando *cmds, long n, long repeticoes, const char *origem) {
+    static EstatisticaOperacao est[NUM_OPERACOES];
+    EstadoJogo inicial, jogo;
+    Randomizador sorteioInicial;
+    TotaisSemTela tot = {0}, totCronometrado = {0};
+    long total = n * repeticoes, sobrecarga;
+    uint64_t hashVazao;
+    double ini, seg;
+
+    if (n < 1) {
+        printf("Nenhuma operação para executar.\n");
+        return 1;
+    }
+    inicializarJogo(&inicial);
+    sorteioInicial = randomizador; // as duas passagens sorteiam as mesmas peças
+
+    printf("\n=== Modo sem tela: %s, %ld operacoes (%ld x %ld) ===\n", origem, total, n, repeticoes);
+
+    // 1) vazão: sem relógio por operação
+    jogo = inicial;
+    ini = tempoMonotonico();
+    for (long r = 0; r < repeticoes; r++)
+        for (long i = 0; i < n; i++) contarResultado(&tot, &cmds[i], executarComando(&jogo, cmds[i]));
+    seg = tempoMonotonico() - ini;
+    hashVazao = hashJogo(&jogo);
+    printf("Vazao: %.3f s | %.0f operacoes/s | %.1f ns/operacao\n", seg,
+           seg > 0 ? total / seg : 0.0, seg * 1e9 / total);
+    printf("Pecas jogadas: %ld | linhas: %ld | fins de jogo: %ld | colunas invalidas: %ld\n",
+           tot.pecas, tot.linhas, tot.fimDeJogo, tot.invalidas);
+
+    // 2) latência: cada operação cronometrada
+    memset(est, 0, sizeof(est));
+    sobrecarga = sobrecargaRelogio();
+    randomizador = sorteioInicial;
+    jogo = inicial;
+    for (long r = 0; r < repeticoes; r++) {
+        for (long i = 0; i < n; i++) {
+            struct timespec a, b;
+            clock_gettime(CLOCK_MONOTONIC, &a);
+            int resultado = executarComando(&jogo, cmds[i]);
+            clock_gettime(CLOCK_MONOTONIC, &b);
+            long ns = nsDesde(&a, &b) - sobrecarga;
+            EstatisticaOperacao *s = &est[cmds[i].op];
+            if (ns < 0) ns = 0;
+            s->executadas++;
+            s->impossiveis += resultado == ACAO_IMPOSSIVEL;
+            s->faixas[faixaLog2(ns)]++;
+            s->nsTotal += ns;
+            if (ns > s->nsMax) s->nsMax = ns;
+            contarResultado(&totCronometrado, &cmds[i], resultado);
+        }
+    }
+    relatarSemTela(est, sobrecarga);
+
+    if (hashJogo(&jogo) != hashVazao || totCronometrado.linhas != tot.linhas) {
+        printf("\nERRO: as duas passagens terminaram em estados diferentes!\n");
+        return 1;
+    }
+    printf("\nEstado final identico nas duas passagens (hash %016llx)\n", (unsigned long long)hashVazao);
+    return 0;
+}
+
+// ---------------- Instantâneos e desfazer ---------------- //
+// Instantaneo: o estado inteiro do jogo (fila, pilha, tabuleiro, contadorID)
+// mais a parte variável do sorteio, sem as tabelas do randomizador. Com os
+// tamanhos padrão são ~250 bytes, copiados com uma atribuição de struct.
+//
+// Diario: cada ação registra só o que mudou - a peça retirada da fila ou da
+// pilha, quantas peças o reabastecimento incluiu (e o sorteio antes dele), a
+// posição da peça e as alturas das 4 colunas que ela tocou. Desfazer uma
+// jogada apaga os bits da peça nas 4 linhas. Só quando a jogada remove linhas
+// ou termina a partida o tabuleiro anterior é copiado, para uma área de cópias
+// que também é uma pilha (o diário é sempre desfeito do fim para o começo).
+// As trocas são a própria inversa: desfazer é trocar de novo.
+
+typedef struct {
+    EstadoJogo jogo;
+    EstadoSorteio sorteio;
+} Instantaneo;
+
+void salvarInstantaneo(const EstadoJogo *e, Instantaneo *s) {
+    s->jogo = *e;
+    randomizadorSalvar(&randomizador, &s->sorteio);
+}
+
+void restaurarInstantaneo(EstadoJogo *e, const Instantaneo *s) {
+    *e = s->jogo;
+    randomizadorRestaurar(&randomizador, &s->sorteio);
+}
+
+typedef struct {
+    EstadoSorteio sorteio;  // antes do reabastecimento (jogar/reservar)
+    Peca peca;              // retirada da fila (jogar/reservar) ou da pilha (usar)
+    uint16_t quantidade;    // k da troca em bloco
+    uint16_t reabastecidas; // peças incluídas na fila pelo reabastecimento
+    uint8_t op;
+    int8_t resultado;       // retorno da ação (ACAO_* ou linhas removidas)
+    uint8_t copiaTabuleiro; // 1: o tabuleiro anterior está na área de cópias
+    uint8_t forma;          // tipo * 4 + rotação da peça fixada
+    int8_t coluna, linha;
+    uint8_t altura;         // altura do tabuleiro antes da jogada
+    uint8_t alturas[4];     // alturaColuna das 4 colunas da peça antes da jogada
+} RegistroDesfazer;
+
+typedef struct {
+    RegistroDesfazer *registros;
+    long n, capacidade;
+    Tabuleiro *copias;
+    long nCopias, capacidadeCopias;
+} Diario;
+
+int inicializarDiario(Diario *d, long capacidade) {
+    d->n = d->nCopias = 0;
+    d->capacidade = d->capacidadeCopias = capacidade;
+    d->registros = memAlocar(&memDiario, capacidade * sizeof(RegistroDesfazer));
+    d->copias = memAlocar(&memDiario, capacidade * sizeof(Tabuleiro));
+    if (!d->registros || !d->copias) {
+        memLiberar(d->registros);
+        memLiberar(d->copias);
+        return 0;
+    }
+    return 1;
+}
+
+void liberarDiario(Diario *d) {
+    memLiberar(d->registros);
+    memLiberar(d->copias);
+    d->registros = NULL;
+    d->copias = NULL;
+}
+
+// Garante espaço para mais um registro e uma cópia de tabuleiro (dobra se preciso)
+static int reservarDiario(Diario *d) {
+    if (d->n == d->capacidade) {
+        RegistroDesfazer *maior = memRealocar(&memDiario, d->registros, 2 * d->capacidade * sizeof(RegistroDesfazer));
+        if (!maior) return 0;
+        d->registros = maior;
+        d->capacidade *= 2;
+    }
+    if (d->nCopias == d->capacidadeCopias) {
+        Tabuleiro *maior = memRealocar(&memDiario, d->copias, 2 * d->capacidadeCopias * sizeof(Tabuleiro));
+        if (!maior) return 0;
+        d->copias = maior;
+        d->capacidadeCopias *= 2;
+    }
+    return 1;
+}
+
+// aplicarJogada() anotando em r como desfazê-la
+static int aplicarJogadaRegistrando(Diario *d, RegistroDesfazer *r, Tabuleiro *t, Peca p,
+                                    int rotacao, int coluna) {
+    int tipo = indiceTipoPeca(p.tipo), cheia = 0, linha;
+    const FormaPeca *f;
+
+    r->copiaTabuleiro = 0;
+    if (tipo < 0) { // mesmo efeito de aplicarJogada() com tipo desconhecido
+        if (coluna < 0 || coluna > LARGURA_TABULEIRO) return ACAO_INVALIDA;
+        d->copias[d->nCopias++] = *t;
+        r->copiaTabuleiro = 1;
+        inicializarTabuleiro(t);
+        return ACAO_FIM_DE_JOGO;
+    }
+    f = formaPeca(tipo, rotacao);
+    if (coluna < 0 || coluna + f->largura > LARGURA_TABULEIRO) return ACAO_INVALIDA;
+    linha = quedaForma(t, f, coluna);
+    for (int i = 0; i < 4; i++)
+        cheia |= (t->linhas[linha + i] | (uint16_t)(f->linhas[i] << coluna)) == LINHA_CHEIA;
+
+    if (cheia || linha + f->altura > ALTURA_TABULEIRO) {
+        d->copias[d->nCopias++] = *t;
+        r->copiaTabuleiro = 1;
+        if (linha + f->altura > ALTURA_TABULEIRO) {
+            inicializarTabuleiro(t);
+            return ACAO_FIM_DE_JOGO;
+        }
+        return fixarForma(t, f, coluna, linha);
+    }
+    r->forma = (uint8_t)(tipo * 4 + (rotacao & 3));
+    r->coluna = (int8_t)coluna;
+    r->linha = (int8_t)linha;
+    r->altura = (uint8_t)t->altura;
+    memcpy(r->alturas, &t->alturaColuna[coluna], 4);
+    return fixarForma(t, f, coluna, linha); // nenhuma linha completa: sempre 0
+}
+
+static void desfazerJogada(Tabuleiro *t, Diario *d, const RegistroDesfazer *r) {
+    if (r->copiaTabuleiro) {
+        *t = d->copias[--d->nCopias];
+        return;
+    }
+    const FormaPeca *f = formaPeca(r->forma >> 2, r->forma & 3);
+    for (int i = 0; i < 4; i++) t->linhas[r->linha + i] &= (uint16_t)~(f->linhas[i] << r->coluna);
+    memcpy(&t->alturaColuna[r->coluna], r->alturas, 4);
+    t->altura = r->altura;
+    t->pecasColocadas--;
+}
+
+// Reabastece a fila anotando o sorteio anterior e quantas peças entraram
+static void reabastecerRegistrando(EstadoJogo *e, RegistroDesfazer *r) {
+    int antes = filaQtd(&e->fila);
+    randomizadorSalvar(&randomizador, &r->sorteio);
+    reabastecerFila(&e->fila, &e->contadorID);
+    r->reabastecidas = (uint16_t)(filaQtd(&e->fila) - antes);
+}
+
+// executarComando() registrando a ação no diário. Retorna o mesmo resultado
+// ou ACAO_SEM_MEMORIA (nada é feito) se o diário não pôde crescer.
+int aplicarRegistrando(EstadoJogo *e, Diario *d, Comando c) {
+    RegistroDesfazer *r;
+    if (!reservarDiario(d)) return ACAO_SEM_MEMORIA;
+    r = &d->registros[d->n++];
+    r->op = c.op;
+    r->quantidade = c.quantidade;
+    r->resultado = 0;
+
+    switch (c.op) {
+        case OP_JOGAR:
+            if (filaVazia(&e->fila)) { r->resultado = ACAO_IMPOSSIVEL; break; }
+            r->peca = desenfileirar(&e->fila);
+            r->resultado = (int8_t)aplicarJogadaRegistrando(d, r, &e->tabuleiro, r->peca, c.rotacao,
+                                                            colunaComando(c, r->peca.tipo));
+            reabastecerRegistrando(e, r);
+            break;
+        case OP_RESERVAR:
+            if (filaVazia(&e->fila) || pilhaCheia(&e->pilha)) { r->resultado = ACAO_IMPOSSIVEL; break; }
+            r->peca = desenfileirar(&e->fila);
+            empilhar(&e->pilha, r->peca);
+            reabastecerRegistrando(e, r);
+            break;
+        case OP_USAR:
+            if (pilhaVazia(&e->pilha)) { r->resultado = ACAO_IMPOSSIVEL; break; }
+            r->peca = desempilhar(&e->pilha);
+            r->resultado = (int8_t)aplicarJogadaRegistrando(d, r, &e->tabuleiro, r->peca, c.rotacao,
+                                                            colunaComando(c, r->peca.tipo));
+            break;
+        case OP_TROCAR:
+            if (!trocarFrentePilha(&e->fila, &e->pilha)) r->resultado = ACAO_IMPOSSIVEL;
+            break;
+        case OP_TROCAR_TRES:
+            if (!trocarTres(&e->fila, &e->pilha)) r->resultado = ACAO_IMPOSSIVEL;
+            break;
+        case OP_TROCAR_BLOCO:
+            if (!trocarBloco(&e->fila, &e->pilha, c.quantidade)) r->resultado = ACAO_IMPOSSIVEL;
+            break;
+    }
+    return r->resultado;
+}
+
+// Comando com os valores digitados no menu (coluna fora do tabuleiro continua inválida)
+Comando comandoManual(int op, int rotacao, int coluna, int quantidade) {
+    Comando c;
+    c.op = (uint8_t)op;
+    c.rotacao = (uint8_t)(rotacao & 3);
+    c.sorteio = 0;
+    c.coluna = (int8_t)(coluna < 0 || coluna > LARGURA_TABULEIRO ? LARGURA_TABULEIRO : coluna);
+    c.quantidade = (uint16_t)(quantidade < 0 ? 0 : quantidade > 65535 ? 65535 : quantidade);
+    return c;
+}
+
+// Desfaz a última ação do diário; retorna 0 se não há o que desfazer
+int desfazerUltima(EstadoJogo *e, Diario *d) {
+    INSTR_CRONOMETRAR("desfazerUltima");
+    if (d->n == 0) return 0;
+    const RegistroDesfazer *r = &d->registros[--d->n];
+    if (r->resultado == ACAO_IMPOSSIVEL) return 1; // a ação não mudou nada
+
+    switch (r->op) {
+        case OP_JOGAR:
+            anelDescartarFim(&e->fila, r->reabastecidas);
+            e->contadorID -= r->reabastecidas;
+            randomizadorRestaurar(&randomizador, &r->sorteio);
+            if (r->resultado != ACAO_INVALIDA) desfazerJogada(&e->tabuleiro, d, r);
+            anelDevolverFrente(&e->fila, &r->peca);
+            break;
+        case OP_RESERVAR:
+            anelDescartarFim(&e->fila, r->reabastecidas);
+            e->contadorID -= r->reabastecidas;
+            randomizadorRestaurar(&randomizador, &r->sorteio);
+            desempilhar(&e->pilha);
+            anelDevolverFrente(&e->fila, &r->peca);
+            break;
+        case OP_USAR:
+            if (r->resultado != ACAO_INVALIDA) desfazerJogada(&e->tabuleiro, d, r);
+            empilhar(&e->pilha, r->peca);
+            break;
+        case OP_TROCAR:
+            trocarFrentePilha(&e->fila, &e->pilha);
+            break;
+        case OP_TROCAR_TRES:
+            trocarTres(&e->fila, &e->pilha);
+            break;
+        case OP_TROCAR_BLOCO:
+            trocarBloco(&e->fila, &e->pilha, r->quantidade);
+            break;
+    }
+    return 1;
+}
+
+// Compara só a parte viva dos estados (fora dela as estruturas guardam lixo antigo)
+static int jogosIguais(const EstadoJogo *a, const EstadoJogo *b) {
+    const Tabuleiro *ta = &a->tabuleiro, *tb = &b->tabuleiro;
+    uint32_t n = a->fila.cauda - a->fila.cabeca;
+    if (n != b->fila.cauda - b->fila.cabeca || a->pilha.topo != b->pilha.topo ||
+        a->contadorID != b->contadorID)
+        return 0;
+    for (uint32_t i = 0; i < n; i++) {
+        const Peca *x = &a->fila.itens[(a->fila.cabeca + i) & anelMascara];
+        const Peca *y = &b->fila.itens[(b->fila.cabeca + i) & anelMascara];
+        if (x->tipo != y->tipo || x->id != y->id) return 0;
+    }
+    for (int i = a->pilha.topo; i < TAMANHO_PILHA; i++)
+        if (a->pilha.itens[i].tipo != b->pilha.itens[i].tipo || a->pilha.itens[i].id != b->pilha.itens[i].id)
+            return 0;
+    return memcmp(ta->linhas, tb->linhas, sizeof(ta->linhas)) == 0 &&
+           memcmp(ta->alturaColuna, tb->alturaColuna, sizeof(ta->alturaColuna)) == 0 &&
+           ta->altura == tb->altura && ta->linhasRemovidas == tb->linhasRemovidas &&
+           ta->pecasColocadas == tb->pecasColocadas;
+}
+
+static int sorteiosIguais(const EstadoSorteio *a, const EstadoSorteio *b) {
+    return memcmp(a->s, b->s, sizeof(a->s)) == 0 && a->historico == b->historico &&
+           a->restantesSacola == b->restantesSacola &&
+           memcmp(a->sacola, b->sacola, sizeof(a->sacola)) == 0;
+}
+
+// ---------------- Benchmark de desfazer ---------------- //
+// Padrão de uma busca com antecipação: a partir de uma raiz, aplica
+// PROFUNDIDADE_RAMO ações e volta à raiz; a raiz avança uma ação a cada ramo.
+// Três formas de voltar: diário (desfaz as ações), instantâneo (restaura a
+// cópia compacta) e cópia completa (EstadoJogo + Randomizador inteiro).
+#define PROFUNDIDADE_RAMO 4
+
+// Antes de medir: caminhada aleatória conferindo cada desfazer contra instantâneos
+static long conferirDiario(const Comando *cmds, long n) {
+    static Instantaneo pilhaInst[64];
+    EstadoJogo jogo, atual;
+    EstadoSorteio agora;
+    Diario d;
+    long erros = 0, profundidade = 0;
+
+    if (!inicializarDiario(&d, 64)) return -1;
+    inicializarJogo(&jogo);
+    for (long i = 0; i < n; i++) {
+        if (profundidade < 64 && (profundidade == 0 || cmds[i].sorteio % 3 != 0)) {
+            salvarInstantaneo(&jogo, &pilhaInst[profundidade++]);
+            aplicarRegistrando(&jogo, &d, cmds[i]);
+        } else {
+            desfazerUltima(&jogo, &d);
+            profundidade--;
+            randomizadorSalvar(&randomizador, &agora);
+            atual = pilhaInst[profundidade].jogo;
+            if (!jogosIguais(&jogo, &atual) || !sorteiosIguais(&agora, &pilhaInst[profundidade].sorteio))
+                erros++;
+        }
+    }
+    liberarDiario(&d);
+    return erros;
+}
+
+int benchmarkDesfazer(long n) {
+    EstadoJogo raiz, jogo, conferencia;
+    Instantaneo inst;
+    static Randomizador copiaSorteio;
+    Diario d;
+    Comando *cmds;
+    long ramos = n / PROFUNDIDADE_RAMO, erros, divergencias = 0;
+    double ini, seg[3];
+    const char *nomes[3] = {"diario (desfaz o delta)", "instantaneo compacto", "copia completa"};
+
+    if (ramos < 1) ramos = 1;
+    cmds = gerarMistura(ramos + PROFUNDIDADE_RAMO, (const double[NUM_OPERACOES]){4, 2, 2, 1, 1, 1});
+    if (!cmds || !inicializarDiario(&d, PROFUNDIDADE_RAMO)) {
+        printf("Erro: memória insuficiente.\n");
+        memLiberar(cmds);
+        return 1;
+    }
+
+    printf("\n=== Desfazer: %ld ramos de %d acoes (instantaneo %zu bytes, registro %zu bytes, "
+           "randomizador %zu bytes) ===\n", ramos, PROFUNDIDADE_RAMO, sizeof(Instantaneo),
+           sizeof(RegistroDesfazer), sizeof(Randomizador));
+    erros = conferirDiario(cmds, ramos < 2000000 ? ramos : 2000000);
+    printf("Conferencia (caminhada aleatoria, desfazer x instantaneo): %ld erro(s)\n", erros);
+
+    // 1) diário
+    inicializarJogo(&raiz);
+    salvarInstantaneo(&raiz, &inst);
+    jogo = raiz;
+    ini = tempoMonotonico();
+    for (long r = 0; r < ramos; r++) {
+        for (int k = 0; k < PROFUNDIDADE_RAMO; k++) aplicarRegistrando(&jogo, &d, cmds[r + k]);
+        while (desfazerUltima(&jogo, &d)) {}
+        aplicarRegistrando(&jogo, &d, cmds[r]); // avança a raiz (sem desfazer depois)
+        d.n = d.nCopias = 0;
+    }
+    seg[0] = tempoMonotonico() - ini;
+    conferencia = jogo;
+
+    // 2) instantâneo compacto
+    restaurarInstantaneo(&jogo, &inst);
+    ini = tempoMonotonico();
+    for (long r = 0; r < ramos; r++) {
+        Instantaneo ramo;
+        salvarInstantaneo(&jogo, &ramo);
+        for (int k = 0; k < PROFUNDIDADE_RAMO; k++) executarComando(&jogo, cmds[r + k]);
+        restaurarInstantaneo(&jogo, &ramo);
+        executarComando(&jogo, cmds[r]);
+    }
+    seg[1] = tempoMonotonico() - ini;
+    divergencias += !jogosIguais(&jogo, &conferencia);
+
+    // 3) cópia completa do estado, tabelas do randomizador incluídas
+    restaurarInstantaneo(&jogo, &inst);
+    ini = tempoMonotonico();
+    for (long r = 0; r < ramos; r++) {
+        EstadoJogo ramo = jogo;
+        copiaSorteio = randomizador;
+        for (int k = 0; k < PROFUNDIDADE_RAMO; k++) executarComando(&jogo, cmds[r + k]);
+        jogo = ramo;
+        randomizador = copiaSorteio;
+        executarComando(&jogo, cmds[r]);
+    }
+    seg[2] = tempoMonotonico() - ini;
+    divergencias += !jogosIguais(&jogo, &conferencia);
+
+    printf("%-26s %10s %16s %12s\n", "modo", "tempo(s)", "acoes+volta/s", "ns/acao");
+    for (int m = 0; m < 3; m++) {
+        double acoes = (double)ramos * PROFUNDIDADE_RAMO;
+        printf("%-26s %10.3f %16.0f %12.1f\n", nomes[m], seg[m], seg[m] > 0 ? acoes / seg[m] : 0.0,
+               seg[m] * 1e9 / acoes);
+    }
+    printf("Estado final igual nos tres modos: %s\n", divergencias ? "NAO" : "sim");
+
+    liberarDiario(&d);
+    memLiberar(cmds);
+    return erros || divergencias;
+}
+
+// ---------------- Benchmark da tela ---------------- //
+// Joga n ações da mistura padrão e desenha um quadro depois de cada uma, de três
+// jeitos: a saída clássica (printf linha a linha, redirecionada para um arquivo
+// temporário para contar os bytes), o quadro completo do renderizador (sem
+// diferença) e o renderizador diferencial. Os dois últimos escrevem em /dev/null.
+int benchmarkTela(long n) {
+    static const double proporcao[NUM_OPERACOES] = {4, 2, 2, 1, 1, 1};
+    const char *nomes[3] = {"classica (printf)", "quadro completo", "diferencial"};
+    long bytes[3] = {0}, maximo[3] = {0}, escritas[3] = {0};
+    double seg[3];
+    Instantaneo inicio;
+    EstadoJogo jogo;
+    Comando *cmds = gerarMistura(n, proporcao);
+    FILE *temp = tmpfile();
+    int nulo = open("/dev/null", O_WRONLY);
+    int saidaOriginal = dup(STDOUT_FILENO);
+
+    if (!cmds || !temp || nulo < 0 || saidaOriginal < 0) {
+        printf("Erro: não foi possível preparar o benchmark da tela.\n");
+        memLiberar(cmds);
+        return 1;
+    }
+    inicializarJogo(&jogo);
+    salvarInstantaneo(&jogo, &inicio);
+
+    // 1) clássica: stdout vai para o arquivo temporário durante a medição
+    fflush(stdout);
+    dup2(fileno(temp), STDOUT_FILENO);
+    long antes = 0;
+    double ini = tempoMonotonico();
+    for (long i = 0; i < n; i++) {
+        executarComando(&jogo, cmds[i]);
+        exibirEstadoClassico(&jogo);
+        printf("Escolha: ");
+        fflush(stdout);
+        long agora = (long)lseek(STDOUT_FILENO, 0, SEEK_CUR);
+        if (agora - antes > maximo[0]) maximo[0] = agora - antes;
+        antes = agora;
+    }
+    seg[0] = tempoMonotonico() - ini;
+    bytes[0] = antes;
+    fflush(stdout);
+    dup2(saidaOriginal, STDOUT_FILENO);
+    {   // num terminal o stdout é bufferizado por linha: um write() por linha impressa
+        char bloco[4096];
+        size_t k;
+        rewind(temp);
+        while ((k = fread(bloco, 1, sizeof(bloco), temp)) > 0)
+            for (size_t j = 0; j < k; j++) escritas[0] += bloco[j] == '\n';
+    }
+
+    // 2) e 3) renderizador: quadro completo e diferencial
+    for (int m = 1; m <= 2; m++) {
+        Renderizador *r = criarRenderizador(nulo, LARGURA_TELA, ALTURA_TELA);
+        if (!r) break;
+        restaurarInstantaneo(&jogo, &inicio);
+        ini = tempoMonotonico();
+        for (long i = 0; i < n; i++) {
+            executarComando(&jogo, cmds[i]);
+            desenharQuadro(r, &jogo);
+            renderizadorEntrada(r, "Escolha: ");
+            if (m == 1) renderizadorInvalidar(r);
+            renderizadorApresentar(r);
+            if (r->bytesUltimo > maximo[m]) maximo[m] = r->bytesUltimo;
+        }
+        seg[m] = tempoMonotonico() - ini;
+        bytes[m] = r->bytesTotal;
+        escritas[m] = r->quadros;
+        liberarRenderizador(r);
+    }
+
+    printf("\n=== Tela: %ld quadros (uma acao da mistura padrao por quadro) ===\n", n);
+    printf("%-20s %12s %10s %12s %14s %10s\n", "saida", "bytes/quadro", "maximo", "us/quadro",
+           "KB/s a 60 fps", "write/quadro");
+    for (int m = 0; m < 3; m++) {
+        double media = (double)bytes[m] / n;
+        printf("%-20s %12.1f %10ld %12.2f %14.1f %10.1f\n", nomes[m], media, maximo[m],
+               seg[m] * 1e6 / n, media * 60 / 1024, (double)escritas[m] / n);
+    }
+    printf("(write/quadro da classica: linhas impressas, pois num terminal o stdout é bufferizado por linha)\n");
+
+    fclose(temp);
+    close(nulo);
+    close(saidaOriginal);
+    memLiberar(cmds);
+    return 0;
+}
+
+// ---------------- Modo lote: comandos de um arquivo ---------------- //
+// --lote arquivo (ou - para a entrada padrão) executa as opções do menu sem
+// perguntas, pelas mesmas funções do menu (aplicarRegistrando, desfazerUltima
+// e o bot), e escreve um resultado por comando no formato de lote.h. Os nomes
+// são os do script do modo sem tela; sem coluna, a jogada usa uma coluna
+// válida sorteada (de um gerador separado, para não mudar as peças).
+//     jogar|usar [rotacao [coluna]] -> ok jogar <peça> <rotação> <coluna> <linhas|invalida|fim-de-jogo>
+//     reservar                      -> ok reservar <peça>
+//     trocar | trocar3 | trocark k  -> ok trocar...
+//     desfazer                      -> ok desfazer
+//     bot                           -> ok bot <peça> <rotação> <coluna> <linhas|fim-de-jogo>
+//     estado                        -> ok estado <hash> <fila> <pilha do topo para baixo>
+// Ação sem peças suficientes (ou nada a desfazer): "nao <comando>".
+
+static void relatarJogadaLote(const char *nome, char tipo, int rotacao, int coluna, int resultado) {
+    printf("ok\t%s\t%c\t%d\t%d\t", nome, tipo, rotacao, coluna);
+    if (resultado == ACAO_INVALIDA) printf("invalida\n");
+    else if (resultado == ACAO_FIM_DE_JOGO) printf("fim-de-jogo\n");
+    else printf("%d\n", resultado);
+}
+
+int executarLote(const char *caminho, int feixe, int profundidade) {
+    EstadoJogo jogo;
+    Diario diario;
+    Bot bot;
+    Randomizador colunas = randomizador;
+    Lote lote;
+
+    if (!loteAbrir(&lote, caminho)) return 1;
+    if (!inicializarBot(&bot, feixe, profundidade) || !inicializarDiario(&diario, 256)) {
+        loteErro(&lote, "memoria insuficiente para o bot");
+        return loteFechar(&lote);
+    }
+    inicializarJogo(&jogo);
+
+    while (loteProximo(&lote)) {
+        const char *nome = loteCampo(&lote, 0);
+        int op = lerOperacao(nome);
+        long rotacao = 0, coluna = -1;
+
+        if (op >= 0) {
+            const Peca *alvo = op == OP_JOGAR ? anelEspiar(&jogo.fila, 0)
+                             : op == OP_USAR && !pilhaVazia(&jogo.pilha) ? &jogo.pilha.itens[jogo.pilha.topo]
+                             : op == OP_RESERVAR ? anelEspiar(&jogo.fila, 0) : NULL;
+            char tipo = alvo ? alvo->tipo : ' ';
+            Comando c;
+            int resultado;
+            if ((lote.nCampos > 1 && !loteInteiro(&lote, 1, &rotacao)) ||
+                (lote.nCampos > 2 && !loteInteiro(&lote, 2, &coluna)) ||
+                (op == OP_TROCAR_BLOCO && (rotacao < 1 || rotacao > 65535))) {
+                loteErro(&lote, "argumentos invalidos para %s", nome);
+                continue;
+            }
+            c.op = (uint8_t)op;
+            c.rotacao = (uint8_t)(rotacao & 3);
+            c.sorteio = (uint8_t)rndLimitado(&colunas, 256);
+            c.coluna = (int8_t)(coluna < 0 ? -1 : coluna > LARGURA_TABULEIRO ? LARGURA_TABULEIRO : coluna);
+            c.quantidade = (uint16_t)(op == OP_TROCAR_BLOCO ? rotacao : 0);
+            resultado = aplicarRegistrando(&jogo, &diario, c);
+            if (resultado == ACAO_SEM_MEMORIA) {
+                loteErro(&lote, "memoria insuficiente para o diario");
+                break;
+            }
+            if (resultado == ACAO_IMPOSSIVEL) {
+                printf("nao\t%s\n", NOMES_OPERACAO[op]);
+            } else if (op == OP_JOGAR || op == OP_USAR) {
+                relatarJogadaLote(NOMES_OPERACAO[op], tipo, c.rotacao,
+                                  c.coluna >= 0 ? c.coluna : colunaComando(c, tipo), resultado);
+            } else if (op == OP_RESERVAR) {
+                printf("ok\treservar\t%c\n", tipo);
+            } else {
+                printf("ok\t%s\n", NOMES_OPERACAO[op]);
+            }
+        } else if (loteComando(&lote, "desfazer", 0)) {
+            printf("%s\tdesfazer\n", desfazerUltima(&jogo, &diario) ? "ok" : "nao");
+        } else if (loteComando(&lote, "bot", 0)) {
+            JogadaBot j;
+            Peca jogada;
+            int linhas;
+            if (filaVazia(&jogo.fila)) {
+                printf("nao\tbot\n");
+                continue;
+            }
+            j = escolherJogadaBot(&bot, &jogo.fila, &jogo.pilha, &jogo.tabuleiro);
+            diario.n = diario.nCopias = 0; // como no menu: jogadas do bot não entram no diário
+            if (j.coluna < 0) {
+                // nenhuma posição cabe: o relatório mostra a peça da frente
+                jogada = *anelEspiar(&jogo.fila, 0);
+                linhas = -1;
+            } else {
+                linhas = executarJogadaBot(&jogo.fila, &jogo.pilha, &jogo.tabuleiro, &jogo.contadorID, j, &jogada);
+            }
+            if (linhas < 0) inicializarTabuleiro(&jogo.tabuleiro);
+            relatarJogadaLote("bot", jogada.tipo, j.rotacao, j.coluna, linhas < 0 ? ACAO_FIM_DE_JOGO : linhas);
+        } else if (loteComando(&lote, "estado", 0)) {
+            printf("ok\testado\t%016llx\t", (unsigned long long)hashJogo(&jogo));
+            for (int i = 0; i < filaQtd(&jogo.fila); i++) putchar(anelEspiar(&jogo.fila, i)->tipo);
+            putchar('\t');
+            for (int i = jogo.pilha.topo; i < TAMANHO_PILHA; i++) putchar(jogo.pilha.itens[i].tipo);
+            putchar('\n');
+        } else {
+            loteErro(&lote, "comando desconhecido: %s", nome);
+        }
+    }
+
+    liberarBot(&bot);
+    liberarDiario(&diario);
+    return loteFechar(&lote);
+}
+
+// ---------------- Tempo real: passo fixo e teclado sem bloqueio ---------------- //
+// Com --tempo-real a peça da frente da fila cai sozinha. A lógica avança em
+// passos fixos de 1/60 s (a gravidade desce a peça a cada intervaloQueda()
+// passos) e, entre um passo e outro, o laço espera o teclado com poll() até o
+// prazo do próximo passo. Teclas são aplicadas assim que chegam e o quadro é
+// redesenhado em seguida, pelo renderizador diferencial, sem linha de entrada.
+//
+// Monitor do orçamento de cada quadro (1/60 s):
+//   - atraso: quanto o laço acordou depois do prazo do passo;
+//   - quadros perdidos: passos vencidos que não chegaram a ser desenhados (os
+//     passos atrasados rodam em sequência, até PASSOS_ATRASO_MAXIMO; o resto
+//     é descartado, sem tentar recuperar o tempo);
+//   - trabalho: teclas + passos + desenho + write() de um quadro;
+//   - tecla -> tela: da chegada da tecla ao fim do write() do quadro que a
+//     mostra. Uma tecla que chegou enquanto o laço trabalhava conta desde a
+//     última vez que a entrada estava vazia (pior caso).
+// --carga us acrescenta trabalho artificial a cada passo, para ver o monitor sob
+// carga; --duracao s encerra sozinho (útil com a entrada vinda de um arquivo).
+
+#define PASSOS_POR_SEGUNDO 60
+#define NS_PASSO (1000000000L / PASSOS_POR_SEGUNDO)
+#define PASSOS_ATRASO_MAXIMO 5  // passos atrasados executados de uma vez
+#define QUEDA_INICIAL 48        // passos por linha de queda no nível 0 (0,8 s)
+#define QUEDA_MINIMA 3
+#define LINHAS_POR_NIVEL 10
+#define PASSOS_MENSAGEM (2 * PASSOS_POR_SEGUNDO) // tempo de uma mensagem na tela
+
+typedef struct {
+    int tipo; // índice em TIPOS_PECA
+    int rotacao, coluna, linha;
+} PecaCaindo;
+
+typedef struct {
+    EstadoJogo jogo;
+    PecaCaindo peca;   // sempre a peça da frente da fila
+    int contadorQueda; // passos desde a última descida
+    int pausado;
+    long passoMensagem;
+} PartidaTempoReal;
+
+typedef struct {
+    long passos, quadros, perdidos, descartados, teclas;
+    long ultimoTrabalho, ultimaLatencia;
+    EstatisticaOperacao trabalho, atraso, latencia;
+} MonitorQuadros;
+
+static volatile sig_atomic_t interrompido = 0;
+
+static void tratarInterrupcao(int sinal) {
+    (void)sinal;
+    interrompido = 1;
+}
+
+static long relogioNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+// Dorme até o instante 'ns' do relógio monotônico (resolução melhor que a do poll())
+static void dormirAte(long ns) {
+    struct timespec ts;
+    ts.tv_sec = ns / 1000000000L;
+    ts.tv_nsec = ns % 1000000000L;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+static void registrarTempo(EstatisticaOperacao *s, long ns) {
+    if (ns < 0) ns = 0;
+    s->executadas++;
+    s->faixas[faixaLog2(ns)]++;
+    s->nsTotal += ns;
+    if (ns > s->nsMax) s->nsMax = ns;
+}
+
+static int intervaloQueda(const Tabuleiro *t) {
+    int passos = QUEDA_INICIAL - 5 * (int)(t->linhasRemovidas / LINHAS_POR_NIVEL);
+    return passos > QUEDA_MINIMA ? passos : QUEDA_MINIMA;
+}
+
+// Mensagem na linha do quadro (substitui a anterior)
+static void avisarTempoReal(PartidaTempoReal *pt, long passo, int resultado) {
+    mensagemTela[0] = '\0';
+    relatarJogada(resultado);
+    pt->passoMensagem = passo;
+}
+
+// Põe a peça da frente da fila no topo do tabuleiro. Se ela já nasce encostada
+// nos blocos é fim de jogo: o tabuleiro é reiniciado, como em aplicarJogada().
+static void surgirPeca(PartidaTempoReal *pt, long passo) {
+    PecaCaindo *p = &pt->peca;
+    const FormaPeca *f;
+    p->tipo = indiceTipoPeca(anelEspiar(&pt->jogo.fila, 0)->tipo);
+    p->rotacao = 0;
+    f = formaPeca(p->tipo, 0);
+    p->coluna = (LARGURA_TABULEIRO - f->largura) / 2;
+    p->linha = ALTURA_TABULEIRO - f->altura;
+    pt->contadorQueda = 0;
+    if (colidePeca(&pt->jogo.tabuleiro, p->tipo, 0, p->coluna, p->linha)) {
+        inicializarTabuleiro(&pt->jogo.tabuleiro);
+        avisarTempoReal(pt, passo, ACAO_FIM_DE_JOGO);
+    }
+}
+
+// Desloca e/ou gira a peça; retorna 0 se a nova posição está ocupada. Ao girar,
+// tenta também uma ou duas colunas para o lado (peça encostada na parede).
+static int moverPeca(const Tabuleiro *t, PecaCaindo *p, int dColuna, int dLinha, int dRotacao) {
+    static const int deslocamentos[] = {0, -1, 1, -2, 2};
+    int rotacao = (p->rotacao + dRotacao) & 3;
+    int tentativas = dRotacao ? 5 : 1;
+    for (int i = 0; i < tentativas; i++) {
+        int coluna = p->coluna + dColuna + deslocamentos[i];
+        if (!colidePeca(t, p->tipo, rotacao, coluna, p->linha + dLinha)) {
+            p->coluna = coluna;
+            p->linha += dLinha;
+            p->rotacao = rotacao;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Fixa a peça onde está, tira-a da fila, completa a fila e faz surgir a próxima
+static void encerrarPeca(PartidaTempoReal *pt, long passo) {
+    Tabuleiro *t = &pt->jogo.tabuleiro;
+    int linhas;
+    desenfileirar(&pt->jogo.fila);
+    linhas = fixarPeca(t, pt->peca.tipo, pt->peca.rotacao, pt->peca.coluna, pt->peca.linha);
+    reabastecerFila(&pt->jogo.fila, &pt->jogo.contadorID);
+    if (t->altura > ALTURA_TABULEIRO) { // ficou acima do topo
+        inicializarTabuleiro(t);
+        linhas = ACAO_FIM_DE_JOGO;
+    }
+    if (linhas != 0) avisarTempoReal(pt, passo, linhas);
+    surgirPeca(pt, passo);
+}
+
+// Um passo da lógica: gravidade e validade da mensagem
+static void passoTempoReal(PartidaTempoReal *pt, long passo) {
+    if (mensagemTela[0] && passo - pt->passoMensagem > PASSOS_MENSAGEM) mensagemTela[0] = '\0';
+    if (pt->pausado || ++pt->contadorQueda < intervaloQueda(&pt->jogo.tabuleiro)) return;
+    pt->contadorQueda = 0;
+    if (!moverPeca(&pt->jogo.tabuleiro, &pt->peca, 0, -1, 0)) encerrarPeca(pt, passo);
+}
+
+// Aplica uma tecla; retorna 0 se é para sair
+static int tratarTecla(PartidaTempoReal *pt, int tecla, long passo) {
+    Tabuleiro *t = &pt->jogo.tabuleiro;
+    Peca reservada;
+    if (tecla == 'q' || tecla == 'Q') return 0;
+    if (tecla == 'p' || tecla == 'P') {
+        pt->pausado = !pt->pausado;
+        return 1;
+    }
+    if (pt->pausado) return 1;
+    switch (tecla) {
+        case 'a': case 'A': case TECLA_ESQUERDA:
+            moverPeca(t, &pt->peca, -1, 0, 0);
+            break;
+        case 'd': case 'D': case TECLA_DIREITA:
+            moverPeca(t, &pt->peca, 1, 0, 0);
+            break;
+        case 'w': case 'W': case TECLA_CIMA:
+            moverPeca(t, &pt->peca, 0, 0, 1);
+            break;
+        case 's': case 'S': case TECLA_BAIXO:
+            if (moverPeca(t, &pt->peca, 0, -1, 0)) pt->contadorQueda = 0;
+            else encerrarPeca(pt, passo);
+            break;
+        case ' ':
+            while (moverPeca(t, &pt->peca, 0, -1, 0)) {}
+            encerrarPeca(pt, passo);
+            break;
+        case 'c': case 'C':
+            if (acaoReservar(&pt->jogo, &reservada) == 0) {
+                surgirPeca(pt, passo);
+            } else {
+                mensagemTela[0] = '\0';
+                avisar("⚠️  Pilha de reserva cheia.");
+                pt->passoMensagem = passo;
+            }
+            break;
+        case 'x': case 'X':
+            if (trocarFrentePilha(&pt->jogo.fila, &pt->jogo.pilha)) {
+                surgirPeca(pt, passo);
+            } else {
+                mensagemTela[0] = '\0';
+                avisar("⚠️  Pilha de reserva vazia.");
+                pt->passoMensagem = passo;
+            }
+            break;
+    }
+    return 1;
+}
+
+static const char *TECLAS_TEMPO_REAL[] = {
+    "Setas ou a/d - mover     w - girar",
+    "s - descer     espaço - derrubar",
+    "c - reservar a peça     x - trocar com a pilha",
+    "p - pausar     q - sair",
+};
+
+static void desenharPecaCaindo(Renderizador *r, const PecaCaindo *p) {
+    const FormaPeca *f = formaPeca(p->tipo, p->rotacao);
+    int cor = corPeca(TIPOS_PECA[p->tipo]) | COR_BRILHANTE;
+    for (int i = 0; i < f->altura; i++) {
+        int y = ALTURA_TABULEIRO - (p->linha + i);
+        if (y < 1) continue; // acima do topo visível
+        for (int c = 0; c < f->largura; c++) {
+            if (!((f->linhas[i] >> c) & 1)) continue;
+            renderizadorCelula(r, y, 1 + 2 * (p->coluna + c), '[', cor);
+            renderizadorCelula(r, y, 2 + 2 * (p->coluna + c), ']', cor);
+        }
+    }
+}
+
+static void desenharQuadroTempoReal(Renderizador *r, PartidaTempoReal *pt, const MonitorQuadros *m) {
+    int x = COLUNA_PAINEL;
+    desenharJogo(r, &pt->jogo);
+    desenharPecaCaindo(r, &pt->peca);
+    renderizadorTexto(r, 9, x, COR_PADRAO, "Nível: %d   Queda: %d passos/linha",
+                      (int)(pt->jogo.tabuleiro.linhasRemovidas / LINHAS_POR_NIVEL),
+                      intervaloQueda(&pt->jogo.tabuleiro));
+    for (int i = 0; i < (int)(sizeof(TECLAS_TEMPO_REAL) / sizeof(TECLAS_TEMPO_REAL[0])); i++)
+        renderizadorTexto(r, 11 + i, x, COR_PADRAO, "%s", TECLAS_TEMPO_REAL[i]);
+    renderizadorTexto(r, 16, x, COR_PADRAO, "Quadro: %6.3f ms (máx %.3f) de %.2f ms",
+                      m->ultimoTrabalho / 1e6, m->trabalho.nsMax / 1e6, NS_PASSO / 1e6);
+    renderizadorTexto(r, 17, x, m->perdidos ? COR_VERMELHO | COR_BRILHANTE : COR_PADRAO,
+                      "Quadros perdidos: %ld de %ld", m->perdidos, m->passos);
+    renderizadorTexto(r, 18, x, COR_PADRAO, "Tecla -> tela: %6.3f ms (máx %.3f)",
+                      m->ultimaLatencia / 1e6, m->latencia.nsMax / 1e6);
+    if (pt->pausado) renderizadorTexto(r, 19, x, COR_AMARELO | COR_BRILHANTE, "PAUSA");
+    renderizadorTexto(r, ALTURA_TABULEIRO, x, COR_AMARELO | COR_BRILHANTE, "%s", mensagemTela);
+}
+
+static void relatarTempoReal(const MonitorQuadros *m, double seg, long cargaUs) {
+    const char *nomes[3] = {"trabalho do quadro", "atraso do despertar", "tecla -> tela"};
+    const EstatisticaOperacao *est[3] = {&m->trabalho, &m->atraso, &m->latencia};
+
+    printf("\n=== Tempo real: %ld passos em %.2f s (%.1f passos/s), %ld quadros desenhados ===\n",
+           m->passos, seg, seg > 0 ? m->passos / seg : 0.0, m->quadros);
+    printf("Orcamento por quadro: %.2f ms | quadros perdidos: %ld (%.2f%%) | passos descartados: %ld\n",
+           NS_PASSO / 1e6, m->perdidos, m->passos ? 100.0 * m->perdidos / m->passos : 0.0,
+           m->descartados);
+    printf("Teclas: %ld | carga artificial: %ld us por passo\n", m->teclas, cargaUs);
+    printf("\n%-20s %10s %10s %10s %10s %10s\n", "medida (us)", "amostras", "media", "p50", "p99", "max");
+    for (int i = 0; i < 3; i++) {
+        const EstatisticaOperacao *s = est[i];
+        if (s->executadas == 0) continue;
+        long p50 = percentilLog2(s, 0.50), p99 = percentilLog2(s, 0.99);
+        printf("%-20s %10ld %10.1f %10.1f %10.1f %10.1f\n", nomes[i], s->executadas,
+               (double)s->nsTotal / s->executadas / 1e3, (p50 < s->nsMax ? p50 : s->nsMax) / 1e3,
+               (p99 < s->nsMax ? p99 : s->nsMax) / 1e3, s->nsMax / 1e3);
+    }
+    printf("(percentis: limite superior da faixa log2, limitado ao máximo)\n");
+}
+
+int jogarTempoReal(double duracao, long cargaUs) {
+    static PartidaTempoReal pt;
+    static MonitorQuadros m;
+    struct sigaction acao, anteriorInt, anteriorTerm;
+    long inicio, agendados = 0, chegadaTecla = -1, entradaVazia;
+    int rodando = 1;
+
+    memset(&pt, 0, sizeof(pt));
+    memset(&m, 0, sizeof(m));
+    inicializarJogo(&pt.jogo);
+    tela = criarRenderizador(STDOUT_FILENO, LARGURA_TELA, ALTURA_TELA);
+    if (!tela) {
+        printf("Erro: memória insuficiente para a tela.\n");
+        return 1;
+    }
+    if (!tecladoAtivar()) {
+        liberarRenderizador(tela);
+        tela = NULL;
+        printf("Erro: não foi possível configurar o terminal.\n");
+        return 1;
+    }
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = tratarInterrupcao; // sem SA_RESTART: o poll() volta com EINTR
+    sigemptyset(&acao.sa_mask);
+    sigaction(SIGINT, &acao, &anteriorInt);
+    sigaction(SIGTERM, &acao, &anteriorTerm);
+    if (write(STDOUT_FILENO, "\x1b[?25l", 6) < 0) { /* sem terminal: segue sem esconder o cursor */ }
+
+    surgirPeca(&pt, 0);
+    inicio = entradaVazia = relogioNs();
+    while (rodando && !interrompido) {
+        long prazo = inicio + agendados * NS_PASSO, agora = relogioNs(), acordou, vencidos;
+        int tecla, desenhar = 0;
+
+        // 1) espera uma tecla ou o prazo do próximo passo: poll() nos milissegundos
+        //    inteiros e clock_nanosleep() no resto (a tecla que chegar nele espera < 1 ms)
+        if (tecladoAguardar(0) > 0) {
+            if (chegadaTecla < 0) chegadaTecla = entradaVazia; // chegou durante o trabalho
+        } else if (prazo > agora) {
+            int ms = (int)((prazo - agora) / 1000000);
+            if (ms > 0 && tecladoAguardar(ms) > 0) {
+                if (chegadaTecla < 0) chegadaTecla = relogioNs();
+            } else {
+                dormirAte(prazo);
+            }
+        }
+        acordou = relogioNs();
+        if (duracao > 0 && acordou - inicio >= (long)(duracao * 1e9)) break;
+
+        // 2) teclas: aplicadas na hora
+        while ((tecla = tecladoLer()) != TECLA_NENHUMA) {
+            if (tecla == TECLA_FIM) {
+                if (duracao <= 0) rodando = 0; // sem --duracao, o fim da entrada encerra
+                break;
+            }
+            m.teclas++;
+            desenhar = 1;
+            if (!tratarTecla(&pt, tecla, m.passos)) {
+                rodando = 0;
+                break;
+            }
+        }
+        entradaVazia = relogioNs();
+        if (!desenhar) chegadaTecla = -1; // acordou sem tecla (fim da entrada ou sinal)
+
+        // 3) passos vencidos: um por período; atrasos viram quadros perdidos
+        vencidos = (acordou - inicio) / NS_PASSO + 1 - agendados;
+        if (vencidos > 0) {
+            registrarTempo(&m.atraso, acordou - prazo);
+            m.perdidos += vencidos - 1;
+            if (vencidos > PASSOS_ATRASO_MAXIMO) {
+                m.descartados += vencidos - PASSOS_ATRASO_MAXIMO;
+                agendados += vencidos - PASSOS_ATRASO_MAXIMO;
+                vencidos = PASSOS_ATRASO_MAXIMO;
+            }
+            for (; vencidos > 0; vencidos--) {
+                passoTempoReal(&pt, m.passos);
+                agendados++;
+                m.passos++;
+                if (cargaUs > 0) {
+                    long fimCarga = relogioNs() + cargaUs * 1000;
+                    while (relogioNs() < fimCarga) {}
+                }
+            }
+            desenhar = 1;
+        }
+
+        // 4) quadro: só as diferenças, num write()
+        if (desenhar) {
+            long fim;
+            desenharQuadroTempoReal(tela, &pt, &m);
+            renderizadorApresentar(tela);
+            fim = relogioNs();
+            m.quadros++;
+            m.ultimoTrabalho = fim - acordou;
+            registrarTempo(&m.trabalho, m.ultimoTrabalho);
+            if (chegadaTecla >= 0) {
+                m.ultimaLatencia = fim - chegadaTecla;
+                registrarTempo(&m.latencia, m.ultimaLatencia);
+                chegadaTecla = -1;
+            }
+        }
+    }
+
+    liberarRenderizador(tela); // mostra o cursor de novo
+    tela = NULL;
+    tecladoRestaurar();
+    sigaction(SIGINT, &anteriorInt, NULL);
+    sigaction(SIGTERM, &anteriorTerm, NULL);
+    relatarTempoReal(&m, (relogioNs() - inicio) / 1e9, cargaUs);
+    printf("Linhas: %ld | peças: %ld\n", pt.jogo.tabuleiro.linhasRemovidas, pt.jogo.tabuleiro.pecasColocadas);
+    return 0;
+}
+
+// ---------------- Função principal ---------------- //
+int main(int argc, char *argv[]) {
+    EstadoJogo jogo;
+    Diario diario;
+    Bot bot;
+    int opcao;
+    int feixe = FEIXE_PADRAO, profundidade = PROFUNDIDADE_PADRAO;
+    int modoBench = 0;
+    long nBench = 0;
+    ModoRandomizador modoSorteio = RAND_SACOLA;
+    uint64_t semente = (uint64_t)time(NULL);
+    double pesos[MAX_TIPOS_RANDOMIZADOR] = {2, 1, 1, 1, 1, 1, 1}; // padrão: I em dobro
+    int pesosInformados = 0;
+    const char *script = NULL;
+    const char *lote = NULL;
+    int usarTela = 0;
+    long repeticoes = 1;
+    double duracao = 0;
+    long cargaUs = 0;
+    double proporcao[NUM_OPERACOES] = {4, 2, 2, 1, 1, 1}; // jogar, reservar, usar, trocar, trocar3, trocark
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench-tabuleiro") == 0) {
+            modoBench = 1;
+            nBench = 50000000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--bot") == 0) {
+            modoBench = 2;
+            nBench = 100000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--bench-spsc") == 0) {
+            modoBench = 3;
+            nBench = 10000000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--bench-rand") == 0) {
+            modoBench = 4;
+            nBench = 100000000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--bench-troca") == 0) {
+            modoBench = 6;
+            nBench = 100000000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--bench-desfazer") == 0) {
+            modoBench = 7;
+            nBench = 20000000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--bench-tela") == 0) {
+            modoBench = 8;
+            nBench = 100000;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--tela") == 0) {
+            usarTela = 1;
+        } else if (strcmp(argv[i], "--tempo-real") == 0) {
+            modoBench = 9;
+        } else if (strcmp(argv[i], "--duracao") == 0 && i + 1 < argc) {
+            duracao = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--carga") == 0 && i + 1 < argc) {
+            cargaUs = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            modoBench = 5;
+            script = argv[++i];
+        } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            modoBench = 10;
+            lote = argv[++i];
+        } else if (strcmp(argv[i], "--mix") == 0) {
+            modoBench = 5;
+            nBench = MIX_PADRAO;
+            if (i + 1 < argc && argv[i + 1][0] != '-') nBench = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--proporcao") == 0 && i + 1 < argc) {
+            // proporções na ordem jogar,reservar,usar,trocar,trocar3,trocark
+            char *p = argv[++i];
+            for (int k = 0; k < NUM_OPERACOES && *p; k++) {
+                proporcao[k] = strtod(p, &p);
+                if (*p == ',') p++;
+            }
+        } else if (strcmp(argv[i], "--repetir") == 0 && i + 1 < argc) {
+            repeticoes = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--randomizador") == 0 && i + 1 < argc) {
+            int modo = randomizadorModoPorNome(argv[++i]);
+            if (modo < 0) {
+                printf("Randomizador desconhecido: %s (use uniforme, sacola, historico ou ponderado)\n", argv[i]);
+                return 1;
+            }
+            modoSorteio = (ModoRandomizador)modo;
+        } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            semente = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--pesos") == 0 && i + 1 < argc) {
+            // pesos na ordem I,O,T,L,J,S,Z separados por vírgula
+            char *p = argv[++i];
+            for (int k = 0; k < 7 && *p; k++) {
+                pesos[k] = strtod(p, &p);
+                if (*p == ',') p++;
+            }
+            pesosInformados = 1;
+        } else if (strcmp(argv[i], "--feixe") == 0 && i + 1 < argc) {
+            feixe = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--profundidade") == 0 && i + 1 < argc) {
+            profundidade = atoi(argv[++i]);
+        }
+    }
+    if (nBench < 1) nBench = 1;
+    if (repeticoes < 1) repeticoes = 1;
+
+    randomizadorInicializar(&randomizador, modoSorteio, TIPOS_JOGO, semente);
+    if (pesosInformados || modoSorteio == RAND_PONDERADO) {
+        if (!randomizadorDefinirPesos(&randomizador, pesos)) {
+            printf("Pesos inválidos: use 7 números >= 0, nem todos zero.\n");
+            return 1;
+        }
+    }
+    if (modoBench == 1) return benchmarkTabuleiro(nBench);
+    if (modoBench == 2) return benchmarkBot(nBench, feixe, profundidade);
+    if (modoBench == 3) return benchmarkGerador(nBench);
+    if (modoBench == 4) return benchmarkRandomizador(nBench, pesos);
+    if (modoBench == 6) return benchmarkTroca(nBench);
+    if (modoBench == 7) return benchmarkDesfazer(nBench);
+    if (modoBench == 8) return benchmarkTela(nBench);
+    if (modoBench == 9) return jogarTempoReal(duracao, cargaUs);
+    if (modoBench == 10) return executarLote(lote, feixe, profundidade);
+    if (modoBench == 5) {
+        long n = nBench;
+        Comando *cmds = script ? lerScript(script, &n) : gerarMistura(n, proporcao);
+        if (!cmds) {
+            if (!script) printf("Proporções inválidas ou memória insuficiente.\n");
+            return 1;
+        }
+        int r = executarSemTela(cmds, n, repeticoes, script ? script : "mistura sorteada");
+        memLiberar(cmds);
+        return r;
+    }
+
+    if (!inicializarBot(&bot, feixe, profundidade) || !inicializarDiario(&diario, 256)) {
+        printf("Erro: memória insuficiente para o bot.\n");
+        return 1;
+    }
+
+    consoleIniciar();
+    inicializarJogo(&jogo);
+    if (usarTela && !(tela = criarRenderizador(STDOUT_FILENO, LARGURA_TELA, ALTURA_TELA))) {
+        printf("Erro: memória insuficiente para a tela.\n");
+        return 1;
+    }
+
+    do {
+        mostrarEstado(&jogo);
+        perguntar("Escolha: ");
+        opcao = -1;
+        if (consoleLerInteiro(&opcao) < 0) opcao = 0; // fim da entrada: sai
+
+        switch (opcao) {
+            case 1: {
+                if (!filaVazia(&jogo.fila)) {
+                    Peca jogada = *anelEspiar(&jogo.fila, 0);
+                    int rotacao, coluna;
+                    avisar("\n🎮 Peça jogada: [%c %d]\n", jogada.tipo, jogada.id);
+                    lerJogada(jogada, &rotacao, &coluna);
+                    relatarJogada(aplicarRegistrando(&jogo, &diario, comandoManual(OP_JOGAR, rotacao, coluna, 0)));
+                }
+                break;
+            }
+            case 2: {
+                if (aplicarRegistrando(&jogo, &diario, comandoManual(OP_RESERVAR, 0, 0, 0)) == 0) {
+                    Peca reservada = jogo.pilha.itens[jogo.pilha.topo];
+                    avisar("\n📦 Peça enviada para a pilha: [%c %d]\n", reservada.tipo, reservada.id);
+                }
+                break;
+            }
+            case 3: {
+                if (!pilhaVazia(&jogo.pilha)) {
+                    Peca usada = jogo.pilha.itens[jogo.pilha.topo];
+                    int rotacao, coluna;
+                    avisar("\n🧱 Peça usada da pilha: [%c %d]\n", usada.tipo, usada.id);
+                    lerJogada(usada, &rotacao, &coluna);
+                    relatarJogada(aplicarRegistrando(&jogo, &diario, comandoManual(OP_USAR, rotacao, coluna, 0)));
+                }
+                break;
+            }
+            case 4:
+                if (aplicarRegistrando(&jogo, &diario, comandoManual(OP_TROCAR, 0, 0, 0)) == 0)
+                    avisar("\n🔄 Troca pontual realizada entre a frente da fila e o topo da pilha.\n");
+                else
+                    avisar("\n⚠️  Não é possível realizar troca: fila ou pilha vazia.\n");
+                break;
+            case 5:
+                if (aplicarRegistrando(&jogo, &diario, comandoManual(OP_TROCAR_TRES, 0, 0, 0)) == 0)
+                    avisar("\n🔄 Troca múltipla realizada entre os 3 primeiros da fila e da pilha.\n");
+                else
+                    avisar("\n⚠️  Não é possível realizar troca múltipla: elementos insuficientes.\n");
+                break;
+            case 6: {
+                if (filaVazia(&jogo.fila)) break;
+                JogadaBot j = escolherJogadaBot(&bot, &jogo.fila, &jogo.pilha, &jogo.tabuleiro);
+                if (j.trocarTres) avisar("\n🤖 Bot: troca os 3 primeiros da fila com a pilha.\n");
+                if (j.trocar) avisar("\n🤖 Bot: troca a frente da fila com o topo da pilha.\n");
+                Peca jogada;
+                diario.n = diario.nCopias = 0; // jogadas do bot não entram no diário
+                int linhas = executarJogadaBot(&jogo.fila, &jogo.pilha, &jogo.tabuleiro,
+                                               &jogo.contadorID, j, &jogada);
+                if (linhas < 0) {
+                    avisar("\n💥 O bot não encontrou jogada válida! Fim de jogo, tabuleiro reiniciado.\n");
+                    inicializarTabuleiro(&jogo.tabuleiro);
+                } else {
+                    avisar("\n🤖 Bot jogou [%c %d] com rotação %d na coluna %d (nota %.2f)",
+                           jogada.tipo, jogada.id, j.rotacao, j.coluna, j.nota);
+                    if (linhas > 0) avisar(" - %d linha(s) removida(s)!", linhas);
+                    avisar("\n");
+                }
+                break;
+            }
+            case 7: {
+                int k = 0;
+                perguntar("Quantas peças trocar (1-%d): ", MAIOR_BLOCO);
+                consoleLerInteiro(&k);
+                if (aplicarRegistrando(&jogo, &diario, comandoManual(OP_TROCAR_BLOCO, 0, 0, k)) == 0)
+                    avisar("\n🔄 Troca em bloco realizada entre as %d primeiras da fila e as %d do topo da pilha.\n", k, k);
+                else
+                    avisar("\n⚠️  Não é possível trocar %d peças: elementos insuficientes.\n", k);
+                break;
+            }
+            case 8:
+                if (desfazerUltima(&jogo, &diario))
+                    avisar("\n↩️  Última ação desfeita.\n");
+                else
+                    avisar("\n⚠️  Nada para desfazer.\n");
+                break;
+            case 0:
+                avisar("\n👋 Encerrando o programa...\n");
+                break;
+            default:
+                avisar("\n❌ Opção inválida!\n");
+        }
+    } while (opcao != 0);
+
+    liberarBot(&bot);
+    liberarDiario(&diario);
+    liberarRenderizador(tela);
+    return 0;
+}
@@ -1,23 +1,26 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include "tabuleirotetris.h"
+#include "filaanel.h"
+#include "randomizador.h"
+#include "console.h"
+#include "lote.h"
+#include "instrumentacao.h"
 
 #define TAMANHO_FILA 5   // Tamanho fixo da fila de peças futuras
 #define TAMANHO_PILHA 3  // Capacidade máxima da pilha de reserva
 
 // Estrutura que representa uma peça do Tetris
 typedef struct {
-    char tipo;  // Tipo da peça ('I', 'O', 'T', 'L')
+    char tipo;  // Tipo da peça ('I', 'O', 'T', 'L', 'J', 'S', 'Z')
     int id;     // Identificador único da peça
 } Peca;
 
 // ---------- Estrutura da Fila Circular ---------- //
-typedef struct {
-    Peca itens[TAMANHO_FILA];
-    int inicio;
-    int fim;
-    int qtd;
-} Fila;
+// Anel com capacidade potência de 2 (>= TAMANHO_FILA) e índice por máscara (filaanel.h)
+FILA_ANEL_DECLARAR(Fila, Peca, TAMANHO_FILA, anel)
 
 // ---------- Estrutura da Pilha Linear ---------- //
 typedef struct {
@@ -29,34 +32,32 @@ typedef struct {
 
 // Inicializa a fila vazia
 void inicializarFila(Fila *f) {
-    f->inicio = 0;
-    f->fim = -1;
-    f->qtd = 0;
+    anelInicializar(f);
 }
 
 // Verifica se a fila está cheia
 int filaCheia(Fila *f) {
-    return f->qtd == TAMANHO_FILA;
+    return anelQuantidade(f) == TAMANHO_FILA;
 }
 
 // Verifica se a fila está vazia
 int filaVazia(Fila *f) {
-    return f->qtd == 0;
+    return anelVazia(f);
 }
 
 // Insere peça no final da fila
 void enfileirar(Fila *f, Peca p) {
+    INSTR_CRONOMETRAR("enfileirar");
     if (filaCheia(f)) {
         printf("\n⚠️  Fila cheia! Não é possível adicionar nova peça.\n");
         return;
     }
-    f->fim = (f->fim + 1) % TAMANHO_FILA;
-    f->itens[f->fim] = p;
-    f->qtd++;
+    anelEnfileirar(f, &p);
 }
 
 // Remove e retorna a peça da frente da fila
 Peca desenfileirar(Fila *f) {
+    INSTR_CRONOMETRAR("desenfileirar");
     Peca removida = {' ', -1};
 
     if (filaVazia(f)) {
@@ -64,9 +65,7 @@ Peca desenfileirar(Fila *f) {
         return removida;
     }
 
-    removida = f->itens[f->inicio];
-    f->inicio = (f->inicio + 1) % TAMANHO_FILA;
-    f->qtd--;
+    anelDesenfileirar(f, &removida);
 
     return removida;
 }
@@ -79,10 +78,10 @@ void exibirFila(Fila *f) {
         return;
     }
 
-    int i, pos = f->inicio;
-    for (i = 0; i < f->qtd; i++) {
-        printf("[%c %d] ", f->itens[pos].tipo, f->itens[pos].id);
-        pos = (pos + 1) % TAMANHO_FILA;
+    Peca pecas[TAMANHO_FILA];
+    int i, n = anelEspiarIntervalo(f, 0, pecas, TAMANHO_FILA);
+    for (i = 0; i < n; i++) {
+        printf("[%c %d] ", pecas[i].tipo, pecas[i].id);
     }
     printf("\n");
 }
@@ -106,6 +105,7 @@ int pilhaVazia(Pilha *p) {
 
 // Empilha uma peça no topo
 void empilhar(Pilha *p, Peca x) {
+    INSTR_CRONOMETRAR("empilhar");
     if (pilhaCheia(p)) {
         printf("\n⚠️  Pilha cheia! Não é possível reservar mais peças.\n");
         return;
@@ -116,6 +116,7 @@ void empilhar(Pilha *p, Peca x) {
 
 // Desempilha e retorna a peça do topo
 Peca desempilhar(Pilha *p) {
+    INSTR_CRONOMETRAR("desempilhar");
     Peca removida = {' ', -1};
 
     if (pilhaVazia(p)) {
@@ -143,51 +144,190 @@ void exibirPilha(Pilha *p) {
 }
 
 // ---------- Função que gera uma nova peça aleatória ---------- //
+// Sorteio: os 7 tetrominós em sacolas embaralhadas (ver randomizador.h)
+static Randomizador randomizador;
+
 Peca gerarPeca(int id) {
     Peca nova;
-    char tipos[] = {'I', 'O', 'T', 'L'};
-    nova.tipo = tipos[rand() % 4];
+    nova.tipo = randomizadorProxima(&randomizador);
     nova.id = id;
     return nova;
 }
 
+// ---------- Tabuleiro ---------- //
+
+#define JOGADA_INVALIDA -2  // coluna fora do tabuleiro: peça descartada
+
+// Derruba a peça na rotação e coluna dadas. Retorna as linhas removidas, -1 se
+// a peça não coube (tabuleiro reiniciado) ou JOGADA_INVALIDA.
+int derrubarPeca(Tabuleiro *t, Peca p, int rotacao, int coluna) {
+    INSTR_CRONOMETRAR("derrubarPeca");
+    int linhas;
+    if (coluna < 0 || coluna + larguraPeca(p.tipo, rotacao) > LARGURA_TABULEIRO) return JOGADA_INVALIDA;
+    linhas = colocarPeca(t, p.tipo, rotacao, coluna);
+    if (linhas < 0) inicializarTabuleiro(t);
+    else INSTR_SOMAR("tabuleiro.linhas", linhas);
+    return linhas;
+}
+
+// Pede rotação e coluna ao jogador e derruba a peça no tabuleiro
+void jogarNoTabuleiro(Tabuleiro *t, Peca p) {
+    int rotacao = 0, coluna = -1, linhas;
+
+    consoleInterface("Rotação (0-3): ");
+    consoleLerInteiro(&rotacao);
+    rotacao &= 3;
+    consoleInterface("Coluna (0-%d): ", LARGURA_TABULEIRO - larguraPeca(p.tipo, rotacao));
+    consoleLerInteiro(&coluna);
+
+    linhas = derrubarPeca(t, p, rotacao, coluna);
+    if (linhas == JOGADA_INVALIDA) {
+        printf("\n⚠️  Coluna inválida! A peça foi descartada.\n");
+    } else if (linhas < 0) {
+        printf("\n💥 A peça não cabe mais no tabuleiro! Fim de jogo, tabuleiro reiniciado.\n");
+    } else if (linhas > 0) {
+        printf("\n✨ %d linha(s) completa(s) removida(s)!\n", linhas);
+    }
+}
+
+// ---------- Modo lote ---------- //
+// --lote arquivo (ou - para a entrada padrão): as opções do menu sem perguntas,
+// com saída no formato de lote.h. Use --semente para repetir as mesmas peças.
+//     jogar <rotacao> <coluna>  -> ok jogar <peça> <rotação> <coluna> <linhas|invalida|fim-de-jogo>
+//     reservar                  -> ok reservar <peça>
+//     usar <rotacao> <coluna>   -> ok usar <peça> <rotação> <coluna> <linhas|invalida|fim-de-jogo>
+//     estado                    -> ok estado <fila> <pilha do topo para a base> <altura>
+//                                  <linhas removidas> <peças colocadas>
+// Sem peça para jogar/usar ou pilha cheia (reservar): "nao <comando>".
+
+static void relatarJogadaLote(const char *nome, Peca p, int rotacao, int coluna, int linhas) {
+    printf("ok\t%s\t%c\t%d\t%d\t", nome, p.tipo, rotacao, coluna);
+    if (linhas == JOGADA_INVALIDA) printf("invalida\n");
+    else if (linhas < 0) printf("fim-de-jogo\n");
+    else printf("%d\n", linhas);
+}
+
+int executarLote(const char *caminho) {
+    Fila fila;
+    Pilha pilha;
+    Tabuleiro tabuleiro;
+    int contadorID = 0;
+    Lote lote;
+
+    if (!loteAbrir(&lote, caminho)) return 1;
+    inicializarFila(&fila);
+    inicializarPilha(&pilha);
+    inicializarTabuleiro(&tabuleiro);
+    for (int i = 0; i < TAMANHO_FILA; i++) {
+        Peca p = gerarPeca(contadorID++);
+        anelEnfileirar(&fila, &p);
+    }
+
+    while (loteProximo(&lote)) {
+        const char *nome = loteCampo(&lote, 0);
+        long rotacao, coluna;
+        Peca p;
+
+        if (loteComando(&lote, "jogar", 2) || loteComando(&lote, "usar", 2)) {
+            int usar = nome[0] == 'u';
+            if (!loteInteiro(&lote, 1, &rotacao) || !loteInteiro(&lote, 2, &coluna)) {
+                loteErro(&lote, "rotacao/coluna invalidas");
+                continue;
+            }
+            if (usar ? pilhaVazia(&pilha) : !anelDesenfileirar(&fila, &p)) {
+                printf("nao\t%s\n", nome);
+                continue;
+            }
+            if (usar) {
+                p = pilha.itens[pilha.topo--];
+            } else {
+                Peca nova = gerarPeca(contadorID++); // mantém a fila cheia, como no menu
+                anelEnfileirar(&fila, &nova);
+            }
+            relatarJogadaLote(nome, p, (int)(rotacao & 3), (int)coluna,
+                              derrubarPeca(&tabuleiro, p, (int)(rotacao & 3), (int)coluna));
+        } else if (loteComando(&lote, "reservar", 0)) {
+            Peca nova;
+            if (filaVazia(&fila) || pilhaCheia(&pilha)) {
+                printf("nao\treservar\n");
+                continue;
+            }
+            anelDesenfileirar(&fila, &p);
+            pilha.itens[++pilha.topo] = p;
+            nova = gerarPeca(contadorID++);
+            anelEnfileirar(&fila, &nova);
+            printf("ok\treservar\t%c\n", p.tipo);
+        } else if (loteComando(&lote, "estado", 0)) {
+            printf("ok\testado\t");
+            for (unsigned i = 0; i < anelQuantidade(&fila); i++) putchar(anelEspiar(&fila, i)->tipo);
+            putchar('\t');
+            for (int i = pilha.topo; i >= 0; i--) putchar(pilha.itens[i].tipo);
+            printf("\t%d\t%ld\t%ld\n", tabuleiro.altura, tabuleiro.linhasRemovidas, tabuleiro.pecasColocadas);
+        } else {
+            loteErro(&lote, "comando desconhecido ou incompleto: %s", nome);
+        }
+    }
+    return loteFechar(&lote);
+}
+
 // ---------- Função principal ---------- //
-int main() {
+int main(int argc, char *argv[]) {
     Fila fila;
     Pilha pilha;
+    Tabuleiro tabuleiro;
     int opcao;
     int contadorID = 0;
+    uint64_t semente = (uint64_t)time(NULL);
+    const char *lote = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc)
+            semente = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc)
+            lote = argv[++i];
+    }
+
+    // Semente para geração aleatória
+    randomizadorInicializar(&randomizador, RAND_SACOLA, "IOTLJSZ", semente);
+    if (lote) return executarLote(lote);
 
-    srand(time(NULL));  // Semente para geração aleatória
+    consoleIniciar();
     inicializarFila(&fila);
     inicializarPilha(&pilha);
+    inicializarTabuleiro(&tabuleiro);
 
-    // Preenche a fila com peças iniciais
+    // Preenche a fila com peças iniciais (de uma vez só)
+    Peca iniciais[TAMANHO_FILA];
     for (int i = 0; i < TAMANHO_FILA; i++) {
-        Peca nova = gerarPeca(contadorID++);
-        enfileirar(&fila, nova);
+        iniciais[i] = gerarPeca(contadorID++);
     }
+    anelEnfileirarLote(&fila, iniciais, TAMANHO_FILA);
 
     // Menu principal
     do {
-        printf("\n===================== ESTADO ATUAL =====================\n");
-        exibirFila(&fila);
-        exibirPilha(&pilha);
-        printf("========================================================\n");
-
-        printf("\nOpções:\n");
-        printf("1 - Jogar peça (remove da fila)\n");
-        printf("2 - Reservar peça (fila → pilha)\n");
-        printf("3 - Usar peça reservada (remove da pilha)\n");
-        printf("0 - Sair\n");
-        printf("Escolha: ");
-        scanf("%d", &opcao);
+        if (consoleInterativo()) { // no modo silencioso o estado não é redesenhado a cada jogada
+            printf("\n===================== ESTADO ATUAL =====================\n");
+            exibirTabuleiro(&tabuleiro);
+            exibirFila(&fila);
+            exibirPilha(&pilha);
+            printf("========================================================\n");
+        }
+
+        consoleInterface("\nOpções:\n");
+        consoleInterface("1 - Jogar peça (remove da fila)\n");
+        consoleInterface("2 - Reservar peça (fila → pilha)\n");
+        consoleInterface("3 - Usar peça reservada (remove da pilha)\n");
+        consoleInterface("0 - Sair\n");
+        consoleInterface("Escolha: ");
+        opcao = -1;
+        if (consoleLerInteiro(&opcao) < 0) opcao = 0; // fim da entrada: sai
 
         switch (opcao) {
             case 1: {
                 if (!filaVazia(&fila)) {
                     Peca jogada = desenfileirar(&fila);
                     printf("\n🎮 Peça jogada: [%c %d]\n", jogada.tipo, jogada.id);
+                    jogarNoTabuleiro(&tabuleiro, jogada);
 
                     // Após jogar, gera uma nova peça e adiciona à fila
                     Peca nova = gerarPeca(contadorID++);
@@ -215,6 +355,7 @@ int main() {
                 if (!pilhaVazia(&pilha)) {
                     Peca usada = desempilhar(&pilha);
                     printf("\n🧱 Peça usada da reserva: [%c %d]\n", usada.tipo, usada.id);
+                    jogarNoTabuleiro(&tabuleiro, usada);
                 }
                 break;
             }
@@ -1,77 +1,81 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include "tabuleirotetris.h"
+#include "filaanel.h"
+#include "randomizador.h"
+#include "console.h"
+#include "lote.h"
+#include "instrumentacao.h"
 
 #define TAMANHO_FILA 5  // Tamanho fixo da fila de peças
 
 // Estrutura que representa uma peça do Tetris
 typedef struct {
-    char tipo;  // Tipo da peça ('I', 'O', 'T', 'L')
+    char tipo;  // Tipo da peça ('I', 'O', 'T', 'L', 'J', 'S', 'Z')
     int id;     // Identificador único da peça
 } Peca;
 
-// Estrutura da fila circular
-typedef struct {
-    Peca itens[TAMANHO_FILA];
-    int inicio;  // Índice do primeiro elemento
-    int fim;     // Índice do último elemento
-    int qtd;     // Quantidade atual de elementos na fila
-} Fila;
+// Estrutura da fila circular: anel com capacidade potência de 2 (>= TAMANHO_FILA),
+// índice por máscara e contadores de início/fim que só crescem (ver filaanel.h)
+FILA_ANEL_DECLARAR(Fila, Peca, TAMANHO_FILA, anel)
 
 // ---------- Funções da Fila ---------- //
 
 // Inicializa a fila vazia
 void inicializarFila(Fila *f) {
-    f->inicio = 0;
-    f->fim = -1;
-    f->qtd = 0;
+    anelInicializar(f);
 }
 
 // Verifica se a fila está cheia
 int filaCheia(Fila *f) {
-    return f->qtd == TAMANHO_FILA;
+    return anelQuantidade(f) == TAMANHO_FILA;
 }
 
 // Verifica se a fila está vazia
 int filaVazia(Fila *f) {
-    return f->qtd == 0;
+    return anelVazia(f);
 }
 
+// Sorteio das peças: os 7 tetrominós em sacolas embaralhadas (ver randomizador.h)
+static Randomizador randomizador;
+
 // Gera uma nova peça aleatória
 Peca gerarPeca(int id) {
     Peca nova;
-    char tipos[] = {'I', 'O', 'T', 'L'};
-    nova.tipo = tipos[rand() % 4];  // Escolhe aleatoriamente entre os tipos
+    nova.tipo = randomizadorProxima(&randomizador);  // Escolhe aleatoriamente entre os tipos
     nova.id = id;
     return nova;
 }
 
 // Insere uma nova peça ao final da fila (enqueue)
 void enfileirar(Fila *f, Peca p) {
+    INSTR_CRONOMETRAR("enfileirar");
     if (filaCheia(f)) {
         printf("\n⚠️  Fila cheia! Não é possível adicionar nova peça.\n");
         return;
     }
 
-    f->fim = (f->fim + 1) % TAMANHO_FILA;
-    f->itens[f->fim] = p;
-    f->qtd++;
+    anelEnfileirar(f, &p);
 
     printf("\n✅ Peça [%c %d] adicionada à fila.\n", p.tipo, p.id);
 }
 
-// Remove a peça da frente da fila (dequeue)
-void desenfileirar(Fila *f) {
+// Remove a peça da frente da fila (dequeue) e a retorna
+Peca desenfileirar(Fila *f) {
+    INSTR_CRONOMETRAR("desenfileirar");
+    Peca removida = {' ', -1};
+
     if (filaVazia(f)) {
         printf("\n⚠️  Fila vazia! Nenhuma peça para jogar.\n");
-        return;
+        return removida;
     }
 
-    Peca removida = f->itens[f->inicio];
-    f->inicio = (f->inicio + 1) % TAMANHO_FILA;
-    f->qtd--;
+    anelDesenfileirar(f, &removida);
 
     printf("\n🎮 Peça jogada: [%c %d]\n", removida.tipo, removida.id);
+    return removida;
 }
 
 // Exibe o estado atual da fila
@@ -83,24 +87,249 @@ void exibirFila(Fila *f) {
         return;
     }
 
-    int i, pos = f->inicio;
-    for (i = 0; i < f->qtd; i++) {
-        printf("[%c %d] ", f->itens[pos].tipo, f->itens[pos].id);
-        pos = (pos + 1) % TAMANHO_FILA;
+    Peca pecas[TAMANHO_FILA];
+    int i, n = anelEspiarIntervalo(f, 0, pecas, TAMANHO_FILA);
+    for (i = 0; i < n; i++) {
+        printf("[%c %d] ", pecas[i].tipo, pecas[i].id);
     }
 
     printf("\n=========================\n");
 }
 
+// ---------- Tabuleiro ---------- //
+
+#define JOGADA_INVALIDA -2  // coluna fora do tabuleiro: peça descartada
+
+// Derruba a peça na rotação e coluna dadas. Retorna as linhas removidas, -1 se
+// a peça não coube (tabuleiro reiniciado) ou JOGADA_INVALIDA.
+int derrubarPeca(Tabuleiro *t, Peca p, int rotacao, int coluna) {
+    INSTR_CRONOMETRAR("derrubarPeca");
+    int linhas;
+    if (coluna < 0 || coluna + larguraPeca(p.tipo, rotacao) > LARGURA_TABULEIRO) return JOGADA_INVALIDA;
+    linhas = colocarPeca(t, p.tipo, rotacao, coluna);
+    if (linhas < 0) inicializarTabuleiro(t);
+    else INSTR_SOMAR("tabuleiro.linhas", linhas);
+    return linhas;
+}
+
+// Pede rotação e coluna ao jogador e derruba a peça no tabuleiro
+void jogarNoTabuleiro(Tabuleiro *t, Peca p) {
+    int rotacao = 0, coluna = -1, linhas;
+
+    consoleInterface("Rotação (0-3): ");
+    consoleLerInteiro(&rotacao);
+    rotacao &= 3;
+    consoleInterface("Coluna (0-%d): ", LARGURA_TABULEIRO - larguraPeca(p.tipo, rotacao));
+    consoleLerInteiro(&coluna);
+
+    linhas = derrubarPeca(t, p, rotacao, coluna);
+    if (linhas == JOGADA_INVALIDA) {
+        printf("\n⚠️  Coluna inválida! A peça foi descartada.\n");
+    } else if (linhas < 0) {
+        printf("\n💥 A peça não cabe mais no tabuleiro! Fim de jogo, tabuleiro reiniciado.\n");
+    } else if (linhas > 0) {
+        printf("\n✨ %d linha(s) completa(s) removida(s)!\n", linhas);
+    }
+}
+
+// ---------- Benchmark da fila ---------- //
+
+// Fila circular antiga (resto da divisão + inicio/fim/qtd), mantida só para comparação
+typedef struct {
+    Peca itens[TAMANHO_FILA];
+    int inicio;
+    int fim;
+    int qtd;
+} FilaModulo;
+
+static void enfileirarModulo(FilaModulo *f, Peca p) {
+    if (f->qtd == TAMANHO_FILA) return;
+    f->fim = (f->fim + 1) % TAMANHO_FILA;
+    f->itens[f->fim] = p;
+    f->qtd++;
+}
+
+static Peca desenfileirarModulo(FilaModulo *f) {
+    Peca removida = {' ', -1};
+    if (f->qtd == 0) return removida;
+    removida = f->itens[f->inicio];
+    f->inicio = (f->inicio + 1) % TAMANHO_FILA;
+    f->qtd--;
+    return removida;
+}
+
+static double tempoMonotonico(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void relatarFila(const char *nome, long ops, double seg, long soma) {
+    printf("%-34s %12ld %9.3f %14.0f %7.2f   (soma %ld)\n", nome, ops, seg,
+           seg > 0 ? ops / seg : 0.0, seg > 0 ? seg * 1e9 / ops : 0.0, soma);
+}
+
+// Compara a fila antiga (%) com o anel (máscara), operação a operação e em lotes.
+// A soma dos ids retirados é impressa para o compilador não descartar o laço.
+int benchmarkFila(long n) {
+    FilaModulo antiga = {.inicio = 0, .fim = -1, .qtd = 0};
+    Fila anel;
+    Peca p = {'T', 0}, lote[4];
+    long i, soma;
+    double ini;
+
+    printf("\n=== Benchmark da fila (%ld iterações, TAMANHO_FILA = %d, anel com %u posições) ===\n",
+           n, TAMANHO_FILA, (unsigned) anelMascara + 1);
+    printf("%-34s %12s %9s %14s %7s\n", "modo", "operacoes", "tempo(s)", "ops/s", "ns/op");
+
+    // 1) enfileirar + desenfileirar com a fila quase cheia (o índice dá a volta sempre)
+    for (i = 0; i < TAMANHO_FILA - 1; i++) enfileirarModulo(&antiga, p);
+    soma = 0;
+    ini = tempoMonotonico();
+    for (i = 0; i < n; i++) {
+        p.id = (int)i;
+        enfileirarModulo(&antiga, p);
+        soma += desenfileirarModulo(&antiga).id;
+    }
+    relatarFila("antiga (% TAMANHO_FILA)", 2 * n, tempoMonotonico() - ini, soma);
+
+    anelInicializar(&anel);
+    p.id = 0;
+    for (i = 0; i < TAMANHO_FILA - 1; i++) anelEnfileirar(&anel, &p);
+    soma = 0;
+    ini = tempoMonotonico();
+    for (i = 0; i < n; i++) {
+        Peca saida = {' ', -1};
+        p.id = (int)i;
+        anelEnfileirar(&anel, &p);
+        anelDesenfileirar(&anel, &saida);
+        soma += saida.id;
+    }
+    relatarFila("anel (mascara)", 2 * n, tempoMonotonico() - ini, soma);
+
+    // 2) lotes de 4 (filas vazias no início): a antiga precisa de 4 chamadas cada
+    while (antiga.qtd > 0) desenfileirarModulo(&antiga);
+    anelInicializar(&anel);
+    soma = 0;
+    ini = tempoMonotonico();
+    for (i = 0; i < n; i++) {
+        int k;
+        for (k = 0; k < 4; k++) {
+            p.id = (int)i + k;
+            enfileirarModulo(&antiga, p);
+        }
+        for (k = 0; k < 4; k++) soma += desenfileirarModulo(&antiga).id;
+    }
+    relatarFila("antiga, 4 + 4 chamadas", 8 * n, tempoMonotonico() - ini, soma);
+
+    soma = 0;
+    ini = tempoMonotonico();
+    for (i = 0; i < n; i++) {
+        int k;
+        for (k = 0; k < 4; k++) {
+            lote[k].tipo = 'T';
+            lote[k].id = (int)i + k;
+        }
+        anelEnfileirarLote(&anel, lote, 4);
+        anelDesenfileirarLote(&anel, lote, 4);
+        for (k = 0; k < 4; k++) soma += lote[k].id;
+    }
+    relatarFila("anel, lotes de 4", 8 * n, tempoMonotonico() - ini, soma);
+    return 0;
+}
+
+// ---------- Modo lote ---------- //
+// --lote arquivo (ou - para a entrada padrão): as opções do menu sem perguntas,
+// com saída no formato de lote.h. Use --semente para repetir as mesmas peças.
+//     jogar <rotacao> <coluna>  -> ok jogar <peça> <rotação> <coluna> <linhas|invalida|fim-de-jogo>
+//     inserir                   -> ok inserir <peça>
+//     estado                    -> ok estado <fila> <altura> <linhas removidas> <peças colocadas>
+// Fila vazia (jogar) ou cheia (inserir): "nao <comando>".
+
+static void relatarJogadaLote(const char *nome, Peca p, int rotacao, int coluna, int linhas) {
+    printf("ok\t%s\t%c\t%d\t%d\t", nome, p.tipo, rotacao, coluna);
+    if (linhas == JOGADA_INVALIDA) printf("invalida\n");
+    else if (linhas < 0) printf("fim-de-jogo\n");
+    else printf("%d\n", linhas);
+}
+
+int executarLote(const char *caminho) {
+    Fila fila;
+    Tabuleiro tabuleiro;
+    int contadorID = 0;
+    Lote lote;
+
+    if (!loteAbrir(&lote, caminho)) return 1;
+    inicializarFila(&fila);
+    inicializarTabuleiro(&tabuleiro);
+    for (int i = 0; i < TAMANHO_FILA; i++) {
+        Peca p = gerarPeca(contadorID++);
+        anelEnfileirar(&fila, &p);
+    }
+
+    while (loteProximo(&lote)) {
+        long rotacao, coluna;
+        Peca p;
+
+        if (loteComando(&lote, "jogar", 2)) {
+            if (!loteInteiro(&lote, 1, &rotacao) || !loteInteiro(&lote, 2, &coluna)) {
+                loteErro(&lote, "rotacao/coluna invalidas");
+                continue;
+            }
+            if (!anelDesenfileirar(&fila, &p)) {
+                printf("nao\tjogar\n");
+                continue;
+            }
+            relatarJogadaLote("jogar", p, (int)(rotacao & 3), (int)coluna,
+                              derrubarPeca(&tabuleiro, p, (int)(rotacao & 3), (int)coluna));
+        } else if (loteComando(&lote, "inserir", 0)) {
+            if (filaCheia(&fila)) {
+                printf("nao\tinserir\n");
+                continue;
+            }
+            p = gerarPeca(contadorID++);
+            anelEnfileirar(&fila, &p);
+            printf("ok\tinserir\t%c\n", p.tipo);
+        } else if (loteComando(&lote, "estado", 0)) {
+            printf("ok\testado\t");
+            for (unsigned i = 0; i < anelQuantidade(&fila); i++) putchar(anelEspiar(&fila, i)->tipo);
+            printf("\t%d\t%ld\t%ld\n", tabuleiro.altura, tabuleiro.linhasRemovidas, tabuleiro.pecasColocadas);
+        } else {
+            loteErro(&lote, "comando desconhecido ou incompleto: %s", loteCampo(&lote, 0));
+        }
+    }
+    return loteFechar(&lote);
+}
+
 // ---------- Função principal ---------- //
 
-int main() {
+int main(int argc, char *argv[]) {
     Fila fila;
+    Tabuleiro tabuleiro;
     int opcao;
     int contadorID = 0;
+    uint64_t semente = (uint64_t)time(NULL);
+    const char *lote = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bench-fila") == 0) {
+            long n = 100000000;
+            if (i + 1 < argc) n = atol(argv[i + 1]);
+            return benchmarkFila(n > 0 ? n : 1);
+        } else if (strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            semente = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            lote = argv[++i];
+        }
+    }
 
-    srand(time(NULL)); // Semente para gerar peças aleatórias
+    // Semente para gerar peças aleatórias
+    randomizadorInicializar(&randomizador, RAND_SACOLA, "IOTLJSZ", semente);
+    if (lote) return executarLote(lote);
+
+    consoleIniciar();
     inicializarFila(&fila);
+    inicializarTabuleiro(&tabuleiro);
 
     // Inicializa a fila com 5 peças iniciais
     for (int i = 0; i < TAMANHO_FILA; i++) {
@@ -109,18 +338,27 @@ int main() {
     }
 
     do {
-        exibirFila(&fila);
+        if (consoleInterativo()) { // no modo silencioso o estado não é redesenhado a cada jogada
+            printf("\n");
+            exibirTabuleiro(&tabuleiro);
+            exibirFila(&fila);
+        }
 
-        printf("\nOpções:\n");
-        printf("1 - Jogar peça (dequeue)\n");
-        printf("2 - Inserir nova peça (enqueue)\n");
-        printf("0 - Sair\n");
-        printf("Escolha: ");
-        scanf("%d", &opcao);
+        consoleInterface("\nOpções:\n");
+        consoleInterface("1 - Jogar peça (dequeue)\n");
+        consoleInterface("2 - Inserir nova peça (enqueue)\n");
+        consoleInterface("0 - Sair\n");
+        consoleInterface("Escolha: ");
+        opcao = -1;
+        if (consoleLerInteiro(&opcao) < 0) opcao = 0; // fim da entrada: sai
 
         switch (opcao) {
             case 1:
-                desenfileirar(&fila);
+                if (!filaVazia(&fila)) {
+                    jogarNoTabuleiro(&tabuleiro, desenfileirar(&fila));
+                } else {
+                    desenfileirar(&fila);
+                }
                 break;
 
             case 2:
@@ -0,0 +1,122 @@
+/*
+  vetordinamico.h - Vetor dinâmico contíguo (crescimento geométrico)
+  -------------------------------------------------------------------
+  Container genérico usado pelos programas da mochila (Item e Componente)
+  no lugar dos vetores de tamanho fixo na pilha (MAX_ITENS / MAX_COMPONENTES).
+
+  - Elementos ficam contíguos em um único bloco (realloc).
+  - A capacidade dobra quando o vetor enche (custo amortizado O(1) por inserção).
+  - vdReservar() pré-aloca espaço; vdEncolher() devolve a sobra (shrink-to-fit).
+  - Guarda estatísticas simples: número de (re)alocações e pico de bytes.
+  - O bloco vem de memoria.h (conta "vetor dinamico"): não use free() nele.
+
+  Uso:
+      VetorDinamico v;
+      vdInicializar(&v, sizeof(Item));
+      vdAdicionar(&v, &item);
+      Item *itens = VD_DADOS(&v, Item);   // acesso direto: itens[0 .. v.tamanho-1]
+      vdLiberar(&v);
+
+  Todas as funções são static inline: basta incluir este arquivo e compilar
+  o programa normalmente (gcc programa.c -o programa).
+*/
+
+#ifndef VETORDINAMICO_H
+#define VETORDINAMICO_H
+
+#include <stdlib.h>
+#include <string.h>
+#include "instrumentacao.h"
+#include "memoria.h"
+
+#define VD_CAPACIDADE_INICIAL 8
+
+typedef struct {
+    void *dados;
+    size_t tamanho;       /* elementos em uso */
+    size_t capacidade;    /* elementos que cabem no bloco atual */
+    size_t tamElemento;   /* sizeof do tipo armazenado */
+    size_t alocacoes;     /* quantas vezes o bloco foi (re)alocado */
+    size_t bytesPico;     /* maior bloco já mantido pelo vetor */
+} VetorDinamico;
+
+MEM_CONTA(memVetorDinamico, "vetor dinamico");
+
+/* Acesso tipado ao bloco de dados */
+#define VD_DADOS(v, Tipo) ((Tipo *)(v)->dados)
+
+static inline void vdInicializar(VetorDinamico *v, size_t tamElemento) {
+    v->dados = NULL;
+    v->tamanho = 0;
+    v->capacidade = 0;
+    v->tamElemento = tamElemento;
+    v->alocacoes = 0;
+    v->bytesPico = 0;
+}
+
+/* Realoca o bloco para exatamente 'capacidade' elementos. Retorna 1 se ok, 0 se falhou
+   (nesse caso o vetor continua intacto). */
+static inline int vdRealocar(VetorDinamico *v, size_t capacidade) {
+    INSTR_CRONOMETRAR("vdRealocar");
+    void *novo;
+    if (capacidade == 0) {
+        memLiberar(v->dados);
+        v->dados = NULL;
+        v->capacidade = 0;
+        return 1;
+    }
+    if (capacidade > (size_t)-1 / v->tamElemento) return 0;
+    novo = memRealocar(&memVetorDinamico, v->dados, capacidade * v->tamElemento);
+    if (novo == NULL) return 0;
+    v->dados = novo;
+    v->capacidade = capacidade;
+    v->alocacoes++;
+    if (capacidade * v->tamElemento > v->bytesPico)
+        v->bytesPico = capacidade * v->tamElemento;
+    return 1;
+}
+
+/* Garante espaço para pelo menos 'capacidade' elementos (nunca encolhe). */
+static inline int vdReservar(VetorDinamico *v, size_t capacidade) {
+    if (capacidade <= v->capacidade) return 1;
+    return vdRealocar(v, capacidade);
+}
+
+/* Insere uma cópia de *elem no final. Retorna ponteiro para a posição gravada
+   ou NULL se faltou memória. */
+static inline void *vdAdicionar(VetorDinamico *v, const void *elem) {
+    char *destino;
+    if (v->tamanho == v->capacidade) {
+        size_t nova = v->capacidade ? v->capacidade * 2 : VD_CAPACIDADE_INICIAL;
+        if (!vdRealocar(v, nova)) return NULL;
+    }
+    destino = (char *)v->dados + v->tamanho * v->tamElemento;
+    memcpy(destino, elem, v->tamElemento);
+    v->tamanho++;
+    return destino;
+}
+
+/* Remove o elemento da posição 'indice' preservando a ordem dos demais. */
+static inline void vdRemover(VetorDinamico *v, size_t indice) {
+    char *base = (char *)v->dados;
+    if (indice >= v->tamanho) return;
+    memmove(base + indice * v->tamElemento,
+            base + (indice + 1) * v->tamElemento,
+            (v->tamanho - indice - 1) * v->tamElemento);
+    v->tamanho--;
+}
+
+/* Ajusta a capacidade ao tamanho atual (shrink-to-fit). */
+static inline int vdEncolher(VetorDinamico *v) {
+    if (v->capacidade == v->tamanho) return 1;
+    return vdRealocar(v, v->tamanho);
+}
+
+static inline void vdLiberar(VetorDinamico *v) {
+    memLiberar(v->dados);
+    v->dados = NULL;
+    v->tamanho = 0;
+    v->capacidade = 0;
+}
+
+#endif /* VETORDINAMICO_H */
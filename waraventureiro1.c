@@ -2,6 +2,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "console.h"
+#include "instrumentacao.h"
+#include "memoria.h"
 
 /*
     Programa: Simulação simplificada do jogo War
@@ -10,7 +13,7 @@
     - Exibição dos territórios
     - Simulação de ataques entre territórios (com dados aleatórios)
     - Atualização de dados após batalhas
-    - Liberação de memória ao final
+    - Liberação de memória ao final (MEMORIA=1 mostra o uso por conta, ver memoria.h)
 */
 
 // Definição da struct Territorio
@@ -20,6 +23,9 @@ typedef struct {
     int tropas;
 } Territorio;
 
+// Conta de memória dos territórios (memoria.h)
+MEM_CONTA(memTerritorios, "territorios");
+
 // === Protótipos das funções ===
 Territorio* cadastrarTerritorios(int qtd);
 void exibirTerritorios(Territorio* mapa, int qtd);
@@ -27,14 +33,16 @@ void atacar(Territorio* atacante, Territorio* defensor);
 void liberarMemoria(Territorio* mapa);
 
 int main() {
+    consoleIniciar();
     srand(time(NULL)); // inicializa a semente para números aleatórios
 
-    int qtd, op;
+    int qtd = 0, op;
     printf("=== Simulador Simplificado de WAR ===\n\n");
 
     // Pergunta ao usuário quantos territórios deseja criar
-    printf("Digite o número de territórios a serem cadastrados: ");
-    scanf("%d", &qtd);
+    consoleInterface("Digite o número de territórios a serem cadastrados: ");
+    consoleLerInteiro(&qtd);
+    if (qtd < 0) qtd = 0;
 
     // Alocação dinâmica do vetor de territórios
     Territorio* mapa = cadastrarTerritorios(qtd);
@@ -45,20 +53,21 @@ int main() {
 
     // Menu de ações
     do {
-        printf("\n--- Menu ---\n");
-        printf("1. Realizar ataque\n");
-        printf("2. Exibir territórios\n");
-        printf("0. Sair\n");
-        printf("Escolha: ");
-        scanf("%d", &op);
+        consoleInterface("\n--- Menu ---\n");
+        consoleInterface("1. Realizar ataque\n");
+        consoleInterface("2. Exibir territórios\n");
+        consoleInterface("0. Sair\n");
+        consoleInterface("Escolha: ");
+        op = -1;
+        if (consoleLerInteiro(&op) < 0) op = 0; // fim da entrada: encerra
 
         if (op == 1) {
-            int idAtacante, idDefensor;
+            int idAtacante = -1, idDefensor = -1;
 
-            printf("\nDigite o número do território atacante: ");
-            scanf("%d", &idAtacante);
-            printf("Digite o número do território defensor: ");
-            scanf("%d", &idDefensor);
+            consoleInterface("\nDigite o número do território atacante: ");
+            consoleLerInteiro(&idAtacante);
+            consoleInterface("Digite o número do território defensor: ");
+            consoleLerInteiro(&idDefensor);
 
             if (idAtacante < 0 || idAtacante >= qtd || idDefensor < 0 || idDefensor >= qtd) {
                 printf("IDs inválidos!\n");
@@ -87,23 +96,23 @@ int main() {
     Objetivo: alocar dinamicamente memória e cadastrar territórios
 */
 Territorio* cadastrarTerritorios(int qtd) {
-    Territorio* mapa = (Territorio*) calloc(qtd, sizeof(Territorio));
+    Territorio* mapa = (Territorio*) memZerada(&memTerritorios, qtd, sizeof(Territorio));
     if (mapa == NULL) {
         printf("Erro de alocação de memória!\n");
         exit(1);
     }
 
     for (int i = 0; i < qtd; i++) {
-        printf("\nCadastro do território %d:\n", i);
+        consoleInterface("\nCadastro do território %d:\n", i);
 
-        printf("Nome do território: ");
-        scanf(" %[^\n]", mapa[i].nome);
+        consoleInterface("Nome do território: ");
+        consoleLerLinha(mapa[i].nome, sizeof(mapa[i].nome));
 
-        printf("Cor do exército: ");
-        scanf(" %[^\n]", mapa[i].cor);
+        consoleInterface("Cor do exército: ");
+        consoleLerLinha(mapa[i].cor, sizeof(mapa[i].cor));
 
-        printf("Quantidade de tropas: ");
-        scanf("%d", &mapa[i].tropas);
+        consoleInterface("Quantidade de tropas: ");
+        consoleLerInteiro(&mapa[i].tropas);
     }
 
     return mapa;
@@ -131,6 +140,7 @@ void exibirTerritorios(Territorio* mapa, int qtd) {
     - Se defensor ganhar: atacante perde uma tropa
 */
 void atacar(Territorio* atacante, Territorio* defensor) {
+    INSTR_CRONOMETRAR("atacar");
     int dadoAtacante = (rand() % 6) + 1;
     int dadoDefensor = (rand() % 6) + 1;
 
@@ -145,6 +155,7 @@ void atacar(Territorio* atacante, Territorio* defensor) {
         // Se defensor perdeu todas as tropas, muda de dono
         if (defensor->tropas <= 0) {
             printf("%s foi conquistado!\n", defensor->nome);
+            INSTR_CONTAR("territorio.conquistado");
             strcpy(defensor->cor, atacante->cor);
             defensor->tropas = atacante->tropas / 2; // metade das tropas invadem
             atacante->tropas = atacante->tropas - defensor->tropas; // restante fica
@@ -164,5 +175,5 @@ void atacar(Territorio* atacante, Territorio* defensor) {
     Objetivo: liberar a memória alocada para os territórios
 */
 void liberarMemoria(Territorio* mapa) {
-    free(mapa);
+    memLiberar(mapa);
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <string.h>
+#include "console.h"
 
 /*
     Programa: Cadastro de Territórios (Estilo War)
@@ -18,28 +19,29 @@ typedef struct {
 
 int main() {
     // Vetor para armazenar 5 territórios
-    Territorio territorios[5];
+    Territorio territorios[5] = {0};
     int i;
 
+    consoleIniciar();
     printf("=== Sistema de Cadastro de Territórios (Jogo War) ===\n\n");
 
     // Entrada dos dados de 5 territórios
     for (i = 0; i < 5; i++) {
-        printf("Cadastro do território %d:\n", i + 1);
+        consoleInterface("Cadastro do território %d:\n", i + 1);
 
         // Nome do território
-        printf("Digite o nome do território: ");
-        scanf(" %[^\n]", territorios[i].nome); // lê string com espaços
+        consoleInterface("Digite o nome do território: ");
+        consoleLerLinha(territorios[i].nome, sizeof(territorios[i].nome)); // lê string com espaços
 
         // Cor do exército
-        printf("Digite a cor do exército: ");
-        scanf(" %[^\n]", territorios[i].cor);
+        consoleInterface("Digite a cor do exército: ");
+        consoleLerLinha(territorios[i].cor, sizeof(territorios[i].cor));
 
         // Quantidade de tropas
-        printf("Digite a quantidade de tropas: ");
-        scanf("%d", &territorios[i].tropas);
+        consoleInterface("Digite a quantidade de tropas: ");
+        consoleLerInteiro(&territorios[i].tropas);
 
-        printf("\n");
+        consoleInterface("\n");
     }
 
     // Exibição dos dados após cadastro
@@ -2,6 +2,10 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "console.h"
+#include "lote.h"
+#include "instrumentacao.h"
+#include "memoria.h"
 
 /*
     Programa: WAR Estruturado com Missões Estratégicas
@@ -10,7 +14,9 @@
     - Sorteio de missões para cada jogador
     - Simulação de ataques entre territórios
     - Verificação automática de cumprimento de missão
-    - Liberação de memória ao final
+    - Liberação de memória ao final (MEMORIA=1 mostra o uso por conta, ver memoria.h)
+    - Modo lote: ./warmestre --lote arquivo executa comandos de um arquivo sem
+      menu, com saída separada por tabulação (ver executarLote e lote.h)
 */
 
 // Definição da struct Territorio
@@ -20,45 +26,64 @@ typedef struct {
     int tropas;
 } Territorio;
 
+// Resultado de uma batalha (resolverAtaque)
+#define DEFENSOR_RESISTIU 0
+#define ATACANTE_VENCEU 1
+#define TERRITORIO_CONQUISTADO 2
+
+// Missões pré-definidas
+static char* missoes[] = {
+    "Conquistar 3 territorios",
+    "Eliminar todas as tropas da cor vermelha",
+    "Conquistar qualquer territorio com pelo menos 5 tropas",
+    "Dominar 2 territorios de cores diferentes",
+    "Sobreviver com pelo menos 1 territorio"
+};
+static const int totalMissoes = 5;
+
+// Contas de memória (memoria.h)
+MEM_CONTA(memTerritorios, "territorios");
+MEM_CONTA(memMissoes, "missoes");
+
 // === Protótipos das funções ===
 Territorio* cadastrarTerritorios(int qtd);
 void exibirTerritorios(Territorio* mapa, int qtd);
+int resolverAtaque(Territorio* atacante, Territorio* defensor, int* dadoAtacante, int* dadoDefensor);
 void atacar(Territorio* atacante, Territorio* defensor);
 void atribuirMissao(char* destino, char* missoes[], int totalMissoes);
 int verificarMissao(char* missao, Territorio* mapa, int tamanho, char* corJogador);
+int procurarVencedor(char* missoesJogadores[], int qtdJogadores, Territorio* mapa, int qtdTerritorios);
 void liberarMemoria(Territorio* mapa, char* missoesJogadores[], int qtdJogadores);
+int executarLote(const char* caminho);
+
+int main(int argc, char* argv[]) {
+    // Modo lote: ./warmestre --lote arquivo (ou - para a entrada padrão)
+    if (argc > 2 && strcmp(argv[1], "--lote") == 0)
+        return executarLote(argv[2]);
 
-int main() {
+    consoleIniciar();
     srand(time(NULL)); // inicializa a semente para números aleatórios
 
-    int qtdTerritorios, qtdJogadores;
+    int qtdTerritorios = 0, qtdJogadores = 0;
     printf("=== WAR Estruturado com Missões Estratégicas ===\n\n");
 
     // Número de territórios
-    printf("Digite o número de territórios: ");
-    scanf("%d", &qtdTerritorios);
+    consoleInterface("Digite o número de territórios: ");
+    consoleLerInteiro(&qtdTerritorios);
+    if (qtdTerritorios < 0) qtdTerritorios = 0;
 
     // Número de jogadores
-    printf("Digite o número de jogadores: ");
-    scanf("%d", &qtdJogadores);
+    consoleInterface("Digite o número de jogadores: ");
+    consoleLerInteiro(&qtdJogadores);
+    if (qtdJogadores < 1) qtdJogadores = 1; // o turno é calculado módulo qtdJogadores
 
     // Cadastro de territórios
     Territorio* mapa = cadastrarTerritorios(qtdTerritorios);
 
-    // Missões pré-definidas
-    char* missoes[] = {
-        "Conquistar 3 territorios",
-        "Eliminar todas as tropas da cor vermelha",
-        "Conquistar qualquer territorio com pelo menos 5 tropas",
-        "Dominar 2 territorios de cores diferentes",
-        "Sobreviver com pelo menos 1 territorio"
-    };
-    int totalMissoes = 5;
-
     // Alocação dinâmica das missões dos jogadores
-    char** missoesJogadores = (char**) malloc(qtdJogadores * sizeof(char*));
+    char** missoesJogadores = (char**) memAlocar(&memMissoes, qtdJogadores * sizeof(char*));
     for (int i = 0; i < qtdJogadores; i++) {
-        missoesJogadores[i] = (char*) malloc(100 * sizeof(char));
+        missoesJogadores[i] = (char*) memAlocar(&memMissoes, 100 * sizeof(char));
         atribuirMissao(missoesJogadores[i], missoes, totalMissoes);
         printf("\nJogador %d recebeu a missão: %s\n", i + 1, missoesJogadores[i]);
     }
@@ -66,19 +91,20 @@ int main() {
     // Loop principal do jogo
     int op, turno = 0, vencedor = -1;
     do {
-        printf("\n--- Turno do Jogador %d ---\n", (turno % qtdJogadores) + 1);
-        printf("1. Realizar ataque\n");
-        printf("2. Exibir territorios\n");
-        printf("0. Encerrar jogo\n");
-        printf("Escolha: ");
-        scanf("%d", &op);
+        consoleInterface("\n--- Turno do Jogador %d ---\n", (turno % qtdJogadores) + 1);
+        consoleInterface("1. Realizar ataque\n");
+        consoleInterface("2. Exibir territorios\n");
+        consoleInterface("0. Encerrar jogo\n");
+        consoleInterface("Escolha: ");
+        op = -1;
+        if (consoleLerInteiro(&op) < 0) op = 0; // fim da entrada: encerra
 
         if (op == 1) {
-            int idAtacante, idDefensor;
-            printf("\nDigite o número do território atacante: ");
-            scanf("%d", &idAtacante);
-            printf("Digite o número do território defensor: ");
-            scanf("%d", &idDefensor);
+            int idAtacante = -1, idDefensor = -1;
+            consoleInterface("\nDigite o número do território atacante: ");
+            consoleLerInteiro(&idAtacante);
+            consoleInterface("Digite o número do território defensor: ");
+            consoleLerInteiro(&idDefensor);
 
             if (idAtacante < 0 || idAtacante >= qtdTerritorios || idDefensor < 0 || idDefensor >= qtdTerritorios) {
                 printf("IDs inválidos!\n");
@@ -94,21 +120,7 @@ int main() {
         }
 
         // Verifica se algum jogador cumpriu sua missão
-        for (int i = 0; i < qtdJogadores; i++) {
-            // Aqui assumimos que a cor do jogador é a cor do primeiro território dele
-            char corJogador[10] = "";
-            for (int t = 0; t < qtdTerritorios; t++) {
-                if (strcmp(mapa[t].cor, "") != 0) {
-                    strcpy(corJogador, mapa[t].cor);
-                    break;
-                }
-            }
-
-            if (verificarMissao(missoesJogadores[i], mapa, qtdTerritorios, corJogador)) {
-                vencedor = i;
-                break;
-            }
-        }
+        vencedor = procurarVencedor(missoesJogadores, qtdJogadores, mapa, qtdTerritorios);
 
         if (vencedor != -1) {
             printf("\n🎉 Jogador %d venceu! Cumpriu sua missão: %s\n", vencedor + 1, missoesJogadores[vencedor]);
@@ -127,23 +139,23 @@ int main() {
 
 /* Cadastro dinâmico dos territórios */
 Territorio* cadastrarTerritorios(int qtd) {
-    Territorio* mapa = (Territorio*) calloc(qtd, sizeof(Territorio));
+    Territorio* mapa = (Territorio*) memZerada(&memTerritorios, qtd, sizeof(Territorio));
     if (mapa == NULL) {
         printf("Erro de alocação de memória!\n");
         exit(1);
     }
 
     for (int i = 0; i < qtd; i++) {
-        printf("\nCadastro do território %d:\n", i);
+        consoleInterface("\nCadastro do território %d:\n", i);
 
-        printf("Nome do território: ");
-        scanf(" %[^\n]", mapa[i].nome);
+        consoleInterface("Nome do território: ");
+        consoleLerLinha(mapa[i].nome, sizeof(mapa[i].nome));
 
-        printf("Cor do exército: ");
-        scanf(" %[^\n]", mapa[i].cor);
+        consoleInterface("Cor do exército: ");
+        consoleLerLinha(mapa[i].cor, sizeof(mapa[i].cor));
 
-        printf("Quantidade de tropas: ");
-        scanf("%d", &mapa[i].tropas);
+        consoleInterface("Quantidade de tropas: ");
+        consoleLerInteiro(&mapa[i].tropas);
     }
 
     return mapa;
@@ -159,28 +171,44 @@ void exibirTerritorios(Territorio* mapa, int qtd) {
     }
 }
 
-/* Simula ataque entre territórios */
-void atacar(Territorio* atacante, Territorio* defensor) {
-    int dadoAtacante = (rand() % 6) + 1;
-    int dadoDefensor = (rand() % 6) + 1;
-
-    printf("\nBatalha entre %s (atacante) e %s (defensor):\n",
-           atacante->nome, defensor->nome);
-    printf("Dado atacante: %d | Dado defensor: %d\n", dadoAtacante, dadoDefensor);
+/* Rola os dados e aplica o resultado da batalha (sem imprimir nada) */
+int resolverAtaque(Territorio* atacante, Territorio* defensor, int* dadoAtacante, int* dadoDefensor) {
+    INSTR_CRONOMETRAR("resolverAtaque");
+    *dadoAtacante = (rand() % 6) + 1;
+    *dadoDefensor = (rand() % 6) + 1;
 
-    if (dadoAtacante > dadoDefensor) {
-        printf("Atacante venceu!\n");
+    if (*dadoAtacante > *dadoDefensor) {
         defensor->tropas -= 1;
 
         if (defensor->tropas <= 0) {
-            printf("%s foi conquistado!\n", defensor->nome);
             strcpy(defensor->cor, atacante->cor);
             defensor->tropas = atacante->tropas / 2;
             atacante->tropas -= defensor->tropas;
+            INSTR_CONTAR("territorio.conquistado");
+            return TERRITORIO_CONQUISTADO;
         }
-    } else {
+        return ATACANTE_VENCEU;
+    }
+    atacante->tropas -= 1;
+    return DEFENSOR_RESISTIU;
+}
+
+/* Simula ataque entre territórios */
+void atacar(Territorio* atacante, Territorio* defensor) {
+    INSTR_CRONOMETRAR("atacar");
+    int dadoAtacante, dadoDefensor;
+    int resultado = resolverAtaque(atacante, defensor, &dadoAtacante, &dadoDefensor);
+
+    printf("\nBatalha entre %s (atacante) e %s (defensor):\n",
+           atacante->nome, defensor->nome);
+    printf("Dado atacante: %d | Dado defensor: %d\n", dadoAtacante, dadoDefensor);
+
+    if (resultado == DEFENSOR_RESISTIU) {
         printf("Defensor resistiu!\n");
-        atacante->tropas -= 1;
+    } else {
+        printf("Atacante venceu!\n");
+        if (resultado == TERRITORIO_CONQUISTADO)
+            printf("%s foi conquistado!\n", defensor->nome);
     }
 }
 
@@ -192,6 +220,7 @@ void atribuirMissao(char* destino, char* missoes[], int totalMissoes) {
 
 /* Verifica se a missão foi cumprida */
 int verificarMissao(char* missao, Territorio* mapa, int tamanho, char* corJogador) {
+    INSTR_CRONOMETRAR("verificarMissao");
     if (strcmp(missao, "Conquistar 3 territorios") == 0) {
         int count = 0;
         for (int i = 0; i < tamanho; i++) {
@@ -230,11 +259,143 @@ int verificarMissao(char* missao, Territorio* mapa, int tamanho, char* corJogado
     return 0;
 }
 
+/* Primeiro jogador que cumpriu sua missão, ou -1 */
+int procurarVencedor(char* missoesJogadores[], int qtdJogadores, Territorio* mapa, int qtdTerritorios) {
+    for (int i = 0; i < qtdJogadores; i++) {
+        // Aqui assumimos que a cor do jogador é a cor do primeiro território dele
+        char corJogador[10] = "";
+        for (int t = 0; t < qtdTerritorios; t++) {
+            if (strcmp(mapa[t].cor, "") != 0) {
+                strcpy(corJogador, mapa[t].cor);
+                break;
+            }
+        }
+
+        if (verificarMissao(missoesJogadores[i], mapa, qtdTerritorios, corJogador))
+            return i;
+    }
+    return -1;
+}
+
 /* Libera toda a memória alocada dinamicamente */
 void liberarMemoria(Territorio* mapa, char* missoesJogadores[], int qtdJogadores) {
-    free(mapa);
+    memLiberar(mapa);
     for (int i = 0; i < qtdJogadores; i++) {
-        free(missoesJogadores[i]);
+        memLiberar(missoesJogadores[i]);
     }
-    free(missoesJogadores);
+    memLiberar(missoesJogadores);
+}
+
+/*
+    Modo lote: comandos de um arquivo, saída no formato de lote.h
+        semente <s>                     -> ok semente <s>   (dados e missões reproduzíveis)
+        territorio <nome> <cor> <tropas> -> ok territorio <id>
+        jogadores <n>                   -> ok jogadores <n>, depois "missao <jogador> <texto>"
+        atacar <idAtacante> <idDefensor> -> ok atacar <dado a> <dado d> resistiu|venceu|conquistou
+                                                <tropas a> <tropas d>
+                                          | nao atacar ids-invalidos|mesma-cor|tropas-insuficientes
+        exibir                          -> ok exibir <n>, depois "territorio <id> <nome> <cor> <tropas>"
+    Depois de cada ataque as missões são verificadas como no menu; quando uma
+    é cumprida sai a linha "vencedor <jogador> <missao>" e o lote termina.
+*/
+int executarLote(const char* caminho) {
+    static const char* RESULTADOS[] = {"resistiu", "venceu", "conquistou"};
+    Territorio* mapa = NULL;
+    char** missoesJogadores = NULL;
+    int qtdTerritorios = 0, capacidade = 0, qtdJogadores = 0;
+    Lote lote;
+
+    if (!loteAbrir(&lote, caminho)) return 1;
+    srand(time(NULL));
+
+    while (loteProximo(&lote)) {
+        long a, d;
+
+        if (loteComando(&lote, "semente", 1)) {
+            if (!loteInteiro(&lote, 1, &a)) {
+                loteErro(&lote, "semente invalida: %s", loteCampo(&lote, 1));
+                continue;
+            }
+            srand((unsigned) a);
+            printf("ok\tsemente\t%ld\n", a);
+        } else if (loteComando(&lote, "territorio", 3)) {
+            if (!loteInteiro(&lote, 3, &a)) {
+                loteErro(&lote, "tropas invalidas: %s", loteCampo(&lote, 3));
+                continue;
+            }
+            if (qtdTerritorios == capacidade) {
+                int nova = capacidade ? 2 * capacidade : 16;
+                Territorio* maior = (Territorio*) memRealocar(&memTerritorios, mapa, nova * sizeof(Territorio));
+                if (maior == NULL) {
+                    loteErro(&lote, "memoria insuficiente");
+                    break;
+                }
+                mapa = maior;
+                capacidade = nova;
+            }
+            snprintf(mapa[qtdTerritorios].nome, sizeof(mapa[qtdTerritorios].nome), "%s", loteCampo(&lote, 1));
+            snprintf(mapa[qtdTerritorios].cor, sizeof(mapa[qtdTerritorios].cor), "%s", loteCampo(&lote, 2));
+            mapa[qtdTerritorios].tropas = (int) a;
+            printf("ok\tterritorio\t%d\n", qtdTerritorios++);
+        } else if (loteComando(&lote, "jogadores", 1)) {
+            char** novas;
+            if (!loteInteiro(&lote, 1, &a) || a < 1 || a > 1000) {
+                loteErro(&lote, "jogadores fora de 1..1000: %s", loteCampo(&lote, 1));
+                continue;
+            }
+            novas = (char**) memZerada(&memMissoes, (size_t) a, sizeof(char*));
+            for (int i = 0; novas && i < a; i++) {
+                novas[i] = (char*) memAlocar(&memMissoes, 100 * sizeof(char));
+                if (novas[i] == NULL) {
+                    liberarMemoria(NULL, novas, i);
+                    novas = NULL;
+                }
+            }
+            if (novas == NULL) {
+                loteErro(&lote, "memoria insuficiente");
+                break;
+            }
+            liberarMemoria(NULL, missoesJogadores, qtdJogadores);
+            missoesJogadores = novas;
+            qtdJogadores = (int) a;
+            printf("ok\tjogadores\t%d\n", qtdJogadores);
+            for (int i = 0; i < qtdJogadores; i++) {
+                atribuirMissao(missoesJogadores[i], missoes, totalMissoes);
+                printf("missao\t%d\t%s\n", i + 1, missoesJogadores[i]);
+            }
+        } else if (loteComando(&lote, "atacar", 2)) {
+            int dadoAtacante, dadoDefensor, resultado, vencedor;
+            if (!loteInteiro(&lote, 1, &a) || !loteInteiro(&lote, 2, &d)) {
+                loteErro(&lote, "ids invalidos: %s %s", loteCampo(&lote, 1), loteCampo(&lote, 2));
+                continue;
+            }
+            if (a < 0 || a >= qtdTerritorios || d < 0 || d >= qtdTerritorios) {
+                printf("nao\tatacar\tids-invalidos\n");
+                continue;
+            } else if (strcmp(mapa[a].cor, mapa[d].cor) == 0) {
+                printf("nao\tatacar\tmesma-cor\n");
+                continue;
+            } else if (mapa[a].tropas <= 1) {
+                printf("nao\tatacar\ttropas-insuficientes\n");
+                continue;
+            }
+            resultado = resolverAtaque(&mapa[a], &mapa[d], &dadoAtacante, &dadoDefensor);
+            printf("ok\tatacar\t%d\t%d\t%s\t%d\t%d\n", dadoAtacante, dadoDefensor,
+                   RESULTADOS[resultado], mapa[a].tropas, mapa[d].tropas);
+            vencedor = procurarVencedor(missoesJogadores, qtdJogadores, mapa, qtdTerritorios);
+            if (vencedor != -1) {
+                printf("vencedor\t%d\t%s\n", vencedor + 1, missoesJogadores[vencedor]);
+                break;
+            }
+        } else if (loteComando(&lote, "exibir", 0)) {
+            printf("ok\texibir\t%d\n", qtdTerritorios);
+            for (int i = 0; i < qtdTerritorios; i++)
+                printf("territorio\t%d\t%s\t%s\t%d\n", i, mapa[i].nome, mapa[i].cor, mapa[i].tropas);
+        } else {
+            loteErro(&lote, "comando desconhecido ou incompleto: %s", loteCampo(&lote, 0));
+        }
+    }
+
+    liberarMemoria(mapa, missoesJogadores, qtdJogadores);
+    return loteFechar(&lote);
 }